@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2005 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef TNTDB_BINDING_H
+#define TNTDB_BINDING_H
+
+namespace tntdb
+{
+/** Mapping of the members of a class to host variables and columns
+
+    When the binding of a class is defined, objects of the class are set
+    into statements and read from rows member by member without going
+    through cxxtools::SerializationInfo. Otherwise the serialization
+    operators of the class are used.
+
+    The binding is normally defined using the macros below at global scope:
+
+    @code
+      struct Person
+      {
+          int64_t id;
+          std::string name;
+          tntdb::Date birthday;
+      };
+
+      TNTDB_BINDING_BEGIN(Person)
+          TNTDB_BINDING_MEMBER(id)
+          TNTDB_BINDING_MEMBER(name)
+          TNTDB_BINDING_COLUMN("birth_date", birthday)
+      TNTDB_BINDING_END
+
+      stmt.execute(person);   // sets :id, :name and :birth_date
+      row >>= person;         // reads the columns id, name and birth_date
+    @endcode
+
+    A binding may also be written by hand. A specialization must set
+    `defined` to true and implement `visit`, which calls the visitor with
+    the name and a reference to each member. `Object` is either `T` or
+    `const T`.
+ */
+template <typename T>
+struct Binding
+{
+    static const bool defined = false;
+
+    // template <typename Visitor, typename Object>
+    // static void visit(Visitor& visitor, Object& obj);
+};
+
+}
+
+#define TNTDB_BINDING_BEGIN(Type) \
+    namespace tntdb { \
+    template <> struct Binding<Type> \
+    { \
+        static const bool defined = true; \
+        template <typename Visitor, typename Object> \
+        static void visit(Visitor& tntdbVisitor, Object& tntdbObject) \
+        {
+
+/// Binds the member to the host variable or column with the same name.
+#define TNTDB_BINDING_MEMBER(member) \
+            tntdbVisitor(#member, tntdbObject.member);
+
+/// Binds the member to the host variable or column with the passed name.
+#define TNTDB_BINDING_COLUMN(name, member) \
+            tntdbVisitor(name, tntdbObject.member);
+
+#define TNTDB_BINDING_END \
+        } \
+    }; \
+    }
+
+#endif // TNTDB_BINDING_H
@@ -31,6 +31,7 @@
 
 #include <tntdb/iface/iconnection.h>
 #include <tntdb/bits/statement.h>
+#include <tntdb/metrics.h>
 #include <string>
 #include <memory>
 
@@ -138,6 +139,23 @@ public:
     /// Check whether the connection is alive
     bool ping()                        { return _conn->ping(); }
 
+    /** Check cheaply whether the connection is alive
+
+        In contrast to ping no query is sent to the server. Only the state
+        of the connection is checked. So a returned true does not guarantee
+        that the next query succeeds.
+     */
+    bool isAlive()                     { return _conn->isAlive(); }
+
+    /** Get the counters of the connection
+
+        The counters of the driver, like round trips and rows fetched, are
+        added to the passed metrics. The postgresql and mysql drivers count;
+        the others return false.
+     */
+    bool getMetrics(ConnectionMetrics& metrics)
+      { return _conn->getMetrics(metrics); }
+
     /// Get the last inserted insert id
     long lastInsertId(const std::string& name = std::string())
       { return _conn->lastInsertId(name); }
@@ -32,7 +32,11 @@
 #include <tntdb/iface/irow.h>
 #include <tntdb/bits/value.h>
 #include <tntdb/blob.h>
+#include <tntdb/binding.h>
 #include <memory>
+#include <tuple>
+#include <stdexcept>
+#include <type_traits>
 
 namespace tntdb
 {
@@ -78,13 +82,18 @@ public:
     /// Returns the name of the field_num's column
     std::string getName(size_type field_num) const
       { return _row->getColumnName(field_num); }
+    /// Returns the number of the column with the passed name.
+    /// The number can be used to read the column from the following rows
+    /// of the same result or cursor without looking up the name again.
+    size_type getColumnIndex(const std::string& field_name) const
+      { return _row->getColumnIndex(field_name); }
 
     /// Return true, if the specified value is null.
     bool isNull(size_type field_num) const
-      { return getValue(field_num).isNull(); }
+      { return _row->isNull(field_num); }
     /// Return true, if the specified value is null.
     bool isNull(const std::string& field_name) const
-      { return getValue(field_name).isNull(); }
+      { return isNull(getColumnIndex(field_name)); }
 
     //@{
     /**
@@ -93,98 +102,143 @@ public:
      */
 
     bool getBool(size_type field_num) const
-      { return getValue(field_num).getBool(); }
+      { return _row->getBool(field_num); }
     short getShort(size_type field_num) const
-      { return getValue(field_num).getShort(); }
+      { return _row->getShort(field_num); }
     int getInt(size_type field_num) const
-      { return getValue(field_num).getInt(); }
+      { return _row->getInt(field_num); }
     long getLong(size_type field_num) const
-      { return getValue(field_num).getLong(); }
+      { return _row->getLong(field_num); }
     unsigned short getUnsignedShort(size_type field_num) const
-      { return getValue(field_num).getUnsignedShort(); }
+      { return _row->getUnsignedShort(field_num); }
     unsigned getUnsigned(size_type field_num) const
-      { return getValue(field_num).getUnsigned(); }
+      { return _row->getUnsigned(field_num); }
     unsigned long getUnsignedLong(size_type field_num) const
-      { return getValue(field_num).getUnsignedLong(); }
+      { return _row->getUnsignedLong(field_num); }
     int32_t getInt32(size_type field_num) const
-      { return getValue(field_num).getInt32(); }
+      { return _row->getInt32(field_num); }
     uint32_t getUnsigned32(size_type field_num) const
-      { return getValue(field_num).getUnsigned32(); }
+      { return _row->getUnsigned32(field_num); }
     int64_t getInt64(size_type field_num) const
-      { return getValue(field_num).getInt64(); }
+      { return _row->getInt64(field_num); }
     uint64_t getUnsigned64(size_type field_num) const
-      { return getValue(field_num).getUnsigned64(); }
+      { return _row->getUnsigned64(field_num); }
     Decimal getDecimal(size_type field_num) const
-      { return getValue(field_num).getDecimal(); }
+      { return _row->getDecimal(field_num); }
     float getFloat(size_type field_num) const
-      { return getValue(field_num).getFloat(); }
+      { return _row->getFloat(field_num); }
     double getDouble(size_type field_num) const
-      { return getValue(field_num).getDouble(); }
+      { return _row->getDouble(field_num); }
     char getChar(size_type field_num) const
-      { return getValue(field_num).getChar(); }
+      { return _row->getChar(field_num); }
     std::string getString(size_type field_num) const
-      { return getValue(field_num).getString(); }
+      { std::string ret; _row->getString(field_num, ret); return ret; }
     void getString(size_type field_num, std::string& ret) const
-      { return getValue(field_num).getString(ret); }
+      { _row->getString(field_num, ret); }
     Blob getBlob(size_type field_num) const
-      { return getValue(field_num).getBlob(); }
+      { Blob ret; _row->getBlob(field_num, ret); return ret; }
     void getBlob(size_type field_num, Blob& ret) const
-      { return getValue(field_num).getBlob(ret); }
+      { _row->getBlob(field_num, ret); }
     Date getDate(size_type field_num) const
-      { return getValue(field_num).getDate(); }
+      { return _row->getDate(field_num); }
     Time getTime(size_type field_num) const
-      { return getValue(field_num).getTime(); }
+      { return _row->getTime(field_num); }
     Datetime getDatetime(size_type field_num) const
-      { return getValue(field_num).getDatetime(); }
+      { return _row->getDatetime(field_num); }
 
     bool getBool(const std::string& field_name) const
-      { return getValue(field_name).getBool(); }
+      { return getBool(getColumnIndex(field_name)); }
     short getShort(const std::string& field_name) const
-      { return getValue(field_name).getShort(); }
+      { return getShort(getColumnIndex(field_name)); }
     int getInt(const std::string& field_name) const
-      { return getValue(field_name).getInt(); }
+      { return getInt(getColumnIndex(field_name)); }
     long getLong(const std::string& field_name) const
-      { return getValue(field_name).getLong(); }
+      { return getLong(getColumnIndex(field_name)); }
     unsigned getUnsigned(const std::string& field_name) const
-      { return getValue(field_name).getUnsigned(); }
+      { return getUnsigned(getColumnIndex(field_name)); }
     unsigned long getUnsignedLong(const std::string& field_name) const
-      { return getValue(field_name).getUnsignedLong(); }
+      { return getUnsignedLong(getColumnIndex(field_name)); }
     int32_t getInt32(const std::string& field_name) const
-      { return getValue(field_name).getInt32(); }
+      { return getInt32(getColumnIndex(field_name)); }
     uint32_t getUnsigned32(const std::string& field_name) const
-      { return getValue(field_name).getUnsigned32(); }
+      { return getUnsigned32(getColumnIndex(field_name)); }
     int64_t getInt64(const std::string& field_name) const
-      { return getValue(field_name).getInt64(); }
+      { return getInt64(getColumnIndex(field_name)); }
     uint64_t getUnsigned64(const std::string& field_name) const
-      { return getValue(field_name).getUnsigned64(); }
+      { return getUnsigned64(getColumnIndex(field_name)); }
     Decimal getDecimal(const std::string& field_name) const
-      { return getValue(field_name).getDecimal(); }
+      { return getDecimal(getColumnIndex(field_name)); }
     float getFloat(const std::string& field_name) const
-      { return getValue(field_name).getFloat(); }
+      { return getFloat(getColumnIndex(field_name)); }
     double getDouble(const std::string& field_name) const
-      { return getValue(field_name).getDouble(); }
+      { return getDouble(getColumnIndex(field_name)); }
     char getChar(const std::string& field_name) const
-      { return getValue(field_name).getChar(); }
+      { return getChar(getColumnIndex(field_name)); }
     std::string getString(const std::string& field_name) const
-      { return getValue(field_name).getString(); }
+      { return getString(getColumnIndex(field_name)); }
     void getString(const std::string& field_name, std::string& ret) const
-      { return getValue(field_name).getString(ret); }
+      { return getString(getColumnIndex(field_name), ret); }
     Blob getBlob(const std::string& field_name) const
-      { return getValue(field_name).getBlob(); }
+      { return getBlob(getColumnIndex(field_name)); }
     void getBlob(const std::string& field_name, Blob& ret) const
-      { return getValue(field_name).getBlob(ret); }
+      { return getBlob(getColumnIndex(field_name), ret); }
     Date getDate(const std::string& field_name) const
-      { return getValue(field_name).getDate(); }
+      { return getDate(getColumnIndex(field_name)); }
     Time getTime(const std::string& field_name) const
-      { return getValue(field_name).getTime(); }
+      { return getTime(getColumnIndex(field_name)); }
     Datetime getDatetime(const std::string& field_name) const
-      { return getValue(field_name).getDatetime(); }
+      { return getDatetime(getColumnIndex(field_name)); }
     //@}
 
+    //@{
+    /**
+     * Fetches the value of the specified column into the passed variable.
+     * Returns false and leaves the variable untouched, if the value is null.
+     *
+     * Standard types are read directly from the row. Other types are
+     * extracted from the tntdb::Value using the operator>>.
+     */
     template <typename T>
     bool getValue(size_type field_num, T& ret) const
       { return getValue(field_num).getValue(ret); }
 
+    bool getValue(size_type field_num, bool& ret) const;
+    bool getValue(size_type field_num, short& ret) const;
+    bool getValue(size_type field_num, int& ret) const;
+    bool getValue(size_type field_num, long& ret) const;
+    bool getValue(size_type field_num, unsigned short& ret) const;
+    bool getValue(size_type field_num, unsigned& ret) const;
+    bool getValue(size_type field_num, unsigned long& ret) const;
+    bool getValue(size_type field_num, Decimal& ret) const;
+    bool getValue(size_type field_num, float& ret) const;
+    bool getValue(size_type field_num, double& ret) const;
+    bool getValue(size_type field_num, char& ret) const;
+    bool getValue(size_type field_num, std::string& ret) const;
+    bool getValue(size_type field_num, Blob& ret) const;
+    bool getValue(size_type field_num, Date& ret) const;
+    bool getValue(size_type field_num, Time& ret) const;
+    bool getValue(size_type field_num, Datetime& ret) const;
+#if __cplusplus >= 201703L
+    template <typename T>
+    bool getValue(size_type field_num, std::optional<T>& ret) const;
+#endif
+    //@}
+
+    /**
+     * Returns the first columns of the row as a tuple of the requested
+     * types. Null values are returned as default constructed values
+     * unless the type is a std::optional.
+     *
+     * Example:
+     * \code
+     *   int64_t id;
+     *   std::string name;
+     *   std::tie(id, name) = row.getTuple<int64_t, std::string>();
+     * \endcode
+     */
+    template <typename... T>
+    std::tuple<T...> getTuple() const;
+
     /// Returns a iterator to the first column
     const_iterator begin() const;
     /// Returns a iterator past the last column
@@ -207,6 +261,226 @@ public:
     RowReader get(T& ret, bool& nullInd) const;
 
 };
+
+//@{
+/**
+  Extraction of standard types without creating a tntdb::Value.
+ */
+inline bool Row::getValue(size_type field_num, bool& ret) const
+{
+    if (_row->isNull(field_num))
+        return false;
+
+    ret = _row->getBool(field_num);
+    return true;
+}
+
+inline bool Row::getValue(size_type field_num, short& ret) const
+{
+    if (_row->isNull(field_num))
+        return false;
+
+    ret = _row->getShort(field_num);
+    return true;
+}
+
+inline bool Row::getValue(size_type field_num, int& ret) const
+{
+    if (_row->isNull(field_num))
+        return false;
+
+    ret = _row->getInt(field_num);
+    return true;
+}
+
+inline bool Row::getValue(size_type field_num, long& ret) const
+{
+    if (_row->isNull(field_num))
+        return false;
+
+    ret = _row->getLong(field_num);
+    return true;
+}
+
+inline bool Row::getValue(size_type field_num, unsigned short& ret) const
+{
+    if (_row->isNull(field_num))
+        return false;
+
+    ret = _row->getUnsignedShort(field_num);
+    return true;
+}
+
+inline bool Row::getValue(size_type field_num, unsigned& ret) const
+{
+    if (_row->isNull(field_num))
+        return false;
+
+    ret = _row->getUnsigned(field_num);
+    return true;
+}
+
+inline bool Row::getValue(size_type field_num, unsigned long& ret) const
+{
+    if (_row->isNull(field_num))
+        return false;
+
+    ret = _row->getUnsignedLong(field_num);
+    return true;
+}
+
+inline bool Row::getValue(size_type field_num, Decimal& ret) const
+{
+    if (_row->isNull(field_num))
+        return false;
+
+    ret = _row->getDecimal(field_num);
+    return true;
+}
+
+inline bool Row::getValue(size_type field_num, float& ret) const
+{
+    if (_row->isNull(field_num))
+        return false;
+
+    ret = _row->getFloat(field_num);
+    return true;
+}
+
+inline bool Row::getValue(size_type field_num, double& ret) const
+{
+    if (_row->isNull(field_num))
+        return false;
+
+    ret = _row->getDouble(field_num);
+    return true;
+}
+
+inline bool Row::getValue(size_type field_num, char& ret) const
+{
+    if (_row->isNull(field_num))
+        return false;
+
+    ret = _row->getChar(field_num);
+    return true;
+}
+
+inline bool Row::getValue(size_type field_num, std::string& ret) const
+{
+    if (_row->isNull(field_num))
+        return false;
+
+    _row->getString(field_num, ret);
+    return true;
+}
+
+inline bool Row::getValue(size_type field_num, Blob& ret) const
+{
+    if (_row->isNull(field_num))
+        return false;
+
+    _row->getBlob(field_num, ret);
+    return true;
+}
+
+inline bool Row::getValue(size_type field_num, Date& ret) const
+{
+    if (_row->isNull(field_num))
+        return false;
+
+    ret = _row->getDate(field_num);
+    return true;
+}
+
+inline bool Row::getValue(size_type field_num, Time& ret) const
+{
+    if (_row->isNull(field_num))
+        return false;
+
+    ret = _row->getTime(field_num);
+    return true;
+}
+
+inline bool Row::getValue(size_type field_num, Datetime& ret) const
+{
+    if (_row->isNull(field_num))
+        return false;
+
+    ret = _row->getDatetime(field_num);
+    return true;
+}
+
+#if __cplusplus >= 201703L
+template <typename T>
+bool Row::getValue(size_type field_num, std::optional<T>& ret) const
+{
+    if (_row->isNull(field_num))
+    {
+        ret.reset();
+        return false;
+    }
+
+    ret.emplace();
+    getValue(field_num, *ret);
+    return true;
+}
+#endif
+
+//@}
+
+// Reads the columns I to N - 1 of a row into the elements of a tuple.
+template <std::size_t I, std::size_t N>
+struct RowTupleReader
+{
+    template <typename Tuple>
+    static void read(const Row& row, Tuple& ret)
+    {
+        row.getValue(I, std::get<I>(ret));
+        RowTupleReader<I + 1, N>::read(row, ret);
+    }
+};
+
+template <std::size_t N>
+struct RowTupleReader<N, N>
+{
+    template <typename Tuple>
+    static void read(const Row&, Tuple&)
+    { }
+};
+
+template <typename... T>
+std::tuple<T...> Row::getTuple() const
+{
+    if (size() < sizeof...(T))
+        throw std::out_of_range("row has less columns than requested");
+
+    std::tuple<T...> ret;
+    RowTupleReader<0, sizeof...(T)>::read(*this, ret);
+    return ret;
+}
+
+// Visitor for tntdb::Binding, which reads each member from the column
+// with the bound name.
+class RowBinder
+{
+    const Row& _row;
+
+  public:
+    explicit RowBinder(const Row& row)
+      : _row(row)
+      { }
+
+    template <typename T>
+    void operator() (const char* name, T& value)
+      { _row.getValue(_row.getColumnIndex(name), value); }
+};
+
+template <typename T>
+void getObject(const Row& row, T& obj, std::true_type)
+{
+    RowBinder binder(row);
+    Binding<T>::visit(binder, obj);
+}
 }
 
 #endif // TNTDB_BITS_ROW_H
@@ -84,14 +84,14 @@ public:
     /// might be null or just initialize your value with a suitable default.
     template <typename T>
     RowReader& get(T& ret)
-    { _row[_fieldNum++].get(ret); return *this; }
+    { _row.getValue(_fieldNum++, ret); return *this; }
 
     /// Reads the current column value and a null indicator and increments the
     /// field counter. If the value is null, the null indicator is set to false
     /// and the actual value of the passed variable is not changed.
     template <typename T>
     RowReader& get(T& ret, bool& nullInd)
-    { nullInd = _row[_fieldNum++].get(ret); return *this; }
+    { nullInd = _row.getValue(_fieldNum++, ret); return *this; }
 
     /// Reads the current value into a tntdb::Value and increments the field
     /// counter.
@@ -100,7 +100,7 @@ public:
 
     /// Returns true, if the current value is null.
     bool isNull() const
-    { return _row[_fieldNum].isNull(); }
+    { return _row.isNull(_fieldNum); }
 
     /// Resets the field counter to the passed value.
     void rewind(Row::size_type n_ = 0)
@@ -30,6 +30,7 @@
 #define TNTDB_BITS_STATEMENT_H
 
 #include <tntdb/iface/istatement.h>
+#include <tntdb/hostvarhandle.h>
 #include <tntdb/serialization.h>
 #include <tntdb/date.h>
 #include <tntdb/time.h>
@@ -39,6 +40,7 @@
 #include <string>
 #include <memory>
 #include <vector>
+#include <typeinfo>
 #include <list>
 #include <deque>
 #include <set>
@@ -58,6 +60,7 @@ class Value;
 class Date;
 class Time;
 class Datetime;
+template <typename... T> class TypedRows;
 
 /** This class represents an SQL statement
 
@@ -216,12 +219,16 @@ public:
     template <typename Iterator>
     Statement& set(const std::string& col, Iterator it1, Iterator it2);
 
+    /** Sets the host variables from the members of an object.
+
+        When a tntdb::Binding is defined for the type, the members are set
+        directly. Otherwise the object is serialized into a
+        cxxtools::SerializationInfo, which is then read into the statement.
+     */
     template <typename Object>
     Statement& set(const Object& obj)
     {
-        cxxtools::SerializationInfo si;
-        si <<= obj;
-        si >>= *this;
+        setObject(*this, obj, std::integral_constant<bool, Binding<Object>::defined>());
         return *this;
     }
 
@@ -240,6 +247,126 @@ public:
         return *this;
     }
 
+    /** Returns a handle to the host variable with the given name
+
+        The handle can be passed to the set methods instead of the name. The
+        driver resolves the name only once, which makes setting values in
+        tight loops cheaper.
+     */
+    HostvarHandle hostvar(const std::string& col) const
+      { return _stmt->hostvar(col); }
+
+    /// Set the host variable referenced by the handle to NULL
+    Statement& setNull(const HostvarHandle& hostvar)
+      { _stmt->setNull(hostvar); return *this; }
+
+    /// Set the host variable referenced by the handle to a boolean value
+    Statement& setBool(const HostvarHandle& hostvar, bool data)
+      { _stmt->setBool(hostvar, data); return *this; }
+
+    /// Set the host variable referenced by the handle to a short value
+    Statement& setShort(const HostvarHandle& hostvar, short data)
+      { _stmt->setShort(hostvar, data); return *this; }
+
+    /// Set the host variable referenced by the handle to an int value
+    Statement& setInt(const HostvarHandle& hostvar, int data)
+      { _stmt->setInt(hostvar, data); return *this; }
+
+    /// Set the host variable referenced by the handle to a long value
+    Statement& setLong(const HostvarHandle& hostvar, long data)
+      { _stmt->setLong(hostvar, data); return *this; }
+
+    /// Set the host variable referenced by the handle to an unsigned short value
+    Statement& setUnsignedShort(const HostvarHandle& hostvar, unsigned short data)
+      { _stmt->setUnsignedShort(hostvar, data); return *this; }
+
+    /// Set the host variable referenced by the handle to an unsigned value
+    Statement& setUnsigned(const HostvarHandle& hostvar, unsigned data)
+      { _stmt->setUnsigned(hostvar, data); return *this; }
+
+    /// Set the host variable referenced by the handle to an unsigned long value
+    Statement& setUnsignedLong(const HostvarHandle& hostvar, unsigned long data)
+      { _stmt->setUnsignedLong(hostvar, data); return *this; }
+
+    /// Set the host variable referenced by the handle to a int32_t value
+    Statement& setInt32(const HostvarHandle& hostvar, int32_t data)
+      { _stmt->setInt32(hostvar, data); return *this; }
+
+    /// Set the host variable referenced by the handle to a uint32_t value
+    Statement& setUnsigned32(const HostvarHandle& hostvar, uint32_t data)
+      { _stmt->setUnsigned32(hostvar, data); return *this; }
+
+    /// Set the host variable referenced by the handle to a int64_t value
+    Statement& setInt64(const HostvarHandle& hostvar, int64_t data)
+      { _stmt->setInt64(hostvar, data); return *this; }
+
+    /// Set the host variable referenced by the handle to a uint64_t value
+    Statement& setUnsigned64(const HostvarHandle& hostvar, uint64_t data)
+      { _stmt->setUnsigned64(hostvar, data); return *this; }
+
+    /// Set the host variable referenced by the handle to a Decimal
+    Statement& setDecimal(const HostvarHandle& hostvar, const Decimal& data)
+      { _stmt->setDecimal(hostvar, data); return *this; }
+
+    /// Set the host variable referenced by the handle to a float value
+    Statement& setFloat(const HostvarHandle& hostvar, float data)
+      { _stmt->setFloat(hostvar, data); return *this; }
+
+    /// Set the host variable referenced by the handle to a double value
+    Statement& setDouble(const HostvarHandle& hostvar, double data)
+      { _stmt->setDouble(hostvar, data); return *this; }
+
+    /// Set the host variable referenced by the handle to a char value
+    Statement& setChar(const HostvarHandle& hostvar, char data)
+      { _stmt->setChar(hostvar, data); return *this; }
+
+    /// Set the host variable referenced by the handle to a string value
+    Statement& setString(const HostvarHandle& hostvar, const std::string& data)
+      { _stmt->setString(hostvar, data); return *this; }
+
+    /// Set the host variable referenced by the handle to a string value or null
+    Statement& setString(const HostvarHandle& hostvar, const char* data)
+      { data == 0 ? _stmt->setNull(hostvar)
+                  : _stmt->setString(hostvar, data); return *this; }
+
+    /// Set the host variable referenced by the handle to a unicode string value
+    Statement& setUString(const HostvarHandle& hostvar, const cxxtools::String& data)
+      { _stmt->setUString(hostvar, data); return *this; }
+
+    /// Set the host variable referenced by the handle to a blob value
+    Statement& setBlob(const HostvarHandle& hostvar, const Blob& data)
+      { _stmt->setBlob(hostvar, data); return *this; }
+
+    /// Set the host variable referenced by the handle to a date value
+    Statement& setDate(const HostvarHandle& hostvar, const Date& data)
+      { data.isNull() ? _stmt->setNull(hostvar)
+                      : _stmt->setDate(hostvar, data); return *this; }
+
+    /// Set the host variable referenced by the handle to a time value
+    Statement& setTime(const HostvarHandle& hostvar, const Time& data)
+      { data.isNull() ? _stmt->setNull(hostvar)
+                      : _stmt->setTime(hostvar, data); return *this; }
+
+    /// Set the host variable referenced by the handle to a datetime value
+    Statement& setDatetime(const HostvarHandle& hostvar, const Datetime& data)
+      { data.isNull() ? _stmt->setNull(hostvar)
+                      : _stmt->setDatetime(hostvar, data); return *this; }
+
+    /// Set the host variable referenced by the handle to the passed value
+    template <typename T>
+    Statement& set(const HostvarHandle& hostvar, const T& data);
+
+    /// Set the host variable referenced by the handle to the passed value or null
+    template <typename T>
+    Statement& setIf(const HostvarHandle& hostvar, bool notNull, const T& data)
+    {
+        if (notNull)
+            set(hostvar, data);
+        else
+            setNull(hostvar);
+        return *this;
+    }
+
     /// Statement execution methods
     /// @{
     /** Execute the query without returning the result
@@ -274,6 +401,21 @@ public:
     /// Create a database cursor and fetch the first row of the query result
     const_iterator begin(unsigned fetchsize = 100) const;
 
+    /** Returns a range, which reads the rows of the query into tuples
+
+        The query is executed, when the iteration starts. The columns are
+        converted to the passed types using the typed getters of the row.
+
+        @code
+          for (const auto& [id, name] : stmt.rows<int64_t, std::string>())
+          {
+            // ...
+          }
+        @endcode
+     */
+    template <typename... T>
+    TypedRows<T...> rows(unsigned fetchsize = 100) const;
+
     /** Get an end iterator
 
         This iterator works like the iterator got from the %end() method of STL containers
@@ -307,6 +449,41 @@ public:
     /// Returns number of affected rows.
     size_type flush();
 
+    /** Passes parameters in the binary format of the database.
+
+        The postgresql driver then declares the types of the parameters from
+        the C++ types of the bound values, e.g. int4 for int and float8 for
+        double, instead of letting the server infer them from the query. A
+        value, which does not match the column, like a bool compared with an
+        integer column, then fails, and a double compared with an integer
+        column does not use its index. When other types are bound later, the
+        statement is prepared again. Other drivers ignore this.
+
+        The default is false. It should be set before values are bound.
+     */
+    void binaryParams(bool enable);
+
+    /** Requests results in the binary format of the database.
+
+        The values are then decoded without parsing text. Only the
+        postgresql driver supports this. Other drivers ignore it.
+
+        The default is false.
+     */
+    void binaryResults(bool enable);
+
+    /** Reads the rows of cursors from a single execution of the query.
+
+        The postgresql driver then streams the rows instead of declaring a
+        cursor on the server and fetching the rows in blocks. The connection
+        can't be used for other commands until the cursor is finished, and
+        the cursor does not survive the end of the transaction. Other
+        drivers ignore this.
+
+        The default is false.
+     */
+    void streamingCursor(bool enable);
+
     /// @{
     /// Get the actual implementation object
     const IStatement* getImpl() const { return &*_stmt; }
@@ -314,67 +491,70 @@ public:
     /// @}
 };
 
-/// Helper class to hold a Statement and a column name
+/// Helper class to hold a Statement and a column name or handle
 class Hostvar
 {
 private:
     Statement& _stmt;
     const std::string& _name;
+    const HostvarHandle* _handle;
 
 public:
     Hostvar(Statement& stmt, const std::string& name)
       : _stmt(stmt),
-        _name(name)
+        _name(name),
+        _handle(0)
+        { }
+    Hostvar(Statement& stmt, const HostvarHandle& handle)
+      : _stmt(stmt),
+        _name(handle.getName()),
+        _handle(&handle)
         { }
     Statement& getStatement()    { return _stmt; }
     const std::string& getName() { return _name; }
 
     void setNull()
-      { _stmt.setNull(_name); }
+      { _handle ? _stmt.setNull(*_handle) : _stmt.setNull(_name); }
     void setBool(bool data)
-      { _stmt.setBool(_name, data); }
+      { _handle ? _stmt.setBool(*_handle, data) : _stmt.setBool(_name, data); }
     void setInt(int data)
-      { _stmt.setInt(_name, data); }
+      { _handle ? _stmt.setInt(*_handle, data) : _stmt.setInt(_name, data); }
     void setLong(long data)
-      { _stmt.setLong(_name, data); }
+      { _handle ? _stmt.setLong(*_handle, data) : _stmt.setLong(_name, data); }
     void setUnsigned(unsigned data)
-      { _stmt.setUnsigned(_name, data); }
+      { _handle ? _stmt.setUnsigned(*_handle, data) : _stmt.setUnsigned(_name, data); }
     void setUnsignedLong(unsigned long data)
-      { _stmt.setUnsignedLong(_name, data); }
+      { _handle ? _stmt.setUnsignedLong(*_handle, data) : _stmt.setUnsignedLong(_name, data); }
     void setInt32(int32_t data)
-      { _stmt.setInt32(_name, data); }
+      { _handle ? _stmt.setInt32(*_handle, data) : _stmt.setInt32(_name, data); }
     void setUnsigned32(uint32_t data)
-      { _stmt.setUnsigned32(_name, data); }
+      { _handle ? _stmt.setUnsigned32(*_handle, data) : _stmt.setUnsigned32(_name, data); }
     void setInt64(int64_t data)
-      { _stmt.setInt64(_name, data); }
+      { _handle ? _stmt.setInt64(*_handle, data) : _stmt.setInt64(_name, data); }
     void setUnsigned64(uint64_t data)
-      { _stmt.setUnsigned64(_name, data); }
+      { _handle ? _stmt.setUnsigned64(*_handle, data) : _stmt.setUnsigned64(_name, data); }
     void setDecimal(const Decimal& data)
-      { _stmt.setDecimal(_name, data); }
+      { _handle ? _stmt.setDecimal(*_handle, data) : _stmt.setDecimal(_name, data); }
     void setFloat(float data)
-      { _stmt.setFloat(_name, data); }
+      { _handle ? _stmt.setFloat(*_handle, data) : _stmt.setFloat(_name, data); }
     void setDouble(double data)
-      { _stmt.setDouble(_name, data); }
+      { _handle ? _stmt.setDouble(*_handle, data) : _stmt.setDouble(_name, data); }
     void setChar(char data)
-      { _stmt.setChar(_name, data); }
+      { _handle ? _stmt.setChar(*_handle, data) : _stmt.setChar(_name, data); }
     void setString(const std::string& data)
-      { _stmt.setString(_name, data); }
+      { _handle ? _stmt.setString(*_handle, data) : _stmt.setString(_name, data); }
     void setString(const char* data)
-      { data == 0 ? _stmt.setNull(_name)
-                  : _stmt.setString(_name, data); }
+      { _handle ? _stmt.setString(*_handle, data) : _stmt.setString(_name, data); }
     void setUString(const cxxtools::String& data)
-      { _stmt.setUString(_name, data); }
+      { _handle ? _stmt.setUString(*_handle, data) : _stmt.setUString(_name, data); }
     void setBlob(const Blob& data)
-      { _stmt.setBlob(_name, data); }
+      { _handle ? _stmt.setBlob(*_handle, data) : _stmt.setBlob(_name, data); }
     void setDate(const Date& data)
-      { data.isNull() ? _stmt.setNull(_name)
-                      : _stmt.setDate(_name, data); }
+      { _handle ? _stmt.setDate(*_handle, data) : _stmt.setDate(_name, data); }
     void setTime(const Time& data)
-      { data.isNull() ? _stmt.setNull(_name)
-                      : _stmt.setTime(_name, data); }
+      { _handle ? _stmt.setTime(*_handle, data) : _stmt.setTime(_name, data); }
     void setDatetime(const Datetime& data)
-      { data.isNull() ? _stmt.setNull(_name)
-                      : _stmt.setDatetime(_name, data); }
+      { _handle ? _stmt.setDatetime(*_handle, data) : _stmt.setDatetime(_name, data); }
 
     template <typename T>
     void set(const T& data);
@@ -486,6 +666,14 @@ Statement& Statement::set(const std::string& name, const T& data)
   return *this;
 }
 
+template <typename T>
+Statement& Statement::set(const HostvarHandle& hostvar, const T& data)
+{
+  Hostvar h(*this, hostvar);
+  h << data;
+  return *this;
+}
+
 template <typename Iterator>
 Statement& Statement::set(const std::string& col, Iterator it1, Iterator it2)
 {
@@ -499,6 +687,44 @@ Statement& Statement::set(const std::string& col, Iterator it1, Iterator it2)
 template <typename T>
 void Hostvar::set(const T& data)
   { *this << data; }
+
+// Visitor for tntdb::Binding, which sets a host variable for each member.
+// The handles are resolved by name for the first object of a type and then
+// taken by position, so the members must be visited in the same order.
+class StatementBinder
+{
+    Statement& _stmt;
+    std::vector<HostvarHandle>& _handles;
+    unsigned _n;
+
+  public:
+    StatementBinder(Statement& stmt, std::vector<HostvarHandle>& handles)
+      : _stmt(stmt),
+        _handles(handles),
+        _n(0)
+      { }
+
+    template <typename T>
+    void operator() (const char* name, const T& value)
+    {
+        if (_n == _handles.size())
+            _handles.push_back(_stmt.hostvar(name));
+
+        // members without a host variable in the statement are skipped
+        const HostvarHandle& handle = _handles[_n++];
+        if (!handle)
+            return;
+
+        _stmt.set(handle, value);
+    }
+};
+
+template <typename T>
+void setObject(Statement& stmt, const T& obj, std::true_type)
+{
+    StatementBinder binder(stmt, stmt.getImpl()->bindingHandles(typeid(T)));
+    Binding<T>::visit(binder, obj);
+}
 }
 
 #endif // TNTDB_BITS_STATEMENT_H
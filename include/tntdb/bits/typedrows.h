@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2005 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef TNTDB_BITS_TYPEDROWS_H
+#define TNTDB_BITS_TYPEDROWS_H
+
+#include <tntdb/bits/statement.h>
+#include <tntdb/bits/statement_iterator.h>
+#include <tntdb/bits/row.h>
+#include <tuple>
+#include <iterator>
+
+namespace tntdb
+{
+/**
+ * Range of the rows of a query, which are read into tuples of the types
+ * passed as template parameters.
+ *
+ * The query is executed, when iteration starts. Each row is read into a
+ * std::tuple<T...> using the typed getters of the row, so no tntdb::Value
+ * is created for standard types.
+ *
+ * The class is normally instantiated using tntdb::Statement::rows.
+ *
+ * Example:
+ * \code
+ *   tntdb::Statement stmt = conn.prepare("select id, name, ts from tab1");
+ *   for (const auto& [id, name, ts] : stmt.rows<int64_t, std::string, tntdb::Datetime>())
+ *   {
+ *     // ...
+ *   }
+ * \endcode
+ */
+template <typename... T>
+class TypedRows
+{
+    Statement _stmt;
+    unsigned _fetchsize;
+
+public:
+    typedef std::tuple<T...> value_type;
+
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using difference_type = int;
+        using value_type = std::tuple<T...>;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+    private:
+        Statement::const_iterator _cursor;
+        value_type _current;
+
+        void read()
+        {
+            if (_cursor != Statement::const_iterator())
+                _current = _cursor->template getTuple<T...>();
+        }
+
+    public:
+        const_iterator() { }
+
+        explicit const_iterator(const Statement::const_iterator& cursor)
+          : _cursor(cursor)
+          { read(); }
+
+        bool operator== (const const_iterator& it) const
+          { return _cursor == it._cursor; }
+        bool operator!= (const const_iterator& it) const
+          { return _cursor != it._cursor; }
+
+        const_iterator& operator++()
+          { ++_cursor; read(); return *this; }
+
+        const value_type& operator* () const   { return _current; }
+        const value_type* operator-> () const  { return &_current; }
+
+        /// Returns the current row.
+        const Row& getRow() const              { return *_cursor; }
+    };
+
+    TypedRows(const Statement& stmt, unsigned fetchsize)
+      : _stmt(stmt),
+        _fetchsize(fetchsize)
+      { }
+
+    /// Executes the query and reads the first row.
+    const_iterator begin() const    { return const_iterator(_stmt.begin(_fetchsize)); }
+    const_iterator end() const      { return const_iterator(); }
+};
+
+template <typename... T>
+TypedRows<T...> Statement::rows(unsigned fetchsize) const
+{ return TypedRows<T...>(*this, fetchsize); }
+
+}
+
+#endif // TNTDB_BITS_TYPEDROWS_H
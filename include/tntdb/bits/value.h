@@ -38,6 +38,7 @@
 #include <memory>
 #if __cplusplus >= 201703L
 #include <optional>
+#include <string_view>
 #endif
 
 
@@ -117,6 +118,46 @@ public:
     /// Returns the value as a blob.
     void getBlob(Blob& blob) const
       { _value->getBlob(blob); }
+
+    /// Sets data and length to the text of the value without copying it.
+    /// When the driver holds the value as text, the data points into the
+    /// buffer of the driver. Values, which need a conversion, are converted
+    /// into buffer.
+    ///
+    /// The data is valid only as long as this Value and the Row and Result
+    /// it was fetched from are alive and buffer is not modified. For
+    /// cursors it is valid only until the next row is fetched.
+    void getStringView(const char*& data, std::size_t& length, std::string& buffer) const
+    {
+        if (!_value->getStringView(data, length))
+        {
+            _value->getString(buffer);
+            data = buffer.data();
+            length = buffer.size();
+        }
+    }
+    /// Like getStringView, but for binary data.
+    void getBlobView(const char*& data, std::size_t& length, std::string& buffer) const
+    {
+        if (!_value->getBlobView(data, length))
+        {
+            Blob blob;
+            _value->getBlob(blob);
+            buffer.assign(blob.data(), blob.size());
+            data = buffer.data();
+            length = buffer.size();
+        }
+    }
+#if __cplusplus >= 201703L
+    /// Returns a view of the text of the value.
+    /// See getStringView(const char*&, std::size_t&, std::string&) for the lifetime.
+    std::string_view getStringView(std::string& buffer) const
+      { const char* data; std::size_t length; getStringView(data, length, buffer); return std::string_view(data, length); }
+    /// Returns a view of the binary data of the value.
+    /// See getStringView(const char*&, std::size_t&, std::string&) for the lifetime.
+    std::string_view getBlobView(std::string& buffer) const
+      { const char* data; std::size_t length; getBlobView(data, length, buffer); return std::string_view(data, length); }
+#endif
     /// returns the value as a Date.
     Date getDate() const                { return _value->getDate(); }
     /// returns the value as a Time.
@@ -31,6 +31,7 @@
 
 #include <string>
 #include <tntdb/connection.h>
+#include <tntdb/connectionpool.h>
 
 namespace tntdb
 {
@@ -84,6 +85,12 @@ unsigned cachedConnections();
 unsigned cachedConnections(const std::string& url, const std::string& username, const std::string& password);
 unsigned cachedConnections(const std::string& url);
 
+/** Returns the counters of the pool of connectCached for the specified url.
+    The counters are zero, when there is no pool for the url. See
+    ConnectionPool::getMetrics.
+ */
+PoolMetrics cachedConnectionMetrics(const std::string& url, const std::string& username = "", const std::string& password = "");
+
 /** Release unused connections; keep the given number of connections.
     Returns the number of connections freed.
     Note that connections, which are in use are not freed.
@@ -99,19 +106,59 @@ void dropCached(const std::string& url, const std::string& username = "", const
 inline void dropCached(const std::string& url, unsigned keep)
   { dropCached(url, "", "", keep); }
 
-/** Set the maximum pool size for new connection pools
-
-    When the maximum number of connections to a specific url is reached,
-    connectCached blocks until a connection is available.
+/** Set the maximum number of idle connections kept per pool
 
-    This setting do not affect pools with active connections. You have to
-    release all connections and clear the pool of all connections to your
-    database with dropCached(url) for this setting to take effect.
+    Connections, which are released when the maximum is reached, are
+    closed. 0 keeps all connections.
  */
 void setMaxPoolSize(unsigned max);
 
 /// Get the current setting for maximum pool size (see setMaxPoolSize())
 unsigned getMaxPoolSize();
+
+/** Limit the number of open connections per url
+
+    When the maximum number of connections to a specific url is reached,
+    connectCached blocks until a connection is released. Waiting threads
+    are served in the order of arrival. When no connection is available
+    within the timeout, tntdb::PoolTimeout is thrown. Passing 0 as max
+    removes the limit. See ConnectionPool::setMaxSize.
+ */
+void setPoolLimit(unsigned max, std::chrono::milliseconds timeout = std::chrono::milliseconds::max());
+
+/// Returns the number of threads waiting in connectCached for a connection.
+unsigned cachedConnectionWaiters();
+
+/** Keep at least the given number of idle connections per url
+
+    The pools of connectCached are refilled in a background thread, when
+    connections are taken or dropped. See ConnectionPool::setMinIdle.
+ */
+void setPoolMinIdle(unsigned n);
+
+/** Let each thread keep its last released connection per url
+
+    connectCached returns the kept connection to the same thread without
+    locking. Pools limited with setPoolLimit do not keep connections in
+    threads. See ConnectionPool::setThreadCache.
+ */
+void setPoolThreadCache(bool enable);
+
+/** Open cached connections in parallel, until n connections are idle
+
+    This is meant to be called at startup, so that the first requests do
+    not have to wait for new connections. Returns the number of connections
+    opened. See ConnectionPool::warmup.
+ */
+unsigned warmupCached(const std::string& url, const std::string& username, const std::string& password, unsigned n);
+
+/** Set how cached connections are validated, before they are reused
+
+    By default every connection is pinged, before connectCached returns it.
+    Connections, which were used or validated within the given interval,
+    are returned without validation. See ConnectionPool::setValidation.
+ */
+void setPoolValidation(ConnectionPool::Validation validation, std::chrono::milliseconds interval = std::chrono::milliseconds(0));
 }
 
 #endif // TNTDB_CONNECT_H
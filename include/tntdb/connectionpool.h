@@ -29,29 +29,136 @@
 #ifndef TNTDB_CONNECTIONPOOL_H
 #define TNTDB_CONNECTIONPOOL_H
 
+#include <tntdb/metrics.h>
 #include <map>
 #include <string>
-#include <vector>
+#include <deque>
 #include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
 #include <memory>
+#include <chrono>
 
 namespace tntdb
 {
 class Connection;
 class IConnection;
+class ConnectionPools;
 
 class ConnectionPool
 {
     friend class PoolConnection;
+    friend class ConnectionPools;
+
+public:
+    /// Specifies how idle connections are checked, before they are reused.
+    enum Validation
+    {
+        validateNone,   ///< reuse idle connections without checking
+        validateAlive,  ///< check the state of the connection without a round trip (see Connection::isAlive)
+        validatePing    ///< send a ping to the server (see Connection::ping)
+    };
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    struct IdleConnection
+    {
+        std::shared_ptr<IConnection> connection;
+        Clock::time_point lastUsed;
+    };
+
+    // A thread waiting in connect for a connection of a full pool. It gets
+    // either a connection passed directly or the permission to open a new
+    // one.
+    struct Waiter
+    {
+        std::condition_variable cond;
+        std::shared_ptr<IConnection> connection;
+        bool ready;
+
+        Waiter() : ready(false) { }
+    };
+
+    // Keeps the last released connection of a thread per pool.
+    class ThreadCache;
+
+    // Refers to the pool from the thread caches. The pointer is reset,
+    // when the pool is destroyed, so that other threads, which still keep
+    // a connection of the pool, don't use it any more.
+    struct Handle
+    {
+        std::mutex mutex;
+        ConnectionPool* pool;
+
+        explicit Handle(ConnectionPool* p) : pool(p) { }
+    };
 
     std::string _url;
     std::string _username;
     std::string _password;
     mutable std::mutex _mutex;
 
-    std::vector<std::shared_ptr<IConnection>> _connectionPool;
+    // The most recently used connections are at the back.
+    std::deque<IdleConnection> _connectionPool;
     unsigned _maxSpare;
+
+    // Settings, which are read without locking.
+    std::atomic<Validation> _validation;
+    std::atomic<std::chrono::milliseconds> _validationInterval;
+    std::atomic<unsigned> _maxSize;
+    std::atomic<std::chrono::milliseconds> _timeout;
+    std::atomic<bool> _threadCache;
+    std::shared_ptr<Handle> _handle;
+
+    // The ConnectionPools object, which created the pool, if any.
+    const ConnectionPools* _owner;
+
+    // Number of open connections including connections in use, connections
+    // kept in thread caches and connections, which are being opened.
+    unsigned _size;
+
+    // The waiting threads in the order of arrival.
+    std::deque<Waiter*> _waiters;
+    unsigned long _waitCount;
+    unsigned long _timeoutCount;
+
+    // Background thread, which opens connections, when there are less
+    // than _minIdle idle connections.
+    unsigned _minIdle;
+    std::thread _refillThread;
+    bool _refilling;
+    bool _stopping;
+
+    // Counters for getMetrics, which are updated without locking.
+    std::atomic<unsigned> _inUse;
+    std::atomic<unsigned long> _checkouts;
+    std::atomic<unsigned long> _creations;
+    std::atomic<unsigned long> _creationFailures;
+    std::atomic<unsigned long> _pings;
+    std::atomic<unsigned long> _failedPings;
+    std::atomic<unsigned long> _drops;
+    LatencyHistogram _waitTime;
+    LatencyHistogram _holdTime;
+
     void put(std::shared_ptr<IConnection>& conn);
+    void release();
+    bool needsRefill() const;
+    void startRefill();
+    void refill();
+    bool reserveSlot();
+    void openIdle();
+    void putIdle(IdleConnection& idle);
+    void releaseSlot();
+    bool checkout(std::unique_lock<std::mutex>& lock, std::chrono::milliseconds timeout, IdleConnection& idle);
+    Validation validationFor(Clock::time_point lastUsed) const;
+    bool validate(IConnection& conn, Validation validation);
+    std::shared_ptr<IConnection> create();
+    Connection checkedOut(std::shared_ptr<IConnection>&& conn, Clock::time_point start);
+    void checkedIn(Clock::time_point checkoutTime, bool dropped);
+    bool connectThreadCached(Connection& conn);
+    static bool connectThreadCached(const ConnectionPools* owner, const std::string& url, const std::string& username, const std::string& password, Connection& conn);
 
     ConnectionPool(const ConnectionPool&) = delete;
     ConnectionPool& operator=(const ConnectionPool&) = delete;
@@ -61,17 +168,141 @@ public:
         : _url(url),
           _username(username),
           _password(password),
-          _maxSpare(maxSpare)
+          _maxSpare(maxSpare),
+          _validation(validatePing),
+          _validationInterval(std::chrono::milliseconds(0)),
+          _maxSize(0),
+          _timeout(std::chrono::milliseconds::max()),
+          _threadCache(false),
+          _handle(std::make_shared<Handle>(this)),
+          _owner(0),
+          _size(0),
+          _waitCount(0),
+          _timeoutCount(0),
+          _minIdle(0),
+          _refilling(false),
+          _stopping(false),
+          _inUse(0),
+          _checkouts(0),
+          _creations(0),
+          _creationFailures(0),
+          _pings(0),
+          _failedPings(0),
+          _drops(0)
         { }
 
+    ~ConnectionPool();
+
+    /** Fetch a connection from the pool or create a new one
+
+        The idle connection, which was used most recently, is validated as
+        specified with setValidation. Dead connections and connections,
+        whose validation throws an exception, are dropped. The
+        validation and the creation of a new connection are done without
+        holding the lock of the pool, so that other threads are not blocked.
+
+        When the maximum number of connections is reached, the call waits
+        for a connection to be released. Waiting threads are served in the
+        order of arrival. When the timeout set with setMaxSize passes,
+        tntdb::PoolTimeout is thrown.
+     */
     Connection connect();
 
+    /// Like connect, but with the passed timeout instead of the one of the pool.
+    Connection connect(std::chrono::milliseconds timeout);
+
     /// Release unused connections; keep the given number of connections
     void drop(unsigned keep = 0);
 
+    /** Ping all idle connections and drop the dead ones
+
+        The connections are checked one at a time without holding the lock
+        of the pool, so that connect is not blocked. This is meant to be
+        called periodically, e.g. from a maintenance thread, when the
+        validation at checkout is reduced to validateAlive or validateNone.
+     */
+    void validateIdle();
+
     unsigned getMaxSpare() const    { return _maxSpare; }
     void setMaxSpare(unsigned m);
-    unsigned getCurrentSize() const { return _connectionPool.size(); }
+
+    /// Returns the number of idle connections.
+    unsigned getCurrentSize() const;
+
+    /** Limit the number of open connections
+
+        The limit counts connections in use and idle connections. Passing 0
+        removes the limit, which is the default. A timeout of
+        std::chrono::milliseconds::max() lets connect wait forever.
+     */
+    void setMaxSize(unsigned max, std::chrono::milliseconds timeout = std::chrono::milliseconds::max());
+    unsigned getMaxSize() const;
+    std::chrono::milliseconds getTimeout() const;
+
+    /// Returns the number of open connections including the ones in use.
+    unsigned getSize() const;
+    /// Returns the number of threads currently waiting for a connection.
+    unsigned getWaiting() const;
+    /// Returns the number of calls to connect, which had to wait.
+    unsigned long getWaitCount() const;
+    /// Returns the number of calls to connect, which timed out.
+    unsigned long getTimeoutCount() const;
+
+    /** Returns a snapshot of the counters of the pool
+
+        The counters are cumulative since the pool was created. The wait
+        time histogram measures the time spent in connect including the
+        validation and the creation of connections; the hold time histogram
+        the time from connect to the release of the connection.
+     */
+    PoolMetrics getMetrics() const;
+
+    /** Open connections in parallel, until n connections are idle
+
+        Each connection is opened in a thread of its own, so that the
+        handshakes with the server overlap. The limit set with setMaxSize is
+        respected. Returns the number of connections opened. Errors are
+        logged and not thrown.
+     */
+    unsigned warmup(unsigned n);
+
+    /** Keep at least the given number of idle connections
+
+        When connections are taken from the pool or dropped, the pool is
+        refilled in a background thread. The limit set with setMaxSize is
+        respected. 0, the default, disables refilling.
+     */
+    void setMinIdle(unsigned n);
+    unsigned getMinIdle() const;
+
+    /** Let each thread keep its last released connection for reuse
+
+        A thread keeps at most one connection per pool. connect returns it
+        to the same thread without locking. Further connections go back to
+        the shared pool. A kept connection is returned to the pool, when the
+        thread exits.
+
+        Kept connections can't be passed to other threads. So pools with a
+        maximum size (see setMaxSize) do not keep connections in threads.
+        The thread cache is disabled by default.
+
+        The pool may be destroyed, while other threads still keep one of its
+        connections. Such a connection is closed, when the thread exits or
+        keeps a connection of another pool. Connections, which are in use,
+        must be released before the pool is destroyed.
+     */
+    void setThreadCache(bool enable);
+    bool getThreadCache() const     { return _threadCache; }
+
+    /** Set how idle connections are validated, before they are reused
+
+        Connections, which were used or validated within the given interval,
+        are reused without validation. The default is to ping every idle
+        connection at checkout.
+     */
+    void setValidation(Validation validation, std::chrono::milliseconds interval = std::chrono::milliseconds(0));
+    Validation getValidation() const;
+    std::chrono::milliseconds getValidationInterval() const;
 };
 
 class ConnectionPools
@@ -115,11 +346,25 @@ public:
 private:
     PoolsType _pools;
     unsigned _maxcount;
+    PoolType::Validation _validation;
+    std::chrono::milliseconds _validationInterval;
+    unsigned _maxSize;
+    std::chrono::milliseconds _timeout;
+    unsigned _minIdle;
+    std::atomic<bool> _threadCache;
     mutable std::mutex _mutex;
 
+    PoolType& getPool(const std::string& url, const std::string& username, const std::string& password);
+
 public:
     explicit ConnectionPools(unsigned maxcount = 0)
-      : _maxcount(maxcount)
+      : _maxcount(maxcount),
+        _validation(PoolType::validatePing),
+        _validationInterval(0),
+        _maxSize(0),
+        _timeout(std::chrono::milliseconds::max()),
+        _minIdle(0),
+        _threadCache(false)
       { }
 
     Connection connect(const std::string& url, const std::string& username, const std::string& password);
@@ -136,8 +381,30 @@ public:
         { return _maxcount; }
 
     void setMaxSpare(unsigned m);
+
+    /// Set the validation of idle connections for all pools (see ConnectionPool::setValidation)
+    void setValidation(PoolType::Validation validation, std::chrono::milliseconds interval = std::chrono::milliseconds(0));
+
+    /// Limit the number of open connections of each pool (see ConnectionPool::setMaxSize)
+    void setMaxSize(unsigned max, std::chrono::milliseconds timeout = std::chrono::milliseconds::max());
+
+    /// Returns the number of threads currently waiting for a connection in any pool.
+    unsigned getWaiting() const;
+
+    /// Keep at least the given number of idle connections in each pool (see ConnectionPool::setMinIdle)
+    void setMinIdle(unsigned n);
+
+    /// Let each thread keep its last released connection per pool (see ConnectionPool::setThreadCache)
+    void setThreadCache(bool enable);
+
+    /// Open connections in parallel, until n connections are idle (see ConnectionPool::warmup)
+    unsigned warmup(const std::string& url, const std::string& username, const std::string& password, unsigned n);
+
     unsigned getCurrentSize(const std::string& url, const std::string& username, const std::string& password) const;
     unsigned getCurrentSize() const;
+
+    /// Returns the counters of the pool with the given parameters (see ConnectionPool::getMetrics)
+    PoolMetrics getMetrics(const std::string& url, const std::string& username, const std::string& password) const;
 };
 }
 
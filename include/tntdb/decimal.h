@@ -31,6 +31,7 @@
 
 #include <string>
 #include <limits>
+#include <memory>
 #include <iosfwd>
 
 namespace tntdb
@@ -40,23 +41,43 @@ class Decimal
 public:
     typedef long long LongType;
     typedef unsigned long long UnsignedLongType;
+#ifdef __SIZEOF_INT128__
+    __extension__ typedef unsigned __int128 CoefficientType;
+#else
+    typedef unsigned long long CoefficientType;
+#endif
 
 private:
-
-    // inf: _mantissa is empty, _exponent = numeric_limits<short>::max()
-    // nan: _mantissa is empty, _exponent==0
-    std::string _mantissa;  // just '0'-'9'
-    short _exponent;
+    enum Kind {
+        finite,
+        infinite,
+        notANumber
+    };
+
+    // The value is coefficient * 10^_scale. The coefficient has no trailing
+    // zeros, so that each value has exactly one representation.
+    //
+    // Coefficients, which do not fit into CoefficientType, are kept as
+    // decimal digits in _digits; _coefficient is unused then.
+    CoefficientType _coefficient;
+    std::string _digits;
+    short _scale;
+    unsigned char _kind;
     bool _negative;
 
-    Decimal(const std::string& mantissa, short exponent, bool negative)
-      : _mantissa(mantissa),
-        _exponent(exponent),
-        _negative(negative)
-      { }
+    // digits returned by mantissa; created on first use
+    mutable std::shared_ptr<const std::string> _mantissa;
 
     friend class Parser;
 
+    explicit Decimal(Kind kind, bool negative = false)
+      : _coefficient(0),
+        _scale(0),
+        _kind(kind),
+        _negative(negative)
+      { }
+
+    UnsignedLongType _getMagnitude(UnsignedLongType max, short exponent) const;
     LongType _getInteger(LongType min, LongType max, short exponent) const;
     UnsignedLongType _getUnsigned(UnsignedLongType max, short exponent) const;
 
@@ -68,7 +89,7 @@ private:
     }
 
     template <typename UnsignedType> UnsignedType _getUnsigned(short exponent) const
-      { return _getUnsigned(std::numeric_limits<UnsignedLongType>::max(), exponent); }
+      { return _getUnsigned(std::numeric_limits<UnsignedType>::max(), exponent); }
 
     void _getInteger(short& ret, short exponent) const              { ret = _getInteger<short>(exponent); }
     void _getInteger(int& ret, short exponent) const                { ret = _getInteger<int>(exponent); }
@@ -85,6 +106,16 @@ private:
 
     void _setInteger(LongType l, short exponent);
     void _setUnsigned(UnsignedLongType l, short exponent);
+    void _setDigits(const char* begin, const char* end, long scale, bool negative);
+    void _normalize(long scale);
+
+    // writes the digits of the coefficient to buf and returns the end
+    char* _formatCoefficient(char* buf) const;
+    std::string _coefficientDigits() const;
+    unsigned _numDigits() const;
+    int _compareMagnitude(const Decimal& other) const;
+
+    void parse(const char* begin, const char* end);
 
 public:
     class Parser;
@@ -102,34 +133,37 @@ public:
     explicit Decimal(long value, short exponent = 0)
     { _setInteger(value, exponent); }
     explicit Decimal(unsigned long value, short exponent = 0)
-    { _setInteger(value, exponent); }
+    { _setUnsigned(value, exponent); }
     explicit Decimal(long long value, short exponent = 0)
     { _setInteger(value, exponent); }
     explicit Decimal(unsigned long long value, short exponent = 0)
-    { _setInteger(value, exponent); }
+    { _setUnsigned(value, exponent); }
 
     explicit Decimal(float value);
     explicit Decimal(double value);
     explicit Decimal(long double value);
     explicit Decimal(const std::string& value);
+    Decimal(const char* begin, const char* end);
 
     static Decimal infinity()
-      { return Decimal(std::string(), std::numeric_limits<short>::max(), false); }
+      { return Decimal(infinite); }
 
     static Decimal nan()
-      { return Decimal(std::string(), 0, false); }
+      { return Decimal(notANumber); }
 
-    const std::string& mantissa() const
-      { return _mantissa; }
+    /// Returns the significant digits of the value.
+    ///
+    /// The value is 0.mantissa * 10^exponent. The reference is valid until
+    /// the value is modified or destroyed.
+    const std::string& mantissa() const;
 
-    short exponent() const
-      { return _exponent; }
+    short exponent() const;
 
     bool negative() const
       { return _negative; }
 
     bool isInfinity(bool positiveInfinity = true) const
-      { return _negative != positiveInfinity && _mantissa.empty() && _exponent == std::numeric_limits<short>::max(); }
+      { return _kind == infinite && _negative != positiveInfinity; }
 
     bool isPositiveInfinity() const
       { return isInfinity(true); }
@@ -138,10 +172,10 @@ public:
       { return isInfinity(false); }
 
     bool isNaN() const
-      { return _mantissa.empty() && _exponent == 0; }
+      { return _kind == notANumber; }
 
     bool isZero() const
-      { return _mantissa == "0"; }
+      { return _kind == finite && _coefficient == 0 && _digits.empty(); }
 
     long double getDouble() const;
 
@@ -167,10 +201,27 @@ public:
     std::string toStringFix() const;
 
     Decimal operator- () const
-      { return Decimal(_mantissa, _exponent, !_negative); }
+    {
+        Decimal ret(*this);
+        if (!isNaN() && !isZero())
+            ret._negative = !_negative;
+        return ret;
+    }
+
+    Decimal& operator+= (const Decimal& other);
+    Decimal& operator-= (const Decimal& other)
+      { return *this += -other; }
+    Decimal& operator*= (const Decimal& other);
 
     bool operator== (const Decimal& other) const
-      { return !isNaN() && _mantissa == other._mantissa && _exponent == other._exponent && _negative == other._negative; }
+    {
+        return !isNaN()
+            && _kind == other._kind
+            && _negative == other._negative
+            && _coefficient == other._coefficient
+            && _scale == other._scale
+            && _digits == other._digits;
+    }
 
     bool operator!= (const Decimal& other) const
       { return !(*this == other); }
@@ -187,6 +238,15 @@ public:
       { return !(other > *this); }
 };
 
+inline Decimal operator+ (Decimal a, const Decimal& b)
+  { return a += b; }
+
+inline Decimal operator- (Decimal a, const Decimal& b)
+  { return a -= b; }
+
+inline Decimal operator* (Decimal a, const Decimal& b)
+  { return a *= b; }
+
 std::istream& operator>> (std::istream& in, Decimal& dec);
 std::ostream& operator<< (std::ostream& out, const Decimal& dec);
 }
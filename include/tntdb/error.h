@@ -79,6 +79,13 @@ public:
     const std::string& getSql() const { return sql; }
 };
 
+/// Exception thrown when no connection of a connection pool gets available in time
+class PoolTimeout : public Error
+{
+public:
+    PoolTimeout();
+};
+
 class FieldNotFound : public Error
 {
     std::string field;
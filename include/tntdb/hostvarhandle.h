@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2005 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef TNTDB_HOSTVARHANDLE_H
+#define TNTDB_HOSTVARHANDLE_H
+
+#include <string>
+
+namespace tntdb
+{
+/** Handle to a host variable of a statement
+
+    A handle is returned by tntdb::Statement::hostvar. It keeps the position
+    of the host variable resolved by the driver, so that values can be bound
+    without looking up the name again:
+
+    @code
+      tntdb::Statement ins = conn.prepare("insert into t(id, name) values(:id, :name)");
+      tntdb::HostvarHandle id = ins.hostvar("id");
+      tntdb::HostvarHandle name = ins.hostvar("name");
+
+      for (unsigned n = 0; n < names.size(); ++n)
+        ins.set(id, n)
+           .set(name, names[n])
+           .execute();
+    @endcode
+
+    The handle is valid only for the statement it was created from.
+ */
+class HostvarHandle
+{
+    std::string _name;
+    unsigned _index;
+
+public:
+    static const unsigned invalidIndex = static_cast<unsigned>(-1);
+
+    /// Index of host variables, which are set by name, because the driver
+    /// does not resolve them to positions.
+    static const unsigned nameIndex = invalidIndex - 1;
+
+    HostvarHandle()
+      : _index(invalidIndex)
+      { }
+
+    HostvarHandle(const std::string& name, unsigned index)
+      : _name(name),
+        _index(index)
+      { }
+
+    /// Returns the name of the host variable.
+    const std::string& getName() const  { return _name; }
+
+    /// Returns the driver specific index of the host variable.
+    unsigned getIndex() const           { return _index; }
+
+    /// Returns true if the host variable was not found in the statement.
+    bool operator!() const              { return _index == invalidIndex; }
+};
+}
+
+#endif // TNTDB_HOSTVARHANDLE_H
@@ -38,6 +38,7 @@ class Result;
 class Row;
 class Value;
 class Statement;
+struct ConnectionMetrics;
 
 class IConnection
 {
@@ -62,6 +63,12 @@ public:
     virtual Statement prepare(const std::string& query) = 0;
     virtual Statement prepareWithLimit(const std::string& query, const std::string& limit, const std::string& offset) = 0;
     virtual bool ping() = 0;
+    /// Checks the state of the connection without a round trip to the
+    /// server. The default implementation can't tell and returns true.
+    virtual bool isAlive()  { return true; }
+    /// Adds the counters of the connection to metrics. The default
+    /// implementation does not count and returns false.
+    virtual bool getMetrics(ConnectionMetrics&)  { return false; }
     virtual long lastInsertId(const std::string& name) = 0;
     virtual void lockTable(const std::string& tablename, bool exclusive) = 0;
 
@@ -30,10 +30,16 @@
 #define TNTDB_IFACE_IROW_H
 
 #include <string>
+#include <stdint.h>
 
 namespace tntdb
 {
 class Value;
+class Date;
+class Time;
+class Datetime;
+class Decimal;
+class Blob;
 
 /// common interface for row-types
 class IRow
@@ -52,6 +58,42 @@ public:
     virtual Value getValueByNumber(size_type field_num) const = 0;
     virtual Value getValueByName(const std::string& field_name) const = 0;
     virtual std::string getColumnName(size_type field_num) const = 0;
+
+    /// Returns the number of the column with the passed name or throws
+    /// tntdb::FieldNotFound. The default implementation compares the
+    /// name with each column name.
+    virtual size_type getColumnIndex(const std::string& field_name) const;
+
+    //@{
+    /**
+     * Typed access to the values of the row.
+     *
+     * The default implementations fetch the value using getValueByNumber.
+     * Drivers override them to read the value directly without creating
+     * a value object on the heap.
+     */
+    virtual bool isNull(size_type field_num) const;
+    virtual bool getBool(size_type field_num) const;
+    virtual short getShort(size_type field_num) const;
+    virtual int getInt(size_type field_num) const;
+    virtual long getLong(size_type field_num) const;
+    virtual unsigned getUnsigned(size_type field_num) const;
+    virtual unsigned short getUnsignedShort(size_type field_num) const;
+    virtual unsigned long getUnsignedLong(size_type field_num) const;
+    virtual int32_t getInt32(size_type field_num) const;
+    virtual uint32_t getUnsigned32(size_type field_num) const;
+    virtual int64_t getInt64(size_type field_num) const;
+    virtual uint64_t getUnsigned64(size_type field_num) const;
+    virtual Decimal getDecimal(size_type field_num) const;
+    virtual float getFloat(size_type field_num) const;
+    virtual double getDouble(size_type field_num) const;
+    virtual char getChar(size_type field_num) const;
+    virtual void getString(size_type field_num, std::string& ret) const;
+    virtual void getBlob(size_type field_num, Blob& ret) const;
+    virtual Date getDate(size_type field_num) const;
+    virtual Time getTime(size_type field_num) const;
+    virtual Datetime getDatetime(size_type field_num) const;
+    //@}
 };
 }
 
@@ -29,9 +29,13 @@
 #ifndef TNTDB_IFACE_ISTATEMENT_H
 #define TNTDB_IFACE_ISTATEMENT_H
 
+#include <tntdb/hostvarhandle.h>
 #include <cxxtools/string.h>
 #include <string>
 #include <memory>
+#include <map>
+#include <vector>
+#include <typeindex>
 #include <stdint.h>
 
 namespace tntdb
@@ -51,6 +55,8 @@ class IStatement
     IStatement(const IStatement&) = delete;
     IStatement& operator=(const IStatement&) = delete;
 
+    std::map<std::type_index, std::vector<HostvarHandle> > _bindingHandles;
+
 protected:
     IStatement() = default;
     virtual ~IStatement() = default;
@@ -83,6 +89,33 @@ public:
     virtual void setDatetime(const std::string& col, const Datetime& data) = 0;
     virtual void setUString(const std::string& col, const cxxtools::String& data);
 
+    // Setting host variables by handle. The default implementation returns
+    // handles, which set the value by name, and throws FieldNotFound for
+    // invalid handles; drivers override them to bind the value by position.
+    virtual HostvarHandle hostvar(const std::string& col);
+    virtual void setNull(const HostvarHandle& hostvar);
+    virtual void setBool(const HostvarHandle& hostvar, bool data);
+    virtual void setShort(const HostvarHandle& hostvar, short data);
+    virtual void setInt(const HostvarHandle& hostvar, int data);
+    virtual void setLong(const HostvarHandle& hostvar, long data);
+    virtual void setUnsignedShort(const HostvarHandle& hostvar, unsigned short data);
+    virtual void setUnsigned(const HostvarHandle& hostvar, unsigned data);
+    virtual void setUnsignedLong(const HostvarHandle& hostvar, unsigned long data);
+    virtual void setInt32(const HostvarHandle& hostvar, int32_t data);
+    virtual void setUnsigned32(const HostvarHandle& hostvar, uint32_t data);
+    virtual void setInt64(const HostvarHandle& hostvar, int64_t data);
+    virtual void setUnsigned64(const HostvarHandle& hostvar, uint64_t data);
+    virtual void setDecimal(const HostvarHandle& hostvar, const Decimal& data);
+    virtual void setFloat(const HostvarHandle& hostvar, float data);
+    virtual void setDouble(const HostvarHandle& hostvar, double data);
+    virtual void setChar(const HostvarHandle& hostvar, char data);
+    virtual void setString(const HostvarHandle& hostvar, const std::string& data);
+    virtual void setBlob(const HostvarHandle& hostvar, const Blob& data);
+    virtual void setDate(const HostvarHandle& hostvar, const Date& data);
+    virtual void setTime(const HostvarHandle& hostvar, const Time& data);
+    virtual void setDatetime(const HostvarHandle& hostvar, const Datetime& data);
+    virtual void setUString(const HostvarHandle& hostvar, const cxxtools::String& data);
+
     virtual size_type execute() = 0;
     virtual Result select() = 0;
     virtual Row selectRow() = 0;
@@ -92,6 +125,15 @@ public:
     virtual void maxNumDelay(size_type n);
     virtual size_type numDelayed() const;
     virtual size_type flush();
+
+    virtual void binaryParams(bool enable);
+    virtual void binaryResults(bool enable);
+    virtual void streamingCursor(bool enable);
+
+    // Handles of the host variables of a tntdb::Binding. They are resolved
+    // when the first object of the type is set and reused afterwards.
+    std::vector<HostvarHandle>& bindingHandles(const std::type_index& type)
+      { return _bindingHandles[type]; }
 };
 }
 
@@ -32,6 +32,7 @@
 #include <cxxtools/refcounted.h>
 #include <cxxtools/string.h>
 #include <string>
+#include <cstddef>
 #include <stdint.h>
 
 namespace tntdb
@@ -75,6 +76,17 @@ public:
     virtual Time getTime() const = 0;
     virtual Datetime getDatetime() const = 0;
     virtual void getUString(cxxtools::String& ret) const;
+
+    /// Sets data and length to the text of the value without copying it
+    /// and returns true. Drivers, which hold the value as text, return a
+    /// pointer into their buffer, which is valid as long as the row or
+    /// result the value was fetched from. Returns false, when the value
+    /// needs a conversion; the caller uses getString then. The default
+    /// implementation returns false.
+    virtual bool getStringView(const char*& data, std::size_t& length) const;
+    /// Like getStringView, but for binary data. The caller uses getBlob,
+    /// when it returns false.
+    virtual bool getBlobView(const char*& data, std::size_t& length) const;
 };
 }
 
@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2005 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef TNTDB_IMPL_COLUMNINDEX_H
+#define TNTDB_IMPL_COLUMNINDEX_H
+
+#include <string>
+#include <unordered_map>
+
+namespace tntdb
+{
+/// Maps column names to column numbers.
+///
+/// The index is built once per result set or cursor and shared by all
+/// its rows, so looking up a column by name does not need to compare the
+/// name with each column name.
+class ColumnIndex
+{
+public:
+    typedef unsigned size_type;
+
+private:
+    typedef std::unordered_map<std::string, size_type> IndexType;
+    IndexType _index;
+
+public:
+    /// Adds a column. When a name occurs more than once, the first column
+    /// is found.
+    void add(const std::string& name, size_type field_num)
+        { _index.insert(IndexType::value_type(name, field_num)); }
+
+    void reserve(size_type count)       { _index.reserve(count); }
+    bool empty() const                  { return _index.empty(); }
+    void clear()                        { _index.clear(); }
+
+    /// Returns the number of the column with the passed name.
+    /// Throws tntdb::FieldNotFound, when there is no such column.
+    size_type get(const std::string& name) const;
+};
+}
+
+#endif // TNTDB_IMPL_COLUMNINDEX_H
@@ -41,6 +41,7 @@ class PoolConnection : public IConnection
     std::shared_ptr<IConnection> _connection;
     bool _inTransaction;
     bool _drop;
+    ConnectionPool::Clock::time_point _checkoutTime;
 
 public:
     explicit PoolConnection(std::shared_ptr<IConnection>&& connection, ConnectionPool& connectionPool);
@@ -57,6 +58,8 @@ public:
     virtual Statement prepare(const std::string& query);
     virtual Statement prepareWithLimit(const std::string& query, const std::string& limit, const std::string& offset);
     virtual bool ping();
+    virtual bool isAlive();
+    virtual bool getMetrics(ConnectionMetrics& metrics);
     virtual long lastInsertId(const std::string& name);
     virtual void lockTable(const std::string& tablename, bool exclusive);
 };
@@ -30,36 +30,113 @@
 #define TNTDB_IMPL_RESULT_H
 
 #include <tntdb/iface/iresult.h>
+#include <tntdb/impl/columnindex.h>
 #include <tntdb/result.h>
+#include <string>
 #include <vector>
+#include <memory>
+#include <cstring>
+#include <stdint.h>
 
 namespace tntdb
 {
-class ResultImpl : public IResult
+/// Generic result set, which is filled by the driver cell by cell.
+///
+/// The column names are stored once per result. The cells are typed and
+/// stored in one vector; text and binary data is copied into a buffer,
+/// which is shared by all cells. Rows and values are just views into the
+/// result.
+class ResultImpl : public IResult, public std::enable_shared_from_this<ResultImpl>
 {
 public:
-    typedef std::vector<Row> data_type;
+    enum CellType
+    {
+        nullCell,
+        integerCell,
+        doubleCell,
+        textCell,
+        // floating point value with the text returned by the database; the
+        // value is stored in the data buffer in front of the text
+        realCell
+    };
+
+    struct Cell
+    {
+        union
+        {
+            int64_t integer;
+            double dbl;
+            std::size_t offset;
+        };
+        uint32_t length;
+        unsigned char type;
+    };
 
 private:
-    data_type data;
+    std::vector<std::string> columnNames;
+    ColumnIndex columnIndex;
+    std::vector<Cell> cells;
+    std::vector<char> data;
+
+    Cell& newCell(CellType type)
+    {
+        cells.push_back(Cell());
+        Cell& cell = cells.back();
+        cell.type = type;
+        cell.length = 0;
+        return cell;
+    }
 
 public:
     ResultImpl()
     { }
 
-    explicit ResultImpl(const data_type& data_)
-      : data(data_)
-    { }
-
     // methods from IResult
     virtual Row getRow(size_type tup_num) const;
     virtual size_type size() const;
     virtual size_type getFieldCount() const;
 
     // specific methods
-    void add(const Row& row)   { data.push_back(row); }
+
+    /// Adds a column. All columns must be added before the first cell.
+    void addColumn(const std::string& name)
+    {
+        columnIndex.add(name, columnNames.size());
+        columnNames.push_back(name);
+    }
+
+    // Add the next cell. The cells are added row by row.
+    void addNull()                            { newCell(nullCell); }
+    void addInteger(int64_t value)            { newCell(integerCell).integer = value; }
+    void addDouble(double value)              { newCell(doubleCell).dbl = value; }
+    void addText(const char* value, std::size_t length);
+    void addReal(double value, const char* text, std::size_t length);
+
+    void reserve(size_type rows)              { cells.reserve(rows * columnNames.size()); }
+
+    const std::string& getColumnName(size_type field_num) const
+        { return columnNames[field_num]; }
+
+    /// Returns the index of the column or throws FieldNotFound.
+    size_type getColumnIndex(const std::string& name) const
+        { return columnIndex.get(name); }
+
+    const Cell& getCell(size_type idx) const  { return cells[idx]; }
+    const char* getText(const Cell& cell) const
+    {
+        if (data.empty())
+            return "";
+        const char* p = data.data() + cell.offset;
+        return cell.type == realCell ? p + sizeof(double) : p;
+    }
+
+    double getReal(const Cell& cell) const
+    {
+        double ret;
+        std::memcpy(&ret, data.data() + cell.offset, sizeof(ret));
+        return ret;
+    }
 };
 }
 
 #endif // TNTDB_IMPL_RESULT_H
-
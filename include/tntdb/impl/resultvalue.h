@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2005 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef TNTDB_IMPL_RESULTVALUE_H
+#define TNTDB_IMPL_RESULTVALUE_H
+
+#include <tntdb/iface/ivalue.h>
+#include <tntdb/impl/result.h>
+#include <memory>
+
+namespace tntdb
+{
+/// Value of a ResultImpl.
+class ResultValueImpl : public IValue
+{
+    std::shared_ptr<const ResultImpl> _resultref;
+    const ResultImpl& _result;
+    const ResultImpl::Cell& _cell;
+
+    const char* getText() const   { return _result.getText(_cell); }
+    double getDbl() const
+        { return _cell.type == ResultImpl::doubleCell ? _cell.dbl : _result.getReal(_cell); }
+
+    // Writes the text representation of the value into buf, which must
+    // hold at least textconv::maxFloatLength characters, unless the cell
+    // holds text. Returns the begin and sets end.
+    const char* toText(char* buf, const char*& end) const;
+
+    template <typename T>
+    T getInteger(const char* tname) const;
+
+    template <typename T>
+    T getFloat(const char* tname) const;
+
+public:
+    ResultValueImpl(const std::shared_ptr<const ResultImpl>& result, IResult::size_type idx)
+      : _resultref(result),
+        _result(*result),
+        _cell(result->getCell(idx))
+      { }
+
+    /// Creates a value, which does not keep a reference to the result.
+    ResultValueImpl(const ResultImpl& result, IResult::size_type idx)
+      : _result(result),
+        _cell(result.getCell(idx))
+      { }
+
+    virtual bool isNull() const;
+    virtual bool getBool() const;
+    virtual short getShort() const;
+    virtual int getInt() const;
+    virtual long getLong() const;
+    virtual unsigned short getUnsignedShort() const;
+    virtual unsigned getUnsigned() const;
+    virtual unsigned long getUnsignedLong() const;
+    virtual int32_t getInt32() const;
+    virtual uint32_t getUnsigned32() const;
+    virtual int64_t getInt64() const;
+    virtual uint64_t getUnsigned64() const;
+    virtual Decimal getDecimal() const;
+    virtual float getFloat() const;
+    virtual double getDouble() const;
+    virtual char getChar() const;
+    virtual void getString(std::string& ret) const;
+    virtual void getBlob(Blob& ret) const;
+    virtual bool getStringView(const char*& data, std::size_t& length) const;
+    virtual bool getBlobView(const char*& data, std::size_t& length) const;
+    virtual Date getDate() const;
+    virtual Time getTime() const;
+    virtual Datetime getDatetime() const;
+};
+}
+
+#endif // TNTDB_IMPL_RESULTVALUE_H
@@ -30,49 +30,56 @@
 #define TNTDB_IMPL_ROW_H
 
 #include <tntdb/iface/irow.h>
-#include <tntdb/value.h>
-#include <vector>
+#include <memory>
 
 namespace tntdb
 {
+class ResultImpl;
+
+/// Row of a ResultImpl.
 class RowImpl : public IRow
 {
-public:
-    struct ValueType
-    {
-      std::string name;
-      Value value;
-
-      ValueType()  { }
-      ValueType(const std::string& name_, const Value& value_)
-        : name(name_),
-          value(value_)
-          { }
-    };
-
-    typedef std::vector<ValueType> data_type;
+    std::shared_ptr<const ResultImpl> _result;
+    size_type _tupNum;
 
-private:
-    data_type data;
+    // Returns the index of the cell in the result.
+    size_type cellIndex(size_type field_num) const;
 
 public:
-    RowImpl()
+    RowImpl(const std::shared_ptr<const ResultImpl>& result, size_type tupNum)
+      : _result(result),
+        _tupNum(tupNum)
       { }
 
-    explicit RowImpl(const data_type& data_)
-      : data(data_)
-      { }
-
-    // methods from IResult
+    // methods from IRow
     virtual size_type size() const;
     virtual Value getValueByNumber(size_type field_num) const;
     virtual Value getValueByName(const std::string& field_name) const;
     virtual std::string getColumnName(size_type field_num) const;
+    virtual size_type getColumnIndex(const std::string& field_name) const;
 
-    // specific methods
-    void add(const std::string& field_name, const Value& value)   { data.push_back(ValueType(field_name, value)); }
+    virtual bool isNull(size_type field_num) const;
+    virtual bool getBool(size_type field_num) const;
+    virtual short getShort(size_type field_num) const;
+    virtual int getInt(size_type field_num) const;
+    virtual long getLong(size_type field_num) const;
+    virtual unsigned getUnsigned(size_type field_num) const;
+    virtual unsigned short getUnsignedShort(size_type field_num) const;
+    virtual unsigned long getUnsignedLong(size_type field_num) const;
+    virtual int32_t getInt32(size_type field_num) const;
+    virtual uint32_t getUnsigned32(size_type field_num) const;
+    virtual int64_t getInt64(size_type field_num) const;
+    virtual uint64_t getUnsigned64(size_type field_num) const;
+    virtual Decimal getDecimal(size_type field_num) const;
+    virtual float getFloat(size_type field_num) const;
+    virtual double getDouble(size_type field_num) const;
+    virtual char getChar(size_type field_num) const;
+    virtual void getString(size_type field_num, std::string& ret) const;
+    virtual void getBlob(size_type field_num, Blob& ret) const;
+    virtual Date getDate(size_type field_num) const;
+    virtual Time getTime(size_type field_num) const;
+    virtual Datetime getDatetime(size_type field_num) const;
 };
 }
 
 #endif // TNTDB_IMPL_ROW_H
-
@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2005 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef TNTDB_IMPL_TEXTCONV_H
+#define TNTDB_IMPL_TEXTCONV_H
+
+#include <string>
+
+namespace tntdb
+{
+class Date;
+class Time;
+class Datetime;
+
+/// Conversion between text representations and values.
+///
+/// The functions work on character ranges and do not allocate memory.
+/// Parse functions return false or a null pointer when the text is not
+/// valid; it is up to the caller to report the error.
+namespace textconv
+{
+    /// Maximum number of characters needed for a formatted integer.
+    static const unsigned maxIntegerLength = 24;
+    /// Maximum number of characters needed for a formatted floating point value.
+    static const unsigned maxFloatLength = 32;
+
+    // Parses a number. Leading and trailing white space and a leading '+'
+    // are accepted. Values out of range are rejected.
+    bool parse(const char* begin, const char* end, short& ret);
+    bool parse(const char* begin, const char* end, int& ret);
+    bool parse(const char* begin, const char* end, long& ret);
+    bool parse(const char* begin, const char* end, long long& ret);
+    bool parse(const char* begin, const char* end, unsigned short& ret);
+    bool parse(const char* begin, const char* end, unsigned& ret);
+    bool parse(const char* begin, const char* end, unsigned long& ret);
+    bool parse(const char* begin, const char* end, unsigned long long& ret);
+    bool parse(const char* begin, const char* end, float& ret);
+    bool parse(const char* begin, const char* end, double& ret);
+
+    // Formats a number into the buffer, which must be large enough, and
+    // returns the end of the formatted text. Floating point values are
+    // formatted with the shortest representation, which reads back to the
+    // same value.
+    char* format(char* buf, long long value);
+    char* format(char* buf, unsigned long long value);
+    char* format(char* buf, float value);
+    char* format(char* buf, double value);
+
+    inline char* format(char* buf, short value)           { return format(buf, static_cast<long long>(value)); }
+    inline char* format(char* buf, int value)             { return format(buf, static_cast<long long>(value)); }
+    inline char* format(char* buf, long value)            { return format(buf, static_cast<long long>(value)); }
+    inline char* format(char* buf, unsigned short value)  { return format(buf, static_cast<unsigned long long>(value)); }
+    inline char* format(char* buf, unsigned value)        { return format(buf, static_cast<unsigned long long>(value)); }
+    inline char* format(char* buf, unsigned long value)   { return format(buf, static_cast<unsigned long long>(value)); }
+
+    /// Appends the formatted number to the string.
+    template <typename T>
+    void append(std::string& s, T value)
+    {
+        char buf[maxFloatLength];
+        s.append(buf, format(buf, value));
+    }
+
+    template <typename T>
+    std::string toString(T value)
+    {
+        char buf[maxFloatLength];
+        return std::string(buf, format(buf, value));
+    }
+
+    // Scans a unsigned number with at most 4 digits. Returns the position
+    // after the number or 0 if there is no number.
+    const char* scanNumber(const char* begin, const char* end, unsigned short& ret);
+
+    // Scan ISO 8601 values and return the position after the scanned text
+    // or 0 if the text does not start with a valid value.
+    //
+    // Dates are in the form YYYY-MM-DD, times in the form hh:mm:ss with an
+    // optional fraction of any length, which is rounded to milliseconds.
+    // Date and time of a timestamp are separated by a space or a 'T'.
+    const char* scanIsoDate(const char* begin, const char* end, Date& ret);
+    const char* scanIsoTime(const char* begin, const char* end, Time& ret);
+    const char* scanIsoDatetime(const char* begin, const char* end, Datetime& ret);
+
+    // Format values in the format of getIso and return the end of the
+    // formatted text. The buffer needs 10, 12 and 23 characters.
+    char* formatIso(char* buf, const Date& value);
+    char* formatIso(char* buf, const Time& value);
+    char* formatIso(char* buf, const Datetime& value);
+}
+}
+
+#endif // TNTDB_IMPL_TEXTCONV_H
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2005 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef TNTDB_METRICS_H
+#define TNTDB_METRICS_H
+
+#include <atomic>
+#include <chrono>
+
+namespace tntdb
+{
+/** Distribution of durations
+
+    The durations are counted in buckets of powers of two microseconds.
+    Bucket 0 counts durations below 1µs and bucket n durations from
+    2^(n-1)µs to below 2^nµs. The last bucket counts all longer durations.
+    Adding durations is thread safe and does not lock.
+ */
+class LatencyHistogram
+{
+public:
+    static const unsigned numBuckets = 32;
+
+private:
+    std::atomic<unsigned long> _buckets[numBuckets];
+    std::atomic<unsigned long long> _sum;
+
+public:
+    LatencyHistogram();
+    LatencyHistogram(const LatencyHistogram& other);
+    LatencyHistogram& operator=(const LatencyHistogram& other);
+
+    void add(std::chrono::microseconds duration);
+
+    template <typename Rep, typename Period>
+    void add(std::chrono::duration<Rep, Period> duration)
+      { add(std::chrono::duration_cast<std::chrono::microseconds>(duration)); }
+
+    /// Returns the number of durations in the bucket.
+    unsigned long count(unsigned bucket) const  { return _buckets[bucket]; }
+    /// Returns the number of durations.
+    unsigned long count() const;
+    /// Returns the sum of all durations.
+    std::chrono::microseconds sum() const       { return std::chrono::microseconds(_sum); }
+    /// Returns the average duration.
+    std::chrono::microseconds average() const;
+
+    /// Returns the upper bound of the bucket; the last bucket has none and
+    /// returns std::chrono::microseconds::max().
+    static std::chrono::microseconds upperBound(unsigned bucket);
+
+    /// Returns the upper bound of the bucket, which contains the given
+    /// quantile, e.g. 0.99 for the 99th percentile.
+    std::chrono::microseconds quantile(double q) const;
+};
+
+/// Snapshot of the counters of a connection pool.
+struct PoolMetrics
+{
+    unsigned idle;                  ///< idle connections in the pool
+    unsigned inUse;                 ///< connections checked out
+    unsigned open;                  ///< all open connections including the ones kept in thread caches
+    unsigned waiting;               ///< threads currently waiting for a connection
+
+    unsigned long checkouts;        ///< connections handed out by connect
+    unsigned long creations;        ///< connections opened
+    unsigned long creationFailures; ///< failed attempts to open a connection
+    unsigned long pings;            ///< validations of idle connections with ping or isAlive
+    unsigned long failedPings;      ///< validations, which found a dead connection
+    unsigned long drops;            ///< connections not reused after a rollback or with an open transaction
+    unsigned long waits;            ///< calls to connect, which had to wait for a connection
+    unsigned long timeouts;         ///< calls to connect, which timed out
+
+    LatencyHistogram waitTime;      ///< time spent in connect
+    LatencyHistogram holdTime;      ///< time from checkout to release
+
+    PoolMetrics()
+      : idle(0), inUse(0), open(0), waiting(0),
+        checkouts(0), creations(0), creationFailures(0), pings(0),
+        failedPings(0), drops(0), waits(0), timeouts(0)
+      { }
+};
+
+/** Counters of a database connection
+
+    The counters are maintained by the postgresql and mysql drivers. The
+    replication driver adds up the counters of its connections. The other
+    drivers do not count and return false in Connection::getMetrics.
+ */
+struct ConnectionMetrics
+{
+    unsigned long long roundTrips;      ///< requests sent to the server, which waited for a reply
+    unsigned long long bytesSent;       ///< bytes of sql and parameters sent
+    unsigned long long bytesReceived;   ///< bytes of result values received
+    unsigned long long rowsFetched;     ///< rows received
+
+    ConnectionMetrics()
+      : roundTrips(0), bytesSent(0), bytesReceived(0), rowsFetched(0)
+      { }
+};
+}
+
+#endif // TNTDB_METRICS_H
@@ -85,10 +85,20 @@ namespace mysql
     char           getChar(const MYSQL_BIND& value);
     void           getString(const MYSQL_BIND& value, std::string& ret);
     void           getBlob(const MYSQL_BIND& value, Blob& ret);
+    // sets data and length to the buffer of string, blob and decimal values;
+    // returns false for other types, which need a conversion
+    bool           getStringData(const MYSQL_BIND& value, const char*& data, std::size_t& length);
+    // like getStringData, but for string and blob values only
+    bool           getBlobData(const MYSQL_BIND& value, const char*& data, std::size_t& length);
+    // returns the size of the value in the buffer; 0 for null values
+    std::size_t    getLength(const MYSQL_BIND& value);
     Date           getDate(const MYSQL_BIND& value);
     Time           getTime(const MYSQL_BIND& value);
     Datetime       getDatetime(const MYSQL_BIND& value);
 
+    // appends the value as a sql literal, escaped for the connection
+    void appendLiteral(MYSQL* mysql, const MYSQL_BIND& value, std::string& sql);
+
     void transferValue(MYSQL_BIND& fromValue, MYSQL_BIND& toValue,
                        bool doRelease = true);
     void copyValue(const MYSQL_BIND& fromValue, MYSQL_BIND& toValue,
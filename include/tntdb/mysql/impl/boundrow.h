@@ -31,6 +31,7 @@
 
 #include <tntdb/iface/irow.h>
 #include <tntdb/mysql/bindvalues.h>
+#include <tntdb/impl/columnindex.h>
 
 namespace tntdb
 {
@@ -38,6 +39,10 @@ namespace mysql
 {
 class BoundRow : public IRow, public BindValues
 {
+    // built on first lookup by name; the names do not change after the
+    // output buffers are initialized
+    mutable ColumnIndex _columnIndex;
+
 public:
     explicit BoundRow(unsigned n)
       : BindValues(n)
@@ -47,6 +52,29 @@ public:
     Value getValueByNumber(size_type field_num) const;
     Value getValueByName(const std::string& field_name) const;
     std::string getColumnName(size_type field_num) const;
+    size_type getColumnIndex(const std::string& field_name) const;
+
+    bool isNull(size_type field_num) const;
+    bool getBool(size_type field_num) const;
+    short getShort(size_type field_num) const;
+    int getInt(size_type field_num) const;
+    long getLong(size_type field_num) const;
+    unsigned getUnsigned(size_type field_num) const;
+    unsigned short getUnsignedShort(size_type field_num) const;
+    unsigned long getUnsignedLong(size_type field_num) const;
+    int32_t getInt32(size_type field_num) const;
+    uint32_t getUnsigned32(size_type field_num) const;
+    int64_t getInt64(size_type field_num) const;
+    uint64_t getUnsigned64(size_type field_num) const;
+    Decimal getDecimal(size_type field_num) const;
+    float getFloat(size_type field_num) const;
+    double getDouble(size_type field_num) const;
+    char getChar(size_type field_num) const;
+    void getString(size_type field_num, std::string& ret) const;
+    void getBlob(size_type field_num, Blob& ret) const;
+    Date getDate(size_type field_num) const;
+    Time getTime(size_type field_num) const;
+    Datetime getDatetime(size_type field_num) const;
 };
 }
 }
@@ -78,6 +78,8 @@ public:
     virtual char getChar() const;
     virtual void getString(std::string& ret) const;
     virtual void getBlob(Blob& ret) const;
+    virtual bool getStringView(const char*& data, std::size_t& length) const;
+    virtual bool getBlobView(const char*& data, std::size_t& length) const;
     virtual Date getDate() const;
     virtual Time getTime() const;
     virtual Datetime getDatetime() const;
@@ -30,10 +30,16 @@
 #define TNTDB_MYSQL_IMPL_CONNECTION_H
 
 #include <tntdb/iface/iconnection.h>
+#include <tntdb/metrics.h>
 #include <mysql.h>
+#include <string>
+#include <vector>
+#include <memory>
 
 namespace tntdb
 {
+class ICursor;
+
 /**
 
  This namespace contains the implementation of the Mysql driver for tntdb.
@@ -63,6 +69,7 @@ namespace tntdb
 namespace mysql
 {
 class Result;
+class Statement;
 
 /// Implements a connection to a Mysql database.
 class Connection : public IConnection
@@ -72,6 +79,15 @@ class Connection : public IConnection
     unsigned transactionActive;
     std::string lockTablesQuery;
 
+    // statements delayed by Statement::execute; see flushDelayed
+    std::string delayedQuery;
+    const Statement* delayedInsert;
+    // the statement of each delayed query or 0, when it was destroyed
+    std::vector<Statement*> delayedStatements;
+
+    ConnectionMetrics metrics;
+
+    void clearDelayed();
     void open(const char* app, const char* host,
       const char* user, const char* passwd,
       const char* db, unsigned int port,
@@ -96,11 +112,56 @@ public:
     tntdb::Result select(const std::string& query);
     tntdb::Row selectRow(const std::string& query);
     tntdb::Value selectValue(const std::string& query);
+    /// Creates a cursor, which streams the rows of the query from the
+    /// server without storing the whole result in memory.
+    std::shared_ptr<ICursor> createCursor(const std::string& query);
     tntdb::Statement prepare(const std::string& query);
     tntdb::Statement prepareWithLimit(const std::string& query, const std::string& limit, const std::string& offset);
     bool ping();
+    bool getMetrics(ConnectionMetrics& m);
     long lastInsertId(const std::string& name);
     void lockTable(const std::string& tablename, bool exclusive);
+
+    bool inTransaction() const  { return transactionActive > 0; }
+
+    /// Counts a request sent to the server, which is answered by the server.
+    void countRoundTrip(std::size_t bytesSent)
+    {
+        ++metrics.roundTrips;
+        metrics.bytesSent += bytesSent;
+    }
+
+    /// Counts a row received with the size of its values.
+    void countRow(std::size_t bytesReceived)
+    {
+        ++metrics.rowsFetched;
+        metrics.bytesReceived += bytesReceived;
+    }
+
+    /// Counts a row received into bound values.
+    void countRow(const MYSQL_BIND* values, unsigned count);
+
+    /// Counts the row of the result, which was fetched last.
+    void countRow(MYSQL_RES* result);
+
+    /// Counts the rows and the size of the values of a stored result.
+    void countResult(MYSQL_RES* result);
+
+    /// Adds the statement with its current parameters to the delay buffer.
+    ///
+    /// Consecutive executes of the same single row insert are combined into
+    /// one multi row insert.
+    void delayExecute(Statement* stmt);
+    /// Returns true if the delay buffer should be flushed to keep the
+    /// packet size small.
+    bool delayBufferFull() const;
+    /// Sends all delayed statements in one round trip to the server.
+    /// The affected rows of each query are passed to its statement.
+    /// Returns the total number of affected rows.
+    size_type flushDelayed();
+    /// Removes references to a destroyed statement.
+    /// Its pending queries are kept and executed on the next flush.
+    void releaseDelayed(Statement* stmt);
 };
 }
 }
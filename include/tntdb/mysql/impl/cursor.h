@@ -38,13 +38,18 @@ namespace tntdb
 namespace mysql
 {
 class BoundRow;
+class Connection;
 class Statement;
+class StmtPool;
 
 class Cursor : public ICursor
 {
+    Connection& _conn;
     std::shared_ptr<BoundRow> _row;
     MYSQL_FIELD* _fields;
     MYSQL_STMT* _stmt;
+    // the handle is borrowed from the statement and given back here
+    std::shared_ptr<StmtPool> _pool;
 
 public:
     Cursor(Statement& statement, unsigned fetchsize);
@@ -30,8 +30,11 @@
 #define TNTDB_MYSQL_IMPL_RESULT_H
 
 #include <tntdb/iface/iresult.h>
+#include <tntdb/impl/columnindex.h>
 #include <mysql.h>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 namespace tntdb
 {
@@ -44,12 +47,29 @@ class Result : public IResult
     MYSQL_RES* result;
     size_type field_count;
 
+    // Position of the row, which mysql_fetch_row returns next. Sequential
+    // access does not need to seek.
+    mutable size_type nextRow;
+    // Offsets of all rows for random access. mysql_data_seek walks the
+    // row list from the start, so we build the index once instead.
+    mutable std::vector<MYSQL_ROW_OFFSET> rowOffsets;
+
+    // Built on the first lookup of a column by name.
+    mutable std::once_flag columnIndexFlag;
+    mutable ColumnIndex columnIndex;
+
+    MYSQL_ROW fetchRow(size_type tup_num) const;
+
 public:
     Result(MYSQL* m, MYSQL_RES* r);
     ~Result();
 
     MYSQL_RES* getMysqlRes() const  { return result; }
+    /// Returns a row, which does not keep a reference to the result.
     std::shared_ptr<ResultRow> getMysqlRow(size_type tup_num) const;
+    /// Returns a row, which keeps the result alive.
+    static std::shared_ptr<ResultRow> getMysqlRow(const std::shared_ptr<Result>& resultref, size_type tup_num);
+    const ColumnIndex& getColumnIndex() const;
 
     Row getRow(size_type tup_num) const;
     size_type size() const;
@@ -26,30 +26,41 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
-#ifndef TNTDB_MYSQL_IMPL_ROWCONTAINER_H
-#define TNTDB_MYSQL_IMPL_ROWCONTAINER_H
+#ifndef TNTDB_MYSQL_IMPL_RESULTCURSOR_H
+#define TNTDB_MYSQL_IMPL_RESULTCURSOR_H
 
-#include <tntdb/iface/iresult.h>
-#include <tntdb/iface/irow.h>
-#include <vector>
+#include <tntdb/iface/icursor.h>
+#include <mysql.h>
+#include <string>
 #include <memory>
 
 namespace tntdb
 {
 namespace mysql
 {
-class RowContainer : public IResult
+class Connection;
+class Result;
+
+/// Cursor for queries without parameters.
+///
+/// The rows are read from the server using mysql_use_result, so they are
+/// not stored in client memory. Like all unbuffered results the connection
+/// can't be used for other queries until all rows are fetched or the cursor
+/// is destroyed.
+class ResultCursor : public ICursor
 {
-    std::vector<std::shared_ptr<IRow>> rows;
+    Connection& _conn;
+    MYSQL* _mysql;
+    std::shared_ptr<Result> _result;
+    unsigned _fieldCount;
 
 public:
-    void addRow(std::shared_ptr<IRow> row)  { rows.emplace_back(row); }
+    ResultCursor(Connection& conn, const std::string& query);
 
-    Row getRow(size_type tup_num) const;
-    size_type size() const;
-    size_type getFieldCount() const;
+    // method for ICursor
+    Row fetch();
 };
 }
 }
 
-#endif // TNTDB_MYSQL_IMPL_ROWCONTAINER_H
+#endif // TNTDB_MYSQL_IMPL_RESULTCURSOR_H
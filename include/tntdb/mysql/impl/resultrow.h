@@ -32,6 +32,7 @@
 #include <tntdb/bits/result.h>
 #include <tntdb/iface/irow.h>
 #include <mysql.h>
+#include <vector>
 
 namespace tntdb
 {
@@ -44,14 +45,17 @@ class RowValue;
 class ResultRow : public IRow
 {
     std::shared_ptr<Result> _resultref;
+    const Result& _result;
     MYSQL_ROW _row;
     unsigned _field_count;
-    unsigned long* _lengths;
+    // mysql_fetch_lengths returns a buffer, which is overwritten by the
+    // next fetch, so we keep a copy
+    std::vector<unsigned long> _lengths;
     MYSQL_FIELD* _fields;
 
 public:
     ResultRow(std::shared_ptr<Result> resultref, MYSQL_ROW row, unsigned field_count);
-    ResultRow(MYSQL_RES* res, MYSQL_ROW row, unsigned field_count);
+    ResultRow(const Result& result, MYSQL_ROW row, unsigned field_count);
 
     static std::shared_ptr<RowValue> getMysqlValue(std::shared_ptr<ResultRow> result, size_type field_num);
 
@@ -59,6 +63,29 @@ public:
     Value getValueByNumber(size_type field_num) const;
     Value getValueByName(const std::string& field_name) const;
     std::string getColumnName(size_type field_num) const;
+    size_type getColumnIndex(const std::string& field_name) const;
+
+    bool isNull(size_type field_num) const;
+    bool getBool(size_type field_num) const;
+    short getShort(size_type field_num) const;
+    int getInt(size_type field_num) const;
+    long getLong(size_type field_num) const;
+    unsigned getUnsigned(size_type field_num) const;
+    unsigned short getUnsignedShort(size_type field_num) const;
+    unsigned long getUnsignedLong(size_type field_num) const;
+    int32_t getInt32(size_type field_num) const;
+    uint32_t getUnsigned32(size_type field_num) const;
+    int64_t getInt64(size_type field_num) const;
+    uint64_t getUnsigned64(size_type field_num) const;
+    Decimal getDecimal(size_type field_num) const;
+    float getFloat(size_type field_num) const;
+    double getDouble(size_type field_num) const;
+    char getChar(size_type field_num) const;
+    void getString(size_type field_num, std::string& ret) const;
+    void getBlob(size_type field_num, Blob& ret) const;
+    Date getDate(size_type field_num) const;
+    Time getTime(size_type field_num) const;
+    Datetime getDatetime(size_type field_num) const;
 };
 }
 }
@@ -36,11 +36,37 @@
 #include <tntdb/mysql/impl/connection.h>
 #include <map>
 #include <memory>
+#include <vector>
 
 namespace tntdb
 {
 namespace mysql
 {
+/// Prepared statement handles of a statement, which are currently unused.
+///
+/// Cursors borrow a handle and give it back when they are destroyed. The
+/// pool is shared with the cursors, so that a cursor may outlive its
+/// statement.
+class StmtPool
+{
+    std::vector<MYSQL_STMT*> stmts;
+
+    StmtPool(const StmtPool&) = delete;
+    StmtPool& operator=(const StmtPool&) = delete;
+
+public:
+    // maximum number of unused handles kept open
+    static const unsigned maxSize = 4;
+
+    StmtPool()  { }
+    ~StmtPool();
+
+    // returns a prepared handle or 0 if the pool is empty
+    MYSQL_STMT* get();
+    // puts a handle back or closes it when the pool is full
+    void put(MYSQL_STMT* stmt);
+};
+
 class Statement : public IStatement
 {
     typedef std::multimap<std::string, unsigned> hostvarMapType;
@@ -51,10 +77,25 @@ class Statement : public IStatement
     hostvarMapType hostvarMap;
     MYSQL* mysql;
     MYSQL_STMT* stmt;
+    std::shared_ptr<StmtPool> stmtPool;
     MYSQL_FIELD* fields;
     unsigned field_count;
     std::shared_ptr<BoundRow> rowPtr;
 
+    // next position of a host variable with the same name or
+    // HostvarHandle::invalidIndex
+    std::vector<unsigned> nextHostvar;
+    // positions of the parameter markers in query
+    std::vector<std::string::size_type> hostvarPos;
+    // position of the value tuple when query is a single row insert
+    std::string::size_type valuesPos;
+    // end of query without a trailing semicolon and comments or npos, when
+    // the query can't be delayed
+    std::string::size_type queryEnd;
+    unsigned maxDelay;
+    unsigned delayed;
+    size_type delayedAffected;
+
     std::shared_ptr<BoundRow> getRow();
     std::shared_ptr<BoundRow> fetchRow();
     std::shared_ptr<BoundRow> selectBoundRow();
@@ -89,22 +130,64 @@ public:
     void setTime(const std::string& col, const Time& data);
     void setDatetime(const std::string& col, const Datetime& data);
 
+    HostvarHandle hostvar(const std::string& col);
+    void setNull(const HostvarHandle& hostvar);
+    void setBool(const HostvarHandle& hostvar, bool data);
+    void setShort(const HostvarHandle& hostvar, short data);
+    void setInt(const HostvarHandle& hostvar, int data);
+    void setLong(const HostvarHandle& hostvar, long data);
+    void setUnsignedShort(const HostvarHandle& hostvar, unsigned short data);
+    void setUnsigned(const HostvarHandle& hostvar, unsigned data);
+    void setUnsignedLong(const HostvarHandle& hostvar, unsigned long data);
+    void setInt32(const HostvarHandle& hostvar, int32_t data);
+    void setUnsigned32(const HostvarHandle& hostvar, uint32_t data);
+    void setInt64(const HostvarHandle& hostvar, int64_t data);
+    void setUnsigned64(const HostvarHandle& hostvar, uint64_t data);
+    void setDecimal(const HostvarHandle& hostvar, const Decimal& data);
+    void setFloat(const HostvarHandle& hostvar, float data);
+    void setDouble(const HostvarHandle& hostvar, double data);
+    void setChar(const HostvarHandle& hostvar, char data);
+    void setString(const HostvarHandle& hostvar, const std::string& data);
+    void setBlob(const HostvarHandle& hostvar, const Blob& data);
+    void setDate(const HostvarHandle& hostvar, const Date& data);
+    void setTime(const HostvarHandle& hostvar, const Time& data);
+    void setDatetime(const HostvarHandle& hostvar, const Datetime& data);
+
     size_type execute();
     tntdb::Result select();
     tntdb::Row selectRow();
     tntdb::Value selectValue();
     std::shared_ptr<ICursor> createCursor(unsigned fetchsize);
 
+    void maxNumDelay(size_type n);
+    size_type numDelayed() const;
+    size_type flush();
+
     // specfic methods
 
-    // creates stmt handle - caller is responsible for removal
-    MYSQL_STMT* createStmt();
+    // borrows a stmt handle - caller gives it back to getStmtPool()
+    MYSQL_STMT* borrowStmt();
+    const std::shared_ptr<StmtPool>& getStmtPool() const  { return stmtPool; }
+    Connection& getConnection()                           { return conn; }
     // creates stmt handle - handle is managed by this
     MYSQL_STMT* getStmt();
     void execute(MYSQL_STMT* stmt, unsigned fetchsize);
 
     MYSQL_FIELD* getFields();
     unsigned getFieldCount();
+
+    // methods used by the connection for delayed execution
+
+    // true if the query is a "INSERT ... VALUES (...)", which can be
+    // combined to a multi row insert
+    bool isMultiRowInsert() const  { return valuesPos != std::string::npos; }
+    // appends the query with the current parameters as literals
+    void appendQuery(std::string& sql) const;
+    // appends the value tuple with the current parameters as literals
+    void appendValues(std::string& sql) const;
+    void resetDelayed()            { delayed = 0; }
+    // adds the affected rows of a flushed query
+    void delayedResult(size_type n)  { delayedAffected += n; }
 };
 }
 }
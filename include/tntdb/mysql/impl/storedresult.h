@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2005 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef TNTDB_MYSQL_IMPL_STOREDRESULT_H
+#define TNTDB_MYSQL_IMPL_STOREDRESULT_H
+
+#include <tntdb/iface/iresult.h>
+#include <tntdb/iface/irow.h>
+#include <tntdb/impl/columnindex.h>
+#include <mysql.h>
+#include <string>
+#include <vector>
+#include <memory>
+
+namespace tntdb
+{
+namespace mysql
+{
+/// Result of a prepared select, where all rows are copied into one
+/// contiguous buffer.
+///
+/// Each cell is stored as a offset into the buffer. The length of a cell
+/// is the difference to the offset of the next cell. Rows are just views
+/// into the result.
+class StoredResult : public IResult, public std::enable_shared_from_this<StoredResult>
+{
+public:
+    struct Column
+    {
+        std::string name;
+        enum_field_types type;
+        bool isUnsigned;
+    };
+
+private:
+    std::vector<Column> columns;
+    ColumnIndex columnIndex;
+    std::vector<char> data;
+    std::vector<unsigned long> offsets;
+    std::vector<bool> nulls;
+    size_type rowCount;
+
+public:
+    StoredResult(const MYSQL_FIELD* fields, unsigned field_count, unsigned long long numRows);
+
+    /// Returns the size of the buffer mysql writes into for fixed size
+    /// types or 0 for variable length data.
+    static unsigned long fixedSize(enum_field_types type);
+
+    /// Copies the values of the fetched row into the buffer.
+    void addRow(const MYSQL_BIND* bind);
+
+    Row getRow(size_type tup_num) const;
+    size_type size() const;
+    size_type getFieldCount() const;
+
+    const Column& getColumn(size_type field_num) const
+        { return columns[field_num]; }
+    size_type getColumnIndex(const std::string& name) const
+        { return columnIndex.get(name); }
+
+    bool isNull(size_type tup_num, size_type field_num) const
+        { return nulls[tup_num * columns.size() + field_num]; }
+    const char* getData(size_type tup_num, size_type field_num) const
+        { return data.data() + offsets[tup_num * columns.size() + field_num]; }
+    unsigned long getLength(size_type tup_num, size_type field_num) const
+    {
+        size_type idx = tup_num * columns.size() + field_num;
+        return offsets[idx + 1] - offsets[idx];
+    }
+};
+
+class StoredRow : public IRow
+{
+    std::shared_ptr<const StoredResult> _result;
+    size_type _tupNum;
+
+public:
+    StoredRow(std::shared_ptr<const StoredResult> result, size_type tupNum)
+        : _result(result),
+          _tupNum(tupNum)
+        { }
+
+    size_type size() const;
+    Value getValueByNumber(size_type field_num) const;
+    Value getValueByName(const std::string& field_name) const;
+    std::string getColumnName(size_type field_num) const;
+    size_type getColumnIndex(const std::string& field_name) const;
+
+    bool isNull(size_type field_num) const;
+    bool getBool(size_type field_num) const;
+    short getShort(size_type field_num) const;
+    int getInt(size_type field_num) const;
+    long getLong(size_type field_num) const;
+    unsigned getUnsigned(size_type field_num) const;
+    unsigned short getUnsignedShort(size_type field_num) const;
+    unsigned long getUnsignedLong(size_type field_num) const;
+    int32_t getInt32(size_type field_num) const;
+    uint32_t getUnsigned32(size_type field_num) const;
+    int64_t getInt64(size_type field_num) const;
+    uint64_t getUnsigned64(size_type field_num) const;
+    Decimal getDecimal(size_type field_num) const;
+    float getFloat(size_type field_num) const;
+    double getDouble(size_type field_num) const;
+    char getChar(size_type field_num) const;
+    void getString(size_type field_num, std::string& ret) const;
+    void getBlob(size_type field_num, Blob& ret) const;
+    Date getDate(size_type field_num) const;
+    Time getTime(size_type field_num) const;
+    Datetime getDatetime(size_type field_num) const;
+};
+}
+}
+
+#endif // TNTDB_MYSQL_IMPL_STOREDRESULT_H
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2005 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef TNTDB_POSTGRESQL_BINARYFORMAT_H
+#define TNTDB_POSTGRESQL_BINARYFORMAT_H
+
+#include <libpq-fe.h>
+#include <string>
+#include <stdint.h>
+
+namespace tntdb
+{
+class Date;
+class Time;
+class Datetime;
+class Decimal;
+
+namespace postgresql
+{
+// type oids as defined in catalog/pg_type.h of the server
+const Oid pgBoolOid = 16;
+const Oid pgByteaOid = 17;
+const Oid pgInt8Oid = 20;
+const Oid pgInt2Oid = 21;
+const Oid pgInt4Oid = 23;
+const Oid pgFloat4Oid = 700;
+const Oid pgFloat8Oid = 701;
+const Oid pgDateOid = 1082;
+const Oid pgTimeOid = 1083;
+const Oid pgTimestampOid = 1114;
+const Oid pgTimestamptzOid = 1184;
+const Oid pgNumericOid = 1700;
+
+// Functions for converting values into the binary wire format of
+// postgresql. They return false, when the value can't be represented
+// in the given type. The caller has to pass the value as text then.
+bool encodeBinary(Oid type, short value, std::string& ret);
+bool encodeBinary(Oid type, unsigned short value, std::string& ret);
+bool encodeBinary(Oid type, int value, std::string& ret);
+bool encodeBinary(Oid type, unsigned value, std::string& ret);
+bool encodeBinary(Oid type, long value, std::string& ret);
+bool encodeBinary(Oid type, unsigned long value, std::string& ret);
+bool encodeBinary(Oid type, long long value, std::string& ret);
+bool encodeBinary(Oid type, unsigned long long value, std::string& ret);
+bool encodeBinary(Oid type, bool value, std::string& ret);
+bool encodeBinary(Oid type, float value, std::string& ret);
+bool encodeBinary(Oid type, double value, std::string& ret);
+bool encodeBinary(Oid type, const Decimal& value, std::string& ret);
+bool encodeBinary(Oid type, const Date& value, std::string& ret);
+bool encodeBinary(Oid type, const Time& value, std::string& ret);
+bool encodeBinary(Oid type, const Datetime& value, std::string& ret);
+
+// all other types are passed as text
+template <typename T>
+bool encodeBinary(Oid, const T&, std::string&)
+{ return false; }
+
+// Functions for reading values of results in binary format. They return
+// false, when the type of the column can't be converted to the requested
+// type directly. Timestamps with time zone are returned in UTC.
+bool decodeBinary(Oid type, const char* data, int len, int64_t& ret);
+bool decodeBinary(Oid type, const char* data, int len, double& ret);
+bool decodeBinary(Oid type, const char* data, int len, bool& ret);
+bool decodeBinary(Oid type, const char* data, int len, Date& ret);
+bool decodeBinary(Oid type, const char* data, int len, Time& ret);
+bool decodeBinary(Oid type, const char* data, int len, Datetime& ret);
+
+// Converts a binary value to its text representation. Numbers are
+// formatted in fixed point notation. Values of unknown types (including
+// text types, which have the same representation) are returned unchanged.
+void binaryToString(Oid type, const char* data, int len, std::string& ret);
+
+}
+}
+
+#endif // TNTDB_POSTGRESQL_BINARYFORMAT_H
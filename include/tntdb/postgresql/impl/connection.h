@@ -31,8 +31,11 @@
 
 #include <tntdb/iface/iconnection.h>
 #include <tntdb/statement.h>
+#include <tntdb/metrics.h>
 #include <libpq-fe.h>
 #include <vector>
+#include <map>
+#include <list>
 
 namespace tntdb
 {
@@ -57,6 +60,7 @@ A typical connection with a PostgreSQL driver looks like that:
 namespace postgresql
 {
 class Result;
+class Statement;
 
 /// Implements a connection to a PostgreSQL database.
 class Connection : public IConnection
@@ -67,7 +71,40 @@ class Connection : public IConnection
     unsigned transactionActive;
     unsigned stmtCounter;
     std::vector<std::string> stmtsToDeallocate;
+
+    // commands sent in pipeline mode, which results are not read yet
+    struct PipelineEntry
+    {
+        Statement* stmt;
+        bool prepare;
+        std::string stmtName;
+    };
+    std::vector<PipelineEntry> pipeline;
+    bool pipelineMode;
+    class PipelineGuard;
+
+    // server side prepared statements by query, shared by all statements
+    // with the same query
+    struct PreparedStatement
+    {
+        std::string name;
+        std::vector<Oid> paramTypes;
+        unsigned refs;
+        std::list<std::string>::iterator unused;
+    };
+    typedef std::map<std::string, PreparedStatement> PreparedStatements;
+    PreparedStatements preparedStatements;
+    // queries of prepared statements without references; least recently
+    // used first
+    std::list<std::string> unusedPrepared;
+    unsigned maxUnusedPrepared;
+
+    ConnectionMetrics metrics;
+
     std::shared_ptr<Result> pgselect(const std::string& query);
+    // deallocates the least recently used statements, when there are more
+    // than maxUnusedPrepared unused statements
+    void deallocateUnused();
 
 public:
     Connection(const std::string& url, const std::string& username, const std::string& password);
@@ -84,6 +121,8 @@ public:
     tntdb::Statement prepare(const std::string& query);
     tntdb::Statement prepareWithLimit(const std::string& query, const std::string& limit, const std::string& offset);
     bool ping();
+    bool isAlive();
+    bool getMetrics(ConnectionMetrics& m);
     long lastInsertId(const std::string& name);
     void lockTable(const std::string& tablename, bool exclusive);
 
@@ -91,6 +130,62 @@ public:
     unsigned getNextStmtNumber()   { return ++stmtCounter; }
     void deallocateStatement(const std::string& stmtName);
     void deallocateStatements();
+
+    bool inTransaction() const     { return transactionActive > 0; }
+
+    /// Returns true, if the server represents time values as 64 bit
+    /// integers, which is the only option since postgresql 10.
+    bool integerDatetimes() const;
+
+    /// Counts a request sent in pipeline mode, which is answered later.
+    void countSent(std::size_t bytesSent)
+    { metrics.bytesSent += bytesSent; }
+
+    /// Counts a request sent to the server, which is answered by the server.
+    void countRoundTrip(std::size_t bytesSent)
+    {
+        ++metrics.roundTrips;
+        metrics.bytesSent += bytesSent;
+    }
+
+    /// Counts the rows and the size of the values of a result.
+    void countResult(const PGresult* result);
+
+    /// Default number of prepared statements kept on the server after the
+    /// last statement using them is destroyed. It can be changed per
+    /// connection with the option tntdb_max_unused_prepared in the url.
+    static const unsigned defaultMaxUnusedPrepared = 100;
+
+    /// Sets the number of unused prepared statements kept on the server.
+    void setMaxUnusedPrepared(unsigned n);
+    unsigned getMaxUnusedPrepared() const   { return maxUnusedPrepared; }
+
+    /// Looks up a prepared statement for the query with the given parameter
+    /// types and takes a reference.
+    bool acquirePrepared(const std::string& query, const std::vector<Oid>& paramTypes, std::string& name);
+    /// Registers a new prepared statement with one reference. Returns false
+    /// if the query is already registered.
+    bool registerPrepared(const std::string& query, const std::string& name, const std::vector<Oid>& paramTypes);
+    /// Drops a reference. Unused statements are deallocated, when there
+    /// are more than maxUnusedPrepared of them.
+    void releasePrepared(const std::string& query);
+    /// Removes a prepared statement, which failed to prepare.
+    void forgetPrepared(const std::string& name);
+
+    // Support for delayed execution using the pipeline mode of libpq.
+    bool inPipelineMode() const    { return pipelineMode; }
+    void enterPipelineMode();
+    void addPipelineEntry(Statement* stmt, bool prepare);
+    /// Reads the results of all commands in the pipeline and leaves pipeline
+    /// mode. The affected rows are passed to the statements. The first error
+    /// is thrown after all results are read. Pipeline mode is left, even
+    /// when reading the results fails.
+    void flushDelayed();
+    /// Returns true, when the results of the pipeline should be read before
+    /// more commands are sent.
+    bool pipelineFull() const;
+    /// Removes references to a destroyed statement from the pipeline.
+    void releaseDelayed(Statement* stmt);
 };
 
 /// @cond internal
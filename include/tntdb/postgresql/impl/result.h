@@ -31,7 +31,10 @@
 
 #include <tntdb/iface/iresult.h>
 #include <tntdb/bits/connection.h>
+#include <tntdb/impl/columnindex.h>
 #include <libpq-fe.h>
+#include <memory>
+#include <mutex>
 
 namespace tntdb
 {
@@ -41,11 +44,21 @@ class Result : public IResult
 {
     PGresult* _result;
 
+    // Built on the first lookup of a column by name or taken from a
+    // previous result of the same query.
+    std::shared_ptr<const Result> _columnsFrom;
+    mutable std::once_flag _columnIndexFlag;
+    mutable ColumnIndex _columnIndex;
+
 public:
     explicit Result(PGresult* result);
+    /// Creates a result, which shares the column index of a previous
+    /// result with the same columns.
+    Result(PGresult* result, const std::shared_ptr<const Result>& columnsFrom);
     ~Result();
 
     PGresult* getPGresult() const  { return _result; }
+    const ColumnIndex& getColumnIndex() const;
 
     Row getRow(size_type tup_num) const;
     size_type size() const;
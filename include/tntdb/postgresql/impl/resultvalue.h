@@ -47,6 +47,15 @@ class ResultValue : public IValue
     unsigned _rownumber;
     int _tup_num;
 
+    // results of statements with binary results enabled
+    bool isBinary() const;
+    Oid getType() const;
+    const char* getData() const;
+    int getLength() const;
+
+    template <typename T>
+    T getInteger(const char* tname) const;
+
 public:
     ResultValue(const std::shared_ptr<Result>& resultref, const Result& result, unsigned rownumber, int tup_num);
     ResultValue(const Result& result, unsigned rownumber, int tup_num);
@@ -69,6 +78,8 @@ public:
     virtual char getChar() const;
     virtual void getString(std::string& ret) const;
     virtual void getBlob(Blob& ret) const;
+    virtual bool getStringView(const char*& data, std::size_t& length) const;
+    virtual bool getBlobView(const char*& data, std::size_t& length) const;
     virtual Date getDate() const;
     virtual Time getTime() const;
     virtual Datetime getDatetime() const;
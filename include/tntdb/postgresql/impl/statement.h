@@ -80,23 +80,55 @@ class Statement : public IStatement
     std::vector<const char*> paramValues;
     std::vector<int> paramLengths;
     std::vector<int> paramFormats;
+    // types of the bound values, which are passed to the server when
+    // preparing; 0 lets the server infer the type, which is the default
+    std::vector<Oid> bindTypes;
+    // types the statement is prepared with; empty until it is prepared
+    std::vector<Oid> paramTypes;
+    std::string binaryValue;
+
+    unsigned maxDelay;
+    unsigned delayed;
+    size_type delayedAffected;
+    int resultFormat;
+    // pass values in binary format with the types of their C++ types
+    bool typedParams;
+    bool streaming;
+    // true if stmtName is shared with other statements through the
+    // connection
+    bool sharedStmt;
+    bool executed;
 
     // helper-methods for setting values
+    unsigned hostvarIndex(const std::string& col) const;
+
     template <typename T>
-    void setValue(const std::string& col, T data);
+    void setValue(unsigned n, T data);
+
+    void setTextValue(unsigned n, const std::string& data, Oid type);
 
     template <typename T>
-    void setStringValue(const std::string& col, T data, bool binary = false);
+    void setFloatValue(unsigned n, T data);
 
     template <typename T>
-    void setIsoValue(const std::string& col, T data);
+    void setStringValue(unsigned n, T data, bool binary = false);
+
+    void setNullValue(unsigned n);
 
 #ifndef HAVE_PQPREPARE
     void setType(const std::string& col, const std::string& type);
 #endif
 
+    bool acquirePrepared();
+    void releaseStmt();
+    void checkParamTypes();
     void doPrepare();
+    PGresult* execUnnamed();
+#ifdef LIBPQ_HAS_PIPELINING
+    PGresult* prepareAndExec();
+#endif
     PGresult* execPrepared();
+    void sendPrepared();
 
 public:
     Statement(Connection* conn, const std::string& query);
@@ -127,20 +159,62 @@ public:
     void setTime(const std::string& col, const Time& data);
     void setDatetime(const std::string& col, const Datetime& data);
 
+    HostvarHandle hostvar(const std::string& col);
+    void setNull(const HostvarHandle& hostvar);
+    void setBool(const HostvarHandle& hostvar, bool data);
+    void setShort(const HostvarHandle& hostvar, short data);
+    void setInt(const HostvarHandle& hostvar, int data);
+    void setLong(const HostvarHandle& hostvar, long data);
+    void setUnsignedShort(const HostvarHandle& hostvar, unsigned short data);
+    void setUnsigned(const HostvarHandle& hostvar, unsigned data);
+    void setUnsignedLong(const HostvarHandle& hostvar, unsigned long data);
+    void setInt32(const HostvarHandle& hostvar, int32_t data);
+    void setUnsigned32(const HostvarHandle& hostvar, uint32_t data);
+    void setInt64(const HostvarHandle& hostvar, int64_t data);
+    void setUnsigned64(const HostvarHandle& hostvar, uint64_t data);
+    void setDecimal(const HostvarHandle& hostvar, const Decimal& data);
+    void setFloat(const HostvarHandle& hostvar, float data);
+    void setDouble(const HostvarHandle& hostvar, double data);
+    void setChar(const HostvarHandle& hostvar, char data);
+    void setString(const HostvarHandle& hostvar, const std::string& data);
+    void setBlob(const HostvarHandle& hostvar, const Blob& data);
+    void setDate(const HostvarHandle& hostvar, const Date& data);
+    void setTime(const HostvarHandle& hostvar, const Time& data);
+    void setDatetime(const HostvarHandle& hostvar, const Datetime& data);
+
     size_type execute();
     tntdb::Result select();
     tntdb::Row selectRow();
     tntdb::Value selectValue();
     std::shared_ptr<ICursor> createCursor(unsigned fetchsize);
 
+    void maxNumDelay(size_type n);
+    size_type numDelayed() const;
+    size_type flush();
+
+    void binaryParams(bool enable)          { typedParams = enable; }
+    void binaryResults(bool enable)         { resultFormat = enable ? 1 : 0; }
+    void streamingCursor(bool enable)       { streaming = enable; }
+
     // specific methods
     const std::string& getQuery() const     { return query; }
+    // prepares the statement if needed and returns its name
+    const std::string& getPreparedName();
+    const std::string& getStmtName() const  { return stmtName; }
     unsigned getNParams()                   { return values.size(); }
     const char* const* getParamValues();
     const int* getParamLengths();
     const int* getParamFormats()            { return &paramFormats[0]; }
+    /// Returns the total size of the parameter values.
+    std::size_t getParamBytes();
+    const Oid* getParamTypes() const        { return bindTypes.empty() ? 0 : &bindTypes[0]; }
     PGconn* getPGConn();
     Connection* getConnection()             { return conn; }
+    int getResultFormat() const             { return resultFormat; }
+
+    // called by the connection, when the results of the pipeline are read
+    void delayedResult(size_type n)         { --delayed; delayedAffected += n; }
+    void prepareFailed()                    { stmtName.clear(); paramTypes.clear(); sharedStmt = false; }
 };
 }
 }
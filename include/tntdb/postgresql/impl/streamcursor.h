@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2005 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef TNTDB_POSTGRESQL_IMPL_STREAMCURSOR_H
+#define TNTDB_POSTGRESQL_IMPL_STREAMCURSOR_H
+
+#include <tntdb/iface/icursor.h>
+#include <libpq-fe.h>
+#include <memory>
+
+namespace tntdb
+{
+namespace postgresql
+{
+class Statement;
+class Result;
+
+/// Cursor, which reads the rows of a single execution of the statement.
+///
+/// The statement is sent with PQsendQueryPrepared and the rows are read in
+/// single row mode or, with libpq 17, in chunks of fetchsize rows. Older
+/// versions of libpq ignore fetchsize and log a warning once. Unlike
+/// Cursor it needs no further round trips, but the connection can't be used
+/// for other commands until all rows are read or the cursor is destroyed.
+class StreamCursor : public ICursor
+{
+    Statement& stmt;
+    PGconn* conn;
+    std::shared_ptr<Result> currentResult;
+    // all results have the same columns, so they share the column index
+    // of the first one
+    std::shared_ptr<const Result> firstResult;
+    unsigned currentRow;
+    bool done;
+
+    void finish(PGresult* result);
+    void discardResults();
+
+public:
+    StreamCursor(Statement& statement, unsigned fetchSize);
+    ~StreamCursor();
+
+    // method for ICursor
+    Row fetch();
+};
+}
+}
+
+#endif // TNTDB_POSTGRESQL_IMPL_STREAMCURSOR_H
@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2005 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef TNTDB_PREPAREDSTATEMENT_H
+#define TNTDB_PREPAREDSTATEMENT_H
+
+#include <tntdb/connection.h>
+#include <tntdb/statement.h>
+#include <tntdb/result.h>
+#include <tntdb/row.h>
+#include <tntdb/value.h>
+#include <tntdb/hostvarhandle.h>
+#include <string>
+#include <vector>
+
+namespace tntdb
+{
+/** Common part of tntdb::PreparedStatement, which does not depend on the
+    argument types.
+ */
+class PreparedStatementBase
+{
+protected:
+    Statement _stmt;
+    std::vector<HostvarHandle> _hostvars;
+
+    /// Prepares the query and resolves its host variables. Throws
+    /// tntdb::SqlError, when the number of distinct host variables is
+    /// not numArgs.
+    PreparedStatementBase(Connection& conn, const std::string& query, unsigned numArgs);
+
+    //@{
+    /// Sets a host variable using the setter of the type.
+    static void setArg(Statement& stmt, const HostvarHandle& h, bool data)
+        { stmt.setBool(h, data); }
+    static void setArg(Statement& stmt, const HostvarHandle& h, short data)
+        { stmt.setShort(h, data); }
+    static void setArg(Statement& stmt, const HostvarHandle& h, int data)
+        { stmt.setInt(h, data); }
+    static void setArg(Statement& stmt, const HostvarHandle& h, long data)
+        { stmt.setLong(h, data); }
+    static void setArg(Statement& stmt, const HostvarHandle& h, unsigned short data)
+        { stmt.setUnsignedShort(h, data); }
+    static void setArg(Statement& stmt, const HostvarHandle& h, unsigned data)
+        { stmt.setUnsigned(h, data); }
+    static void setArg(Statement& stmt, const HostvarHandle& h, unsigned long data)
+        { stmt.setUnsignedLong(h, data); }
+    static void setArg(Statement& stmt, const HostvarHandle& h, long long data)
+        { stmt.setInt64(h, static_cast<int64_t>(data)); }
+    static void setArg(Statement& stmt, const HostvarHandle& h, unsigned long long data)
+        { stmt.setUnsigned64(h, static_cast<uint64_t>(data)); }
+    static void setArg(Statement& stmt, const HostvarHandle& h, const Decimal& data)
+        { stmt.setDecimal(h, data); }
+    static void setArg(Statement& stmt, const HostvarHandle& h, float data)
+        { stmt.setFloat(h, data); }
+    static void setArg(Statement& stmt, const HostvarHandle& h, double data)
+        { stmt.setDouble(h, data); }
+    static void setArg(Statement& stmt, const HostvarHandle& h, char data)
+        { stmt.setChar(h, data); }
+    static void setArg(Statement& stmt, const HostvarHandle& h, const std::string& data)
+        { stmt.setString(h, data); }
+    static void setArg(Statement& stmt, const HostvarHandle& h, const char* data)
+        { stmt.setString(h, data); }
+    static void setArg(Statement& stmt, const HostvarHandle& h, const Blob& data)
+        { stmt.setBlob(h, data); }
+    static void setArg(Statement& stmt, const HostvarHandle& h, const Date& data)
+        { stmt.setDate(h, data); }
+    static void setArg(Statement& stmt, const HostvarHandle& h, const Time& data)
+        { stmt.setTime(h, data); }
+    static void setArg(Statement& stmt, const HostvarHandle& h, const Datetime& data)
+        { stmt.setDatetime(h, data); }
+#if __cplusplus >= 201703L
+    template <typename T>
+    static void setArg(Statement& stmt, const HostvarHandle& h, const std::optional<T>& data)
+    {
+        if (data)
+            setArg(stmt, h, *data);
+        else
+            stmt.setNull(h);
+    }
+#endif
+    /// Other types are set using the operator<< for tntdb::Hostvar.
+    template <typename T>
+    static void setArg(Statement& stmt, const HostvarHandle& h, const T& data)
+        { stmt.set(h, data); }
+    //@}
+
+public:
+    /// Returns the number of distinct host variables of the query.
+    unsigned size() const                 { return _hostvars.size(); }
+
+    /// Returns the underlying statement.
+    Statement& getStatement()             { return _stmt; }
+    const Statement& getStatement() const { return _stmt; }
+};
+
+/** Statement with a fixed list of argument types
+
+    The arguments are bound positionally to the host variables of the query
+    in the order of their first occurrence. A host variable, which occurs
+    more than once, is one argument. The number of host variables is checked
+    against the number of argument types, when the statement is prepared.
+
+    The arguments are set using the resolved host variable handles and the
+    typed setters of the driver, so no names are looked up on execution.
+
+    @code
+      tntdb::PreparedStatement<int64_t, std::string> ins(conn,
+        "insert into t(id, name) values(:id, :name)");
+
+      for (unsigned n = 0; n < names.size(); ++n)
+        ins.execute(n, names[n]);
+    @endcode
+ */
+template <typename... Args>
+class PreparedStatement : public PreparedStatementBase
+{
+    template <unsigned N>
+    void setArgs()
+    { }
+
+    template <unsigned N, typename A, typename... Rest>
+    void setArgs(const A& arg, const Rest&... rest)
+    {
+        setArg(_stmt, _hostvars[N], arg);
+        setArgs<N + 1>(rest...);
+    }
+
+public:
+    typedef Statement::size_type size_type;
+
+    PreparedStatement(Connection& conn, const std::string& query)
+      : PreparedStatementBase(conn, query, sizeof...(Args))
+      { }
+
+    /// Sets all host variables.
+    PreparedStatement& set(const Args&... args)
+    {
+        setArgs<0>(args...);
+        return *this;
+    }
+
+    /// Sets the host variables and executes the query.
+    size_type execute(const Args&... args)
+    {
+        setArgs<0>(args...);
+        return _stmt.execute();
+    }
+
+    /// Sets the host variables and returns the result of the query.
+    Result select(const Args&... args)
+    {
+        setArgs<0>(args...);
+        return _stmt.select();
+    }
+
+    /// Sets the host variables and returns the first row of the result.
+    Row selectRow(const Args&... args)
+    {
+        setArgs<0>(args...);
+        return _stmt.selectRow();
+    }
+
+    /// Sets the host variables and returns the first value of the result.
+    Value selectValue(const Args&... args)
+    {
+        setArgs<0>(args...);
+        return _stmt.selectValue();
+    }
+};
+}
+
+#endif // TNTDB_PREPAREDSTATEMENT_H
@@ -61,6 +61,8 @@ public:
     tntdb::Statement prepare(const std::string& query);
     tntdb::Statement prepareWithLimit(const std::string& query, const std::string& limit, const std::string& offset);
     bool ping();
+    bool isAlive();
+    bool getMetrics(ConnectionMetrics& metrics);
     long lastInsertId(const std::string& name);
     void lockTable(const std::string& tablename, bool exclusive);
 };
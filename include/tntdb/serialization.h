@@ -29,7 +29,9 @@
 #ifndef TNTDB_SERIALIZATION_H
 #define TNTDB_SERIALIZATION_H
 
+#include <tntdb/binding.h>
 #include <cxxtools/serializationinfo.h>
+#include <type_traits>
 
 namespace tntdb
 {
@@ -58,6 +60,34 @@ void operator<<= (cxxtools::SerializationInfo& si, const Statement& res);
  */
 void operator>>= (const cxxtools::SerializationInfo& si, Statement& stmt);
 
+//@{
+/** Helpers for the object serialization operators.
+ *  The overloads for types with a tntdb::Binding are defined with
+ *  tntdb::Statement and tntdb::Row.
+ */
+template <typename T>
+void setObject(Statement& stmt, const T& obj, std::false_type)
+{
+    cxxtools::SerializationInfo si;
+    si <<= obj;
+    si >>= stmt;
+}
+
+template <typename T>
+void setObject(Statement& stmt, const T& obj, std::true_type);
+
+template <typename T>
+void getObject(const Row& row, T& obj, std::false_type)
+{
+    cxxtools::SerializationInfo si;
+    si <<= row;
+    si >>= obj;
+}
+
+template <typename T>
+void getObject(const Row& row, T& obj, std::true_type);
+//@}
+
 /** Serialize objects into tntdb::Statement.
  *  This sets the placeholder variables in statement to the value of the
  *  object to serialize.
@@ -76,18 +106,19 @@ void operator>>= (const cxxtools::SerializationInfo& si, Statement& stmt);
 template <typename T>
 Statement& operator<<= (Statement& stmt, const T& obj)
 {
-    cxxtools::SerializationInfo si;
-    si <<= obj;
-    si >>= stmt;
+    setObject(stmt, obj, std::integral_constant<bool, Binding<T>::defined>());
     return stmt;
 }
 
+/** Deserialize a tntdb::Row into an object.
+ *  When a tntdb::Binding is defined for the type, the members are read
+ *  directly from the columns. Otherwise the row is converted into a
+ *  cxxtools::SerializationInfo, which is deserialized into the object.
+ */
 template <typename T>
 void operator>>= (const Row& row, T& obj)
 {
-    cxxtools::SerializationInfo si;
-    si <<= row;
-    si >>= obj;
+    getObject(row, obj, std::integral_constant<bool, Binding<T>::defined>());
 }
 
 }
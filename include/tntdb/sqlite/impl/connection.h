@@ -77,6 +77,7 @@ public:
     tntdb::Statement prepare(const std::string& query);
     tntdb::Statement prepareWithLimit(const std::string& query, const std::string& limit, const std::string& offset);
     bool ping();
+    bool isAlive();
     long lastInsertId(const std::string& name);
     void lockTable(const std::string& tablename, bool exclusive);
 
@@ -30,7 +30,9 @@
 #define TNTDB_SQLITE_IMPL_CURSOR_H
 
 #include <tntdb/iface/icursor.h>
+#include <tntdb/impl/columnindex.h>
 #include <sqlite3.h>
+#include <memory>
 
 namespace tntdb
 {
@@ -41,6 +43,7 @@ class Statement;
 class Cursor : public ICursor
 {
     Statement* _stmt;
+    std::shared_ptr<ColumnIndex> _columnIndex;
 
 public:
     explicit Cursor(Statement* stmt);
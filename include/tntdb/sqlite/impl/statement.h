@@ -49,6 +49,29 @@ class Statement : public IStatement
 
     sqlite3_stmt* getBindStmt();
     int getBindIndex(const std::string& col);
+    int getBindIndex(const HostvarHandle& hostvar);
+
+    void bindNull(int idx);
+    void bindBool(int idx, bool data);
+    void bindShort(int idx, short data);
+    void bindInt(int idx, int data);
+    void bindLong(int idx, long data);
+    void bindUnsignedShort(int idx, unsigned short data);
+    void bindUnsigned(int idx, unsigned data);
+    void bindUnsignedLong(int idx, unsigned long data);
+    void bindInt32(int idx, int32_t data);
+    void bindUnsigned32(int idx, uint32_t data);
+    void bindInt64(int idx, int64_t data);
+    void bindUnsigned64(int idx, uint64_t data);
+    void bindDecimal(int idx, const Decimal& data);
+    void bindFloat(int idx, float data);
+    void bindDouble(int idx, double data);
+    void bindChar(int idx, char data);
+    void bindString(int idx, const std::string& data);
+    void bindBlob(int idx, const Blob& data);
+    void bindDate(int idx, const Date& data);
+    void bindTime(int idx, const Time& data);
+    void bindDatetime(int idx, const Datetime& data);
 
     bool _needReset;
     void reset();
@@ -82,6 +105,29 @@ public:
     virtual void setTime(const std::string& col, const Time& data);
     virtual void setDatetime(const std::string& col, const Datetime& data);
 
+    virtual HostvarHandle hostvar(const std::string& col);
+    virtual void setNull(const HostvarHandle& hostvar);
+    virtual void setBool(const HostvarHandle& hostvar, bool data);
+    virtual void setShort(const HostvarHandle& hostvar, short data);
+    virtual void setInt(const HostvarHandle& hostvar, int data);
+    virtual void setLong(const HostvarHandle& hostvar, long data);
+    virtual void setUnsignedShort(const HostvarHandle& hostvar, unsigned short data);
+    virtual void setUnsigned(const HostvarHandle& hostvar, unsigned data);
+    virtual void setUnsignedLong(const HostvarHandle& hostvar, unsigned long data);
+    virtual void setInt32(const HostvarHandle& hostvar, int32_t data);
+    virtual void setUnsigned32(const HostvarHandle& hostvar, uint32_t data);
+    virtual void setInt64(const HostvarHandle& hostvar, int64_t data);
+    virtual void setUnsigned64(const HostvarHandle& hostvar, uint64_t data);
+    virtual void setDecimal(const HostvarHandle& hostvar, const Decimal& data);
+    virtual void setFloat(const HostvarHandle& hostvar, float data);
+    virtual void setDouble(const HostvarHandle& hostvar, double data);
+    virtual void setChar(const HostvarHandle& hostvar, char data);
+    virtual void setString(const HostvarHandle& hostvar, const std::string& data);
+    virtual void setBlob(const HostvarHandle& hostvar, const Blob& data);
+    virtual void setDate(const HostvarHandle& hostvar, const Date& data);
+    virtual void setTime(const HostvarHandle& hostvar, const Time& data);
+    virtual void setDatetime(const HostvarHandle& hostvar, const Datetime& data);
+
     virtual size_type execute();
     virtual tntdb::Result select();
     virtual tntdb::Row selectRow();
@@ -30,7 +30,9 @@
 #define TNTDB_SQLITE_IMPL_STMTROW_H
 
 #include <tntdb/iface/irow.h>
+#include <tntdb/impl/columnindex.h>
 #include <tntdb/sqlite/impl/statement.h>
+#include <memory>
 
 namespace tntdb
 {
@@ -40,16 +42,42 @@ namespace tntdb
     class StmtRow : public IRow
     {
         sqlite3_stmt* stmt;
+        // shared by all rows of a cursor and filled on first lookup by name
+        std::shared_ptr<ColumnIndex> columnIndex;
 
       public:
-        StmtRow(sqlite3_stmt* stmt_)
-          : stmt(stmt_)
+        StmtRow(sqlite3_stmt* stmt_, const std::shared_ptr<ColumnIndex>& columnIndex_)
+          : stmt(stmt_),
+            columnIndex(columnIndex_)
           { }
 
         unsigned size() const;
         Value getValueByNumber(size_type field_num) const;
         Value getValueByName(const std::string& field_name) const;
         std::string getColumnName(size_type field_num) const;
+        size_type getColumnIndex(const std::string& field_name) const;
+
+        bool isNull(size_type field_num) const;
+        bool getBool(size_type field_num) const;
+        short getShort(size_type field_num) const;
+        int getInt(size_type field_num) const;
+        long getLong(size_type field_num) const;
+        unsigned getUnsigned(size_type field_num) const;
+        unsigned short getUnsignedShort(size_type field_num) const;
+        unsigned long getUnsignedLong(size_type field_num) const;
+        int32_t getInt32(size_type field_num) const;
+        uint32_t getUnsigned32(size_type field_num) const;
+        int64_t getInt64(size_type field_num) const;
+        uint64_t getUnsigned64(size_type field_num) const;
+        Decimal getDecimal(size_type field_num) const;
+        float getFloat(size_type field_num) const;
+        double getDouble(size_type field_num) const;
+        char getChar(size_type field_num) const;
+        void getString(size_type field_num, std::string& ret) const;
+        void getBlob(size_type field_num, Blob& ret) const;
+        Date getDate(size_type field_num) const;
+        Time getTime(size_type field_num) const;
+        Datetime getDatetime(size_type field_num) const;
 
         // specific methods of sqlite-driver
         sqlite3_stmt* getStmt() const   { return stmt; }
@@ -32,6 +32,7 @@
 #include <tntdb/bits/statement.h>
 #include <tntdb/bits/statement_iterator.h>
 #include <tntdb/bits/rowreader.h>
+#include <tntdb/bits/typedrows.h>
 
 namespace tntdb
 {
@@ -26,27 +26,17 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
-#include <tntdb/mysql/impl/rowcontainer.h>
-#include <tntdb/row.h>
-#include <cxxtools/log.h>
+#include <tntdb/impl/columnindex.h>
+#include <tntdb/error.h>
 
 namespace tntdb
 {
-namespace mysql
+ColumnIndex::size_type ColumnIndex::get(const std::string& name) const
 {
-Row RowContainer::getRow(size_type tup_num) const
-{
-    return Row(rows[tup_num]);
-}
-
-RowContainer::size_type RowContainer::size() const
-{
-    return rows.size();
+    IndexType::const_iterator it = _index.find(name);
+    if (it == _index.end())
+        throw FieldNotFound(name);
+    return it->second;
 }
 
-RowContainer::size_type RowContainer::getFieldCount() const
-{
-    return rows.empty() ? 0 : (*rows.begin())->size();
-}
-}
 }
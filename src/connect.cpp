@@ -97,6 +97,11 @@ unsigned cachedConnections(const std::string& url)
     return connectionPools.getCurrentSize(url, std::string(), std::string());
 }
 
+PoolMetrics cachedConnectionMetrics(const std::string& url, const std::string& username, const std::string& password)
+{
+    return connectionPools.getMetrics(url, username, password);
+}
+
 Connection connectCached(const std::string& url, const std::string& username, const std::string& password)
 {
     log_debug("connectCached(\"" << url << "\", \"" << username << "\", password)");
@@ -127,4 +132,34 @@ unsigned getMaxPoolSize()
 {
     return connectionPools.getMaximumSize();
 }
+
+void setPoolLimit(unsigned max, std::chrono::milliseconds timeout)
+{
+    connectionPools.setMaxSize(max, timeout);
+}
+
+unsigned cachedConnectionWaiters()
+{
+    return connectionPools.getWaiting();
+}
+
+void setPoolMinIdle(unsigned n)
+{
+    connectionPools.setMinIdle(n);
+}
+
+void setPoolThreadCache(bool enable)
+{
+    connectionPools.setThreadCache(enable);
+}
+
+unsigned warmupCached(const std::string& url, const std::string& username, const std::string& password, unsigned n)
+{
+    return connectionPools.warmup(url, username, password, n);
+}
+
+void setPoolValidation(ConnectionPool::Validation validation, std::chrono::milliseconds interval)
+{
+    connectionPools.setValidation(validation, interval);
+}
 }
@@ -29,69 +29,768 @@
 #include <tntdb/connectionpool.h>
 #include <tntdb/connect.h>
 #include <tntdb/impl/poolconnection.h>
+#include <tntdb/error.h>
 #include <cxxtools/log.h>
+#include <iterator>
+#include <algorithm>
+#include <atomic>
+#include <system_error>
+#include <vector>
 
 log_define("tntdb.connectionpool")
 
 namespace tntdb
 {
+////////////////////////////////////////////////////////////////////////
+// ConnectionPool::ThreadCache
+//
+class ConnectionPool::ThreadCache
+{
+    struct Entry
+    {
+        std::shared_ptr<Handle> handle;
+        IdleConnection idle;
+    };
+
+    std::vector<Entry> _entries;
+
+    // The cache of the thread or a null pointer, when it is not created
+    // yet or already destroyed. Thread locals are destroyed before static
+    // objects, so pools destroyed at exit must not touch the cache itself.
+    static thread_local ThreadCache* _current;
+
+    ThreadCache()
+      { _current = this; }
+
+    static bool isDestroyed(const Entry& entry)
+    {
+        std::lock_guard<std::mutex> lock(entry.handle->mutex);
+        return entry.handle->pool == 0;
+    }
+
+public:
+    // returns the kept connections to their pools
+    ~ThreadCache();
+
+    // Returns the cache of the thread, which is created on first use, or a
+    // null pointer when the thread is exiting.
+    static ThreadCache* get()
+    {
+        static thread_local ThreadCache cache;
+        return _current;
+    }
+
+    // Returns the cache of the thread, if it exists.
+    static ThreadCache* find()
+      { return _current; }
+
+    // Keeps the connection, unless the thread already keeps one for the pool.
+    bool put(ConnectionPool* pool, std::shared_ptr<IConnection>& conn);
+
+    // Takes the connection kept for the pool.
+    bool take(ConnectionPool* pool, IdleConnection& idle);
+
+    // Forgets the pool, which is destroyed.
+    void remove(ConnectionPool* pool);
+
+    // Takes the connection kept for the pool of owner with the given
+    // parameters and returns its pool or a null pointer.
+    ConnectionPool* take(const ConnectionPools* owner, const std::string& url, const std::string& username, const std::string& password, IdleConnection& idle);
+};
+
+thread_local ConnectionPool::ThreadCache* ConnectionPool::ThreadCache::_current = 0;
+
+ConnectionPool::ThreadCache::~ThreadCache()
+{
+    _current = 0;
+    for (auto& entry: _entries)
+    {
+        if (!entry.idle.connection)
+            continue;
+
+        // the pool can't be destroyed, while we hold the lock of the handle
+        std::lock_guard<std::mutex> lock(entry.handle->mutex);
+        if (entry.handle->pool)
+            entry.handle->pool->put(entry.idle.connection);
+    }
+}
+
+bool ConnectionPool::ThreadCache::put(ConnectionPool* pool, std::shared_ptr<IConnection>& conn)
+{
+    for (auto& entry: _entries)
+    {
+        if (entry.handle == pool->_handle)
+        {
+            if (entry.idle.connection)
+                return false;
+
+            entry.idle.connection = conn;
+            entry.idle.lastUsed = Clock::now();
+            return true;
+        }
+    }
+
+    // close the connections of pools, which were destroyed in the meantime
+    _entries.erase(std::remove_if(_entries.begin(), _entries.end(), isDestroyed), _entries.end());
+
+    Entry entry;
+    entry.handle = pool->_handle;
+    entry.idle.connection = conn;
+    entry.idle.lastUsed = Clock::now();
+    _entries.push_back(std::move(entry));
+    return true;
+}
+
+bool ConnectionPool::ThreadCache::take(ConnectionPool* pool, IdleConnection& idle)
+{
+    for (auto& entry: _entries)
+    {
+        if (entry.handle == pool->_handle && entry.idle.connection)
+        {
+            idle = std::move(entry.idle);
+            entry.idle.connection.reset();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ConnectionPool::ThreadCache::remove(ConnectionPool* pool)
+{
+    for (auto it = _entries.begin(); it != _entries.end(); ++it)
+    {
+        if (it->handle == pool->_handle)
+        {
+            _entries.erase(it);
+            return;
+        }
+    }
+}
+
+ConnectionPool* ConnectionPool::ThreadCache::take(const ConnectionPools* owner, const std::string& url, const std::string& username, const std::string& password, IdleConnection& idle)
+{
+    for (auto& entry: _entries)
+    {
+        if (!entry.idle.connection)
+            continue;
+
+        // Pools, which are not owned by owner, may be destroyed by other
+        // threads at any time.
+        std::lock_guard<std::mutex> lock(entry.handle->mutex);
+        ConnectionPool* pool = entry.handle->pool;
+        if (pool
+            && pool->_owner == owner
+            && pool->_url == url
+            && pool->_username == username
+            && pool->_password == password)
+        {
+            idle = std::move(entry.idle);
+            entry.idle.connection.reset();
+            return pool;
+        }
+    }
+
+    return 0;
+}
+
 ////////////////////////////////////////////////////////////////////////
 // ConnectionPool
 //
+bool ConnectionPool::validate(IConnection& conn, Validation validation)
+{
+    if (validation == validateNone)
+        return true;
+
+    // An exception is treated like a dead connection, so that the caller
+    // drops the connection and releases its slot.
+    ++_pings;
+    bool ok;
+    try
+    {
+        ok = validation == validateAlive ? conn.isAlive()
+                                         : conn.ping();
+    }
+    catch (const std::exception& e)
+    {
+        log_warn("validation of connection to " << _url << " failed: " << e.what());
+        ok = false;
+    }
+    catch (...)
+    {
+        log_warn("validation of connection to " << _url << " failed");
+        ok = false;
+    }
+
+    if (!ok)
+        ++_failedPings;
+
+    return ok;
+}
+
+std::shared_ptr<IConnection> ConnectionPool::create()
+{
+    // the slot for the connection is reserved by the caller
+    try
+    {
+        std::shared_ptr<IConnection> conn = tntdb::connect(_url, _username, _password).getImpl();
+        ++_creations;
+        return conn;
+    }
+    catch (...)
+    {
+        ++_creationFailures;
+        release();
+        throw;
+    }
+}
+
+Connection ConnectionPool::checkedOut(std::shared_ptr<IConnection>&& conn, Clock::time_point start)
+{
+    ++_checkouts;
+    ++_inUse;
+    Connection ret(std::make_shared<PoolConnection>(std::move(conn), *this));
+    _waitTime.add(Clock::now() - start);
+    return ret;
+}
+
+void ConnectionPool::checkedIn(Clock::time_point checkoutTime, bool dropped)
+{
+    _holdTime.add(Clock::now() - checkoutTime);
+    --_inUse;
+    if (dropped)
+        ++_drops;
+}
+
+ConnectionPool::~ConnectionPool()
+{
+    {
+        // other threads may still keep connections of the pool
+        std::lock_guard<std::mutex> lock(_handle->mutex);
+        _handle->pool = 0;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+
+    if (_refillThread.joinable())
+        _refillThread.join();
+
+    // the destroying thread may still keep a connection
+    ThreadCache* cache = ThreadCache::find();
+    if (_threadCache && cache)
+        cache->remove(this);
+}
+
+ConnectionPool::Validation ConnectionPool::validationFor(Clock::time_point lastUsed) const
+{
+    return Clock::now() - lastUsed < _validationInterval.load() ? validateNone
+                                                                : _validation.load();
+}
+
+bool ConnectionPool::connectThreadCached(Connection& conn)
+{
+    Clock::time_point start = Clock::now();
+    IdleConnection idle;
+    ThreadCache* cache = ThreadCache::get();
+    if (!cache || !cache->take(this, idle))
+        return false;
+
+    if (!validate(*idle.connection, validationFor(idle.lastUsed)))
+    {
+        log_warn("drop dead connection from thread cache");
+        idle.connection.reset();
+        release();
+        return false;
+    }
+
+    conn = checkedOut(std::move(idle.connection), start);
+    return true;
+}
+
+bool ConnectionPool::connectThreadCached(const ConnectionPools* owner, const std::string& url, const std::string& username, const std::string& password, Connection& conn)
+{
+    Clock::time_point start = Clock::now();
+    IdleConnection idle;
+    ThreadCache* cache = ThreadCache::get();
+    ConnectionPool* pool = cache ? cache->take(owner, url, username, password, idle) : 0;
+    if (!pool)
+        return false;
+
+    if (!pool->validate(*idle.connection, pool->validationFor(idle.lastUsed)))
+    {
+        log_warn("drop dead connection from thread cache");
+        idle.connection.reset();
+        pool->release();
+        return false;
+    }
+
+    conn = pool->checkedOut(std::move(idle.connection), start);
+    return true;
+}
+
+bool ConnectionPool::reserveSlot()
+{
+    if (_maxSize != 0 && _size >= _maxSize)
+        return false;
+
+    ++_size;
+    return true;
+}
+
+bool ConnectionPool::checkout(std::unique_lock<std::mutex>& lock, std::chrono::milliseconds timeout, IdleConnection& idle)
+{
+    // Threads, which are already waiting, are served first.
+    if (_waiters.empty())
+    {
+        if (!_connectionPool.empty())
+        {
+            idle = std::move(_connectionPool.back());
+            _connectionPool.pop_back();
+            return true;
+        }
+
+        if (reserveSlot())
+            return false;
+    }
+
+    log_debug("wait for connection; " << _size << " connections open, " << _waiters.size() << " threads waiting");
+
+    Waiter waiter;
+    _waiters.push_back(&waiter);
+    ++_waitCount;
+
+    if (timeout == std::chrono::milliseconds::max())
+    {
+        waiter.cond.wait(lock, [&waiter] { return waiter.ready; });
+    }
+    else if (!waiter.cond.wait_for(lock, timeout, [&waiter] { return waiter.ready; }))
+    {
+        _waiters.erase(std::find(_waiters.begin(), _waiters.end(), &waiter));
+        ++_timeoutCount;
+        log_warn("timeout waiting for connection to " << _url);
+        throw PoolTimeout();
+    }
+
+    if (!waiter.connection)
+        return false;
+
+    idle.connection = std::move(waiter.connection);
+    idle.lastUsed = Clock::now();
+    return true;
+}
+
 Connection ConnectionPool::connect()
+{
+    return connect(_timeout);
+}
+
+Connection ConnectionPool::connect(std::chrono::milliseconds timeout)
 {
     log_debug("ConnectionPool::connect()");
 
-    log_debug("current pool size " << getCurrentSize() << " max " << getMaxSpare());
+    Connection conn;
+    if (_threadCache && connectThreadCached(conn))
+        return conn;
 
-    std::lock_guard<std::mutex> lock(_mutex);
+    Clock::time_point start = Clock::now();
 
-    std::shared_ptr<IConnection> c;
-    while (!_connectionPool.empty()
-        && !_connectionPool.back()->ping())
+    while (true)
     {
+        IdleConnection idle;
+        Validation validation;
+
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+
+            log_debug("current pool size " << _connectionPool.size() << " max " << _maxSpare);
+
+            bool found = checkout(lock, timeout, idle);
+            startRefill();
+            if (!found)
+                break;
+
+            validation = validationFor(idle.lastUsed);
+        }
+
+        if (validate(*idle.connection, validation))
+            return checkedOut(std::move(idle.connection), start);
+
         log_warn("drop dead connection from pool");
-        _connectionPool.pop_back();
+        idle.connection.reset();
+        release();
+
+        if (timeout != std::chrono::milliseconds::max())
+            timeout = std::max(std::chrono::milliseconds(0),
+                timeout - std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start));
+    }
+
+    log_debug("create new connection");
+
+    return checkedOut(create(), start);
+}
+
+void ConnectionPool::releaseSlot()
+{
+    if (_waiters.empty())
+    {
+        --_size;
+    }
+    else
+    {
+        // pass the permission to open a connection to the next thread
+        Waiter* waiter = _waiters.front();
+        _waiters.pop_front();
+        waiter->ready = true;
+        waiter->cond.notify_one();
     }
+}
 
-    if (_connectionPool.empty())
+void ConnectionPool::putIdle(IdleConnection& idle)
+{
+    if (!_waiters.empty())
     {
-        c = tntdb::connect(_url, _username, _password).getImpl();
+        Waiter* waiter = _waiters.front();
+        _waiters.pop_front();
+        waiter->connection = std::move(idle.connection);
+        waiter->ready = true;
+        waiter->cond.notify_one();
+    }
+    else if (_maxSpare == 0 || _connectionPool.size() < _maxSpare)
+    {
+        _connectionPool.push_back(std::move(idle));
     }
     else
     {
-        c = std::move(_connectionPool.back());
-        _connectionPool.pop_back();
+        log_debug("don't reuse connection " << idle.connection << " max spare " << _maxSpare << " reached");
+        --_size;
     }
-    
-    return Connection(std::make_shared<PoolConnection>(std::move(c), *this));
 }
 
 void ConnectionPool::put(std::shared_ptr<IConnection>& conn)
 {
+    ThreadCache* cache = _threadCache && _maxSize == 0 ? ThreadCache::get() : 0;
+    if (cache && cache->put(this, conn))
+        return;
+
+    IdleConnection idle;
+    idle.connection = conn;
+    idle.lastUsed = Clock::now();
+
     std::lock_guard<std::mutex> lock(_mutex);
+    putIdle(idle);
+}
 
-    if (_maxSpare == 0 || _connectionPool.size() < _maxSpare)
-        _connectionPool.emplace_back(conn);
-    else
-        log_debug("don't reuse connection " << conn << " max spare " << _maxSpare << " reached");
+void ConnectionPool::release()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    releaseSlot();
+    startRefill();
+}
+
+void ConnectionPool::openIdle()
+{
+    IdleConnection idle;
+    idle.connection = create();
+    idle.lastUsed = Clock::now();
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    putIdle(idle);
+}
+
+bool ConnectionPool::needsRefill() const
+{
+    return !_stopping
+        && _connectionPool.size() < _minIdle
+        && (_maxSpare == 0 || _connectionPool.size() < _maxSpare);
+}
+
+void ConnectionPool::startRefill()
+{
+    if (_refilling || !needsRefill())
+        return;
+
+    // a previous refill thread has already finished, when _refilling is false
+    if (_refillThread.joinable())
+        _refillThread.join();
+
+    log_debug("start refilling pool; " << _connectionPool.size() << " idle connections, min " << _minIdle);
+
+    _refilling = true;
+    _refillThread = std::thread(&ConnectionPool::refill, this);
+}
+
+void ConnectionPool::refill()
+{
+    while (true)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (!needsRefill() || !reserveSlot())
+            {
+                _refilling = false;
+                return;
+            }
+        }
+
+        try
+        {
+            openIdle();
+        }
+        catch (const std::exception& e)
+        {
+            log_warn("failed to refill connection pool for " << _url << ": " << e.what());
+            std::lock_guard<std::mutex> lock(_mutex);
+            _refilling = false;
+            return;
+        }
+    }
+}
+
+unsigned ConnectionPool::warmup(unsigned n)
+{
+    unsigned count;
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        count = _connectionPool.size() < n ? n - _connectionPool.size() : 0;
+    }
+
+    log_debug("warmup; open up to " << count << " connections");
+
+    std::atomic<unsigned> opened(0);
+    std::vector<std::thread> threads;
+    threads.reserve(count);
+
+    // A slot is reserved for each thread just before it is started, so
+    // that no slot is left reserved, when a thread can't be started.
+    for (unsigned i = 0; i < count; ++i)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (!reserveSlot())
+                break;
+        }
+
+        try
+        {
+            threads.emplace_back([this, &opened] {
+                try
+                {
+                    openIdle();
+                    ++opened;
+                }
+                catch (const std::exception& e)
+                {
+                    log_warn("failed to open connection to " << _url << ": " << e.what());
+                }
+            });
+        }
+        catch (const std::system_error& e)
+        {
+            log_warn("failed to start thread for warmup of " << _url << ": " << e.what());
+            release();
+            break;
+        }
+    }
+
+    for (auto& thread: threads)
+        thread.join();
+
+    return opened;
+}
+
+void ConnectionPool::setMinIdle(unsigned n)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _minIdle = n;
+    startRefill();
+}
+
+void ConnectionPool::setThreadCache(bool enable)
+{
+    _threadCache = enable;
+}
+
+unsigned ConnectionPool::getMinIdle() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _minIdle;
 }
 
 void ConnectionPool::drop(unsigned keep)
 {
+    // the connections are closed after releasing the lock
+    std::deque<IdleConnection> dropped;
+
     std::lock_guard<std::mutex> lock(_mutex);
 
     if (_connectionPool.size() > keep)
-        _connectionPool.resize(keep);
+    {
+        dropped.assign(std::make_move_iterator(_connectionPool.begin()),
+                       std::make_move_iterator(_connectionPool.end() - keep));
+        _connectionPool.erase(_connectionPool.begin(), _connectionPool.end() - keep);
+        _size -= dropped.size();
+    }
+}
+
+void ConnectionPool::validateIdle()
+{
+    unsigned count;
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        count = _connectionPool.size();
+    }
+
+    // Take the least recently used connection from the front. Connections,
+    // which are still alive, are put back to the end.
+    for (; count > 0; --count)
+    {
+        IdleConnection idle;
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_connectionPool.empty())
+                break;
+
+            idle = std::move(_connectionPool.front());
+            _connectionPool.pop_front();
+        }
+
+        if (!validate(*idle.connection, validatePing))
+        {
+            log_warn("drop dead connection from pool");
+            idle.connection.reset();
+            release();
+            continue;
+        }
+
+        idle.lastUsed = Clock::now();
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        putIdle(idle);
+    }
 }
 
 void ConnectionPool::setMaxSpare(unsigned m)
 {
+    std::deque<IdleConnection> dropped;
+
     std::lock_guard<std::mutex> lock(_mutex);
 
     _maxSpare = m;
     if (_connectionPool.size() > _maxSpare)
-        _connectionPool.resize(_maxSpare);
+    {
+        dropped.assign(std::make_move_iterator(_connectionPool.begin()),
+                       std::make_move_iterator(_connectionPool.end() - _maxSpare));
+        _connectionPool.erase(_connectionPool.begin(), _connectionPool.end() - _maxSpare);
+        _size -= dropped.size();
+    }
+}
+
+unsigned ConnectionPool::getCurrentSize() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _connectionPool.size();
+}
+
+void ConnectionPool::setMaxSize(unsigned max, std::chrono::milliseconds timeout)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    _maxSize = max;
+    _timeout = timeout;
+
+    // let waiting threads open connections, when the limit was raised
+    while (!_waiters.empty() && (_maxSize == 0 || _size < _maxSize))
+    {
+        ++_size;
+        releaseSlot();
+    }
+}
+
+unsigned ConnectionPool::getMaxSize() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _maxSize;
+}
+
+std::chrono::milliseconds ConnectionPool::getTimeout() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _timeout;
+}
+
+unsigned ConnectionPool::getSize() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _size;
+}
+
+unsigned ConnectionPool::getWaiting() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _waiters.size();
+}
+
+unsigned long ConnectionPool::getWaitCount() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _waitCount;
+}
+
+unsigned long ConnectionPool::getTimeoutCount() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _timeoutCount;
+}
+
+PoolMetrics ConnectionPool::getMetrics() const
+{
+    PoolMetrics metrics;
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        metrics.idle = _connectionPool.size();
+        metrics.open = _size;
+        metrics.waiting = _waiters.size();
+        metrics.waits = _waitCount;
+        metrics.timeouts = _timeoutCount;
+    }
+
+    metrics.inUse = _inUse;
+    metrics.checkouts = _checkouts;
+    metrics.creations = _creations;
+    metrics.creationFailures = _creationFailures;
+    metrics.pings = _pings;
+    metrics.failedPings = _failedPings;
+    metrics.drops = _drops;
+    metrics.waitTime = _waitTime;
+    metrics.holdTime = _holdTime;
+
+    return metrics;
+}
+
+void ConnectionPool::setValidation(Validation validation, std::chrono::milliseconds interval)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _validation = validation;
+    _validationInterval = interval;
+}
+
+ConnectionPool::Validation ConnectionPool::getValidation() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _validation;
+}
+
+std::chrono::milliseconds ConnectionPool::getValidationInterval() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _validationInterval;
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -101,23 +800,57 @@ Connection ConnectionPools::connect(const std::string& url, const std::string& u
 {
     log_debug("ConnectionPools::connect(\"" << url << "\", \"" << username << "\", password)");
 
-    PoolsType::iterator it;
+    Connection conn;
+    if (_threadCache && PoolType::connectThreadCached(this, url, username, password, conn))
+        return conn;
+
+    PoolType& pool = getPool(url, username, password);
+    log_debug("current pool size " << pool.getCurrentSize());
+    return pool.connect();
+}
 
+ConnectionPools::PoolType& ConnectionPools::getPool(const std::string& url, const std::string& username, const std::string& password)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    PoolsType::iterator it = _pools.find(ConnectionParameter(url, username, password));
+    if (it == _pools.end())
     {
-        std::lock_guard<std::mutex> lock(_mutex);
-        it = _pools.find(ConnectionParameter(url, username, password));
-        if (it == _pools.end())
-        {
-            log_debug("create pool for url \"" << url << "\" user \"" << username << "\" with " << _maxcount << " connections");
-            std::unique_ptr<PoolType> pool(new PoolType(url, username, password, _maxcount));
-            it = _pools.emplace(ConnectionParameter(url, username, password), std::move(pool)).first;
-        }
-        else
-            log_debug("pool for url \"" << url << "\" found");
+        log_debug("create pool for url \"" << url << "\" user \"" << username << "\" with " << _maxcount << " connections");
+        std::unique_ptr<PoolType> pool(new PoolType(url, username, password, _maxcount));
+        pool->_owner = this;
+        pool->setValidation(_validation, _validationInterval);
+        pool->setMaxSize(_maxSize, _timeout);
+        pool->setMinIdle(_minIdle);
+        pool->setThreadCache(_threadCache);
+        it = _pools.emplace(ConnectionParameter(url, username, password), std::move(pool)).first;
     }
+    else
+        log_debug("pool for url \"" << url << "\" found");
+
+    return *it->second;
+}
+
+unsigned ConnectionPools::warmup(const std::string& url, const std::string& username, const std::string& password, unsigned n)
+{
+    log_debug("ConnectionPools::warmup(\"" << url << "\", \"" << username << "\", password, " << n << ')');
+    return getPool(url, username, password).warmup(n);
+}
 
-    log_debug("current pool size " << it->second->getCurrentSize());
-    return it->second->connect();
+void ConnectionPools::setThreadCache(bool enable)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _threadCache = enable;
+    for (auto it = _pools.begin(); it != _pools.end(); ++it)
+        it->second->setThreadCache(enable);
+}
+
+void ConnectionPools::setMinIdle(unsigned n)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _minIdle = n;
+    for (auto it = _pools.begin(); it != _pools.end(); ++it)
+        it->second->setMinIdle(n);
 }
 
 void ConnectionPools::drop(unsigned keep)
@@ -143,7 +876,9 @@ void ConnectionPools::drop(const std::string& url, const std::string& username,
     else
     {
         it->second->drop(keep);
-        if (it->second->getCurrentSize() == 0)
+
+        // connections in use keep a reference to their pool
+        if (it->second->getSize() == 0)
         {
             log_debug("delete connectionpool for url \"" << url << "\", username \"" << username << '"');
             _pools.erase(it);
@@ -160,6 +895,15 @@ unsigned ConnectionPools::getCurrentSize(const std::string& url, const std::stri
                              : it->second->getCurrentSize();
 }
 
+PoolMetrics ConnectionPools::getMetrics(const std::string& url, const std::string& username, const std::string& password) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto it = _pools.find(ConnectionParameter(url, username, password));
+    return it == _pools.end() ? PoolMetrics()
+                              : it->second->getMetrics();
+}
+
 unsigned ConnectionPools::getCurrentSize() const
 {
     std::lock_guard<std::mutex> lock(_mutex);
@@ -178,4 +922,33 @@ void ConnectionPools::setMaxSpare(unsigned m)
     for (auto it = _pools.begin(); it != _pools.end(); ++it)
         it->second->setMaxSpare(m);
 }
+
+void ConnectionPools::setMaxSize(unsigned max, std::chrono::milliseconds timeout)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _maxSize = max;
+    _timeout = timeout;
+    for (auto it = _pools.begin(); it != _pools.end(); ++it)
+        it->second->setMaxSize(max, timeout);
+}
+
+unsigned ConnectionPools::getWaiting() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    unsigned waiting = 0;
+    for (auto it = _pools.begin(); it != _pools.end(); ++it)
+        waiting += it->second->getWaiting();
+
+    return waiting;
+}
+
+void ConnectionPools::setValidation(PoolType::Validation validation, std::chrono::milliseconds interval)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _validation = validation;
+    _validationInterval = interval;
+    for (auto it = _pools.begin(); it != _pools.end(); ++it)
+        it->second->setValidation(validation, interval);
+}
 }
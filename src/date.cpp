@@ -27,8 +27,8 @@
  */
 
 #include <tntdb/date.h>
+#include <tntdb/impl/textconv.h>
 #include <tntdb/error.h>
-#include <cctype>
 #include <sys/time.h>
 #include <time.h>
 #include <string.h>
@@ -76,66 +76,15 @@ namespace tntdb
 
   std::string Date::getIso() const
   {
-    // format YYYY-MM-DD
-    //        0....+....1
     char ret[10];
-    unsigned short n = _year;
-    ret[3] = '0' + n % 10;
-    n /= 10;
-    ret[2] = '0' + n % 10;
-    n /= 10;
-    ret[1] = '0' + n % 10;
-    n /= 10;
-    ret[0] = '0' + n % 10;
-    ret[4] = '-';
-    ret[5] = '0' + _month / 10;
-    ret[6] = '0' + _month % 10;
-    ret[7] = '-';
-    ret[8] = '0' + _day / 10;
-    ret[9] = '0' + _day % 10;
-
-    return std::string(ret, 10);
-  }
-
-  inline unsigned short getNumber2(const char* s)
-  {
-    if (!std::isdigit(s[0])
-      || !std::isdigit(s[1]))
-      throw TypeError();
-    return (s[0] - '0') * 10
-         + (s[1] - '0');
-  }
-
-  inline unsigned short getNumber4(const char* s)
-  {
-    if (!std::isdigit(s[0])
-      || !std::isdigit(s[1])
-      || !std::isdigit(s[2])
-      || !std::isdigit(s[3]))
-      throw TypeError();
-    return (s[0] - '0') * 1000
-         + (s[1] - '0') * 100
-         + (s[2] - '0') * 10
-         + (s[3] - '0');
+    return std::string(ret, textconv::formatIso(ret, *this));
   }
 
   Date Date::fromIso(const std::string& s)
   {
     Date ret;
-    const char* d = s.data();
-    try
-    {
-      if (s.size() < 10
-        || d[4] != '-'
-        || d[7] != '-')
-        throw TypeError();
-      ret.set(getNumber4(d), getNumber2(d + 5), getNumber2(d + 8));
-    }
-    catch (const TypeError&)
-    {
+    if (textconv::scanIsoDate(s.data(), s.data() + s.size(), ret) == 0)
       throw TypeError("failed to convert string \"" + s + "\" into date");
-    }
-
     return ret;
   }
 
@@ -27,8 +27,8 @@
  */
 
 #include <tntdb/datetime.h>
+#include <tntdb/impl/textconv.h>
 #include <tntdb/error.h>
-#include <cctype>
 #include <sys/time.h>
 #include <time.h>
 
@@ -64,112 +64,16 @@ namespace tntdb
 
   std::string Datetime::getIso() const
   {
-    // format YYYY-MM-DD hh:mm:ss.sss
-    //        0....+....1....+....2....+
-    char ret[25];
-    unsigned short n = _year;
-    ret[3] = '0' + n % 10;
-    n /= 10;
-    ret[2] = '0' + n % 10;
-    n /= 10;
-    ret[1] = '0' + n % 10;
-    n /= 10;
-    ret[0] = '0' + n % 10;
-    ret[4] = '-';
-    ret[5] = '0' + _month / 10;
-    ret[6] = '0' + _month % 10;
-    ret[7] = '-';
-    ret[8] = '0' + _day / 10;
-    ret[9] = '0' + _day % 10;
-    ret[10] = ' ';
-    ret[11] = '0' + _hour / 10;
-    ret[12] = '0' + _hour % 10;
-    ret[13] = ':';
-    ret[14] = '0' + _minute / 10;
-    ret[15] = '0' + _minute % 10;
-    ret[16] = ':';
-    ret[17] = '0' + _second / 10;
-    ret[18] = '0' + _second % 10;
-    ret[19] = '.';
-    n = _millis;
-    ret[22] = '0' + n % 10;
-    n /= 10;
-    ret[21] = '0' + n % 10;
-    n /= 10;
-    ret[20] = '0' + n % 10;
-
-    return std::string(ret, 23);
-  }
-
-  inline unsigned short getNumber2(const char* s)
-  {
-    if (!std::isdigit(s[0])
-      || !std::isdigit(s[1]))
-      throw TypeError();
-    return (s[0] - '0') * 10
-         + (s[1] - '0');
-  }
-
-  inline unsigned short getNumber3(const char* s)
-  {
-    if (!std::isdigit(s[0])
-      || !std::isdigit(s[1])
-      || !std::isdigit(s[2]))
-      throw TypeError();
-    return (s[0] - '0') * 100
-         + (s[1] - '0') * 10
-         + (s[2] - '0');
-  }
-
-  inline unsigned short getNumber4(const char* s)
-  {
-    if (!std::isdigit(s[0])
-      || !std::isdigit(s[1])
-      || !std::isdigit(s[2])
-      || !std::isdigit(s[3]))
-      throw TypeError();
-    return (s[0] - '0') * 1000
-         + (s[1] - '0') * 100
-         + (s[2] - '0') * 10
-         + (s[3] - '0');
+    char ret[23];
+    return std::string(ret, textconv::formatIso(ret, *this));
   }
 
   Datetime Datetime::fromIso(const std::string& s)
   {
     Datetime ret;
-    const char* d = s.data();
-    try
-    {
-      if (s.size() == 23
-        && d[4] == '-'
-        && d[7] == '-'
-        && d[10] == ' '
-        && d[13] == ':'
-        && d[16] == ':'
-        && d[19] == '.')
-      {
-        ret.set(getNumber4(d), getNumber2(d + 5), getNumber2(d + 8),
-                getNumber2(d + 11), getNumber2(d + 14), getNumber2(d + 17),
-                getNumber3(d + 20));
-      }
-      else if (s.size() == 19
-        && d[4] == '-'
-        && d[7] == '-'
-        && d[10] == ' '
-        && d[13] == ':'
-        && d[16] == ':')
-      {
-        ret.set(getNumber4(d), getNumber2(d + 5), getNumber2(d + 8),
-                getNumber2(d + 11), getNumber2(d + 14), getNumber2(d + 17));
-      }
-      else
-        throw TypeError();
-    }
-    catch (const TypeError&)
-    {
+    const char* end = s.data() + s.size();
+    if (textconv::scanIsoDatetime(s.data(), end, ret) != end)
       throw TypeError("failed to convert string \"" + s + "\" into datetime");
-    }
-
     return ret;
   }
 }
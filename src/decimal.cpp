@@ -27,13 +27,15 @@
  */
 
 #include <tntdb/decimal.h>
-#include <cctype>
+#include <tntdb/impl/textconv.h>
 #include <stdexcept>
 #include <iostream>
-#include <iomanip>
-#include <cxxtools/convert.h>
+#include <algorithm>
+#include <vector>
 #include <cxxtools/log.h>
 #include <cmath>
+#include <cstdio>
+#include <cstring>
 
 log_define("tntdb.decimal")
 
@@ -41,377 +43,578 @@ namespace tntdb
 {
 namespace
 {
-    void throwConversionError(const std::string& s)
+    typedef Decimal::CoefficientType Coefficient;
+
+    // number of decimal digits, which always fit into a coefficient
+    const unsigned maxDigits = sizeof(Coefficient) >= 16 ? 38 : 19;
+    // maximum number of characters of a formatted coefficient
+    const unsigned maxCoefficientLength = maxDigits + 2;
+    const Coefficient maxCoefficient = ~static_cast<Coefficient>(0);
+
+    struct PowersOf10
     {
-        log_warn("failed to convert \"" << s << "\" to decimal");
-        throw std::runtime_error("failed to convert \"" + s + "\" to decimal");
+        Coefficient values[maxDigits + 1];
+
+        PowersOf10()
+        {
+            values[0] = 1;
+            for (unsigned n = 1; n <= maxDigits; ++n)
+                values[n] = values[n - 1] * 10;
+        }
+    };
+
+    inline Coefficient pow10(unsigned n)
+    {
+        static const PowersOf10 powers;
+        return powers.values[n];
     }
 
-    void throwOverflowError(const Decimal& d)
+    unsigned numDigits(Coefficient c)
     {
-        log_warn("overflow when trying to read integer from decimal " << d.toString());
-        throw std::overflow_error("overflow when trying to read integer from decimal " + d.toString());
+        unsigned n = 1;
+        while (n <= maxDigits && c >= pow10(n))
+            ++n;
+        return n;
     }
 
-    int stringCompareIgnoreCase(const char* const& s1, const char* const& s2)
+    char* formatCoefficient(char* buf, Coefficient c)
     {
-        const char* it1 = s1;
-        const char* it2 = s2;
-        while (*it1 && *it2)
+        if (c <= std::numeric_limits<unsigned long long>::max())
+            return textconv::format(buf, static_cast<unsigned long long>(c));
+
+        // format in chunks of 19 digits to keep the number of wide
+        // divisions low
+        static const unsigned long long chunk = 10000000000000000000ULL;
+        buf = formatCoefficient(buf, c / chunk);
+        unsigned long long low = static_cast<unsigned long long>(c % chunk);
+        for (int n = 18; n >= 0; --n)
         {
-                if (*it1 != *it2)
-                {
-                        char c1 = std::toupper(*it1);
-                        char c2 = std::toupper(*it2);
-                        if (c1 < c2)
-                                return -1;
-                        else if (c2 < c1)
-                                return 1;
-                }
-                ++it1;
-                ++it2;
+            buf[n] = static_cast<char>('0' + low % 10);
+            low /= 10;
+        }
+
+        return buf + 19;
+    }
+
+    // Multiplies c with 10^n; returns false on overflow.
+    bool alignCoefficient(Coefficient& c, long n)
+    {
+        if (n == 0)
+            return true;
+
+        if (n > static_cast<long>(maxDigits))
+            return false;
+
+        Coefficient p = pow10(n);
+        if (numDigits(c) + n > maxDigits && c > maxCoefficient / p)
+            return false;
+
+        c *= p;
+        return true;
+    }
+
+    // Reads the digits into c; returns false on overflow.
+    bool accumulate(const char* begin, const char* end, Coefficient& ret)
+    {
+        if (end - begin > static_cast<long>(maxDigits) + 1)
+            return false;
+
+        // most values fit into 64 bits
+        unsigned long long l = 0;
+        const char* p = begin;
+        for ( ; p != end && p - begin < 19; ++p)
+            l = l * 10 + (*p - '0');
+
+        Coefficient c = l;
+        for ( ; p != end; ++p)
+        {
+            unsigned d = *p - '0';
+            if (p - begin == static_cast<long>(maxDigits) && c > (maxCoefficient - d) / 10)
+                return false;
+            c = c * 10 + d;
+        }
+
+        ret = c;
+        return true;
+    }
+
+    // Arbitrary precision arithmetic on decimal digits. The values are
+    // non negative integers without leading zeros.
+
+    int compareDigits(const std::string& a, const std::string& b)
+    {
+        if (a.size() != b.size())
+            return a.size() < b.size() ? -1 : 1;
+        return a.compare(b);
+    }
+
+    std::string addDigits(const std::string& a, const std::string& b)
+    {
+        std::string ret(std::max(a.size(), b.size()) + 1, '0');
+        unsigned carry = 0;
+        for (std::string::size_type n = 0; n < ret.size(); ++n)
+        {
+            unsigned d = carry;
+            if (n < a.size())
+                d += a[a.size() - n - 1] - '0';
+            if (n < b.size())
+                d += b[b.size() - n - 1] - '0';
+            ret[ret.size() - n - 1] = static_cast<char>('0' + d % 10);
+            carry = d / 10;
+        }
+        return ret;
+    }
+
+    // a must not be less than b
+    std::string subDigits(const std::string& a, const std::string& b)
+    {
+        std::string ret(a.size(), '0');
+        int borrow = 0;
+        for (std::string::size_type n = 0; n < a.size(); ++n)
+        {
+            int d = a[a.size() - n - 1] - '0' - borrow;
+            if (n < b.size())
+                d -= b[b.size() - n - 1] - '0';
+            borrow = d < 0;
+            if (borrow)
+                d += 10;
+            ret[a.size() - n - 1] = static_cast<char>('0' + d);
         }
+        return ret;
+    }
+
+    std::string mulDigits(const std::string& a, const std::string& b)
+    {
+        std::vector<unsigned> r(a.size() + b.size());
+        for (std::string::size_type i = a.size(); i > 0; --i)
+        {
+            unsigned carry = 0;
+            unsigned da = a[i - 1] - '0';
+            for (std::string::size_type j = b.size(); j > 0; --j)
+            {
+                unsigned d = r[i + j - 1] + da * (b[j - 1] - '0') + carry;
+                r[i + j - 1] = d % 10;
+                carry = d / 10;
+            }
+            r[i - 1] += carry;
+        }
+
+        std::string ret(r.size(), '0');
+        for (std::string::size_type n = 0; n < r.size(); ++n)
+            ret[n] = static_cast<char>('0' + r[n]);
+        return ret;
+    }
 
-        return *it1 ? 1
-                                : *it2 ? -1 : 0;
+    inline bool isDigit(char ch)
+    {
+        return ch >= '0' && ch <= '9';
     }
 
-    void stripZeros(std::string& s)
+    inline bool isSpace(char ch)
     {
-        std::string::size_type pos;
-        for (pos = s.size(); pos > 1; --pos)
+        return ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r' || ch == '\f' || ch == '\v';
+    }
+
+    // compares the range with a lower case string ignoring case
+    bool equalsIgnoreCase(const char* begin, const char* end, const char* s)
+    {
+        for ( ; begin != end && *s; ++begin, ++s)
         {
-            if (s[pos - 1] != '0')
-                break;
+            char ch = *begin;
+            if (ch >= 'A' && ch <= 'Z')
+                ch = static_cast<char>(ch - 'A' + 'a');
+            if (ch != *s)
+                return false;
         }
-        s.erase(pos);
+
+        return begin == end && *s == '\0';
+    }
+
+    void throwConversionError(const char* begin, const char* end)
+    {
+        std::string s(begin, end);
+        log_warn("failed to convert \"" << s << "\" to decimal");
+        throw std::runtime_error("failed to convert \"" + s + "\" to decimal");
+    }
+
+    void throwOverflowError(const Decimal& d)
+    {
+        log_warn("overflow when trying to read integer from decimal " << d.toString());
+        throw std::overflow_error("overflow when trying to read integer from decimal " + d.toString());
     }
 }
 
+    // Collects the characters of a decimal value and parses them on finish.
+    // Kept for compatibility; the parsing is done by Decimal::parse.
     class Decimal::Parser
     {
-            enum {
-                state_0,
-                state_man0,
-                state_man,
-                state_fract0,
-                state_fract,
-                state_exp0,
-                state_exp1,
-                state_exp,
-                state_special,
-                state_end
-            } _state;
-
             Decimal* _value;
             std::string _str;
-            short _eoff;
-            bool _eneg;
 
         public:
             Parser()
-                : _value(0),
-                    _eoff(0),
-                    _eneg(false)
+                : _value(0)
             { }
 
-            void begin(Decimal& d);
-            void parse(char ch);
-            void finish();
+            void begin(Decimal& d)
+            {
+                _value = &d;
+                _str.clear();
+            }
+
+            void parse(char ch)
+            {
+                _str += ch;
+            }
+
+            void finish()
+            {
+                _value->parse(_str.data(), _str.data() + _str.size());
+            }
     };
 
-    void Decimal::Parser::begin(Decimal& d)
+    Decimal::Decimal()
+        : _coefficient(0),
+            _scale(0),
+            _kind(finite),
+            _negative(false)
+    {
+    }
+
+    Decimal::Decimal(float value)
+        : _coefficient(0),
+            _scale(0),
+            _kind(finite),
+            _negative(false)
+    {
+        char buf[textconv::maxFloatLength];
+        parse(buf, textconv::format(buf, value));
+    }
+
+    Decimal::Decimal(double value)
+        : _coefficient(0),
+            _scale(0),
+            _kind(finite),
+            _negative(false)
+    {
+        char buf[textconv::maxFloatLength];
+        parse(buf, textconv::format(buf, value));
+    }
+
+    Decimal::Decimal(long double value)
+        : _coefficient(0),
+            _scale(0),
+            _kind(finite),
+            _negative(false)
     {
-        _state = state_0;
-        _value = &d;
-        _str.clear();
-        _eoff = 0;
-        _eneg = false;
-        d._mantissa.clear();
-        d._exponent = 0;
-        d._negative = false;
+        char buf[64];
+        int len = std::snprintf(buf, sizeof(buf), "%.*Lg", std::numeric_limits<long double>::digits10, value);
+        parse(buf, buf + len);
     }
 
-    void Decimal::Parser::parse(char ch)
+    Decimal::Decimal(const std::string& value)
+        : _coefficient(0),
+            _scale(0),
+            _kind(finite),
+            _negative(false)
     {
-        _str += ch;
-        switch (_state)
+        parse(value.data(), value.data() + value.size());
+    }
+
+    Decimal::Decimal(const char* begin, const char* end)
+        : _coefficient(0),
+            _scale(0),
+            _kind(finite),
+            _negative(false)
+    {
+        parse(begin, end);
+    }
+
+    void Decimal::parse(const char* begin, const char* end)
+    {
+        const char* b = begin;
+        const char* e = end;
+        while (b != e && isSpace(*b))
+            ++b;
+        while (e != b && isSpace(e[-1]))
+            --e;
+
+        _coefficient = 0;
+        _digits.clear();
+        _scale = 0;
+        _kind = finite;
+        _negative = false;
+        _mantissa.reset();
+
+        bool negative = false;
+        if (b != e && (*b == '+' || *b == '-'))
+            negative = *b++ == '-';
+
+        if (b != e && !isDigit(*b) && *b != '.')
         {
-            case state_0:
-                if (ch == '+')
-                {
-                    _state = state_man0;
-                }
-                else if (ch == '-')
-                {
-                    _value->_negative = true;
-                    _state = state_man0;
-                }
-                else if (ch == '.')
-                {
-                    _state = state_fract0;
-                }
-                else if (ch == '0')
-                {
-                    _state = state_man;
-                }
-                else if (ch >= '1' && ch <= '9')
-                {
-                    _value->_mantissa = ch;
-                    _state = state_man;
-                }
-                else if (std::isalpha(ch))
-                    _state = state_special;
-                else if (!std::isspace(ch))
-                    throwConversionError(_str);
-                break;
-
-            case state_man0:
-                if (ch == '.')
-                {
-                    _state = state_fract0;
-                }
-                else if (ch == '0')
-                {
-                    _state = state_man;
-                }
-                else if (ch >= '1' && ch <= '9')
-                {
-                    _value->_mantissa = ch;
-                    _state = state_man;
-                }
-                else if (std::isalpha(ch))
-                    _state = state_special;
-                else
-                    throwConversionError(_str);
-                break;
-
-            case state_man:
-                if (ch == '0' && _value->_mantissa.empty())
-                {
-                }
-                else if (ch >= '0' && ch <= '9')
-                {
-                    _value->_mantissa += ch;
-                }
-                else
-                {
-                    _eoff = _value->_mantissa.size();
+            if (equalsIgnoreCase(b, e, "inf") || equalsIgnoreCase(b, e, "infinity"))
+            {
+                _kind = infinite;
+                _negative = negative;
+            }
+            else if (equalsIgnoreCase(b, e, "nan"))
+                _kind = notANumber;
+            else
+                throwConversionError(begin, end);
 
-                    if (ch == '.')
-                    {
-                        _state = _value->_mantissa.empty() ? state_fract0 : state_fract;
-                    }
-                    else if (ch == 'e' || ch == 'E')
-                    {
-                        _state = state_exp0;
-                    }
-                    else if (std::isspace(ch))
-                        _state = state_end;
-                    else
-                        throwConversionError(_str);
-                }
-                break;
+            return;
+        }
 
-            case state_fract0:
-                if (ch == '0')
-                {
-                    --_eoff;
-                    break;
-                }
-                else if (ch == 'e' || ch == 'E')
-                {
-                    if (_eoff == 0)
-                        throwConversionError(_str);
+        const char* intBegin = b;
+        while (b != e && isDigit(*b))
+            ++b;
+        const char* intEnd = b;
 
-                    _value->_mantissa = '0';
-                    _eoff = 0;
-                    _state = state_exp0;
-                    break;
-                }
+        const char* fracBegin = b;
+        const char* fracEnd = b;
+        if (b != e && *b == '.')
+        {
+            fracBegin = ++b;
+            while (b != e && isDigit(*b))
+                ++b;
+            fracEnd = b;
+        }
 
-                _state = state_fract;
-                // nobreak
+        if (intBegin == intEnd && fracBegin == fracEnd)
+            throwConversionError(begin, end);
 
-            case state_fract:
-                if (ch >= '0' && ch <= '9')
-                {
-                    _value->_mantissa += ch;
-                }
-                else if (ch == 'e' || ch == 'E')
-                {
-                    _state = state_exp0;
-                }
-                else if (std::isspace(ch))
-                    _state = state_end;
-                else
-                    throwConversionError(_str);
-                break;
-
-            case state_exp0:
-                if (ch == '+')
-                {
-                    _state = state_exp1;
-                    break;
-                }
-                else if (ch == '-')
-                {
-                    _eneg = true;
-                    break;
-                }
+        long exp = 0;
+        if (b != e && (*b == 'e' || *b == 'E'))
+        {
+            ++b;
+            bool eneg = false;
+            if (b != e && (*b == '+' || *b == '-'))
+                eneg = *b++ == '-';
 
-                _state = state_exp1;
+            if (b == e || !isDigit(*b))
+                throwConversionError(begin, end);
 
-                // nobreak
+            for ( ; b != e && isDigit(*b); ++b)
+            {
+                exp = exp * 10 + (*b - '0');
+                if (exp > 10 * std::numeric_limits<short>::max())
+                    throw std::overflow_error("overflow error when converting \"" + std::string(begin, end) + "\" to decimal");
+            }
 
-            case state_exp1:
-            case state_exp:
-                if (ch >= '0' && ch <= '9')
-                {
-                    if (_value->_exponent > (std::numeric_limits<short>::max() - (ch - '0') / 10))
-                        throw std::overflow_error("overflow error when converting \"" + _str + "\" to decimal");
+            if (eneg)
+                exp = -exp;
+        }
 
-                    _value->_exponent = _value->_exponent * 10 + (ch - '0');
-                    _state = state_exp;
-                }
-                else if (std::isspace(ch))
-                    _state = state_end;
-                else
-                    throwConversionError(_str);
-                break;
+        if (b != e)
+            throwConversionError(begin, end);
 
-            case state_special:
-                if (_str.size() > 4)
-                    throwConversionError(_str);
+        while (intBegin != intEnd && *intBegin == '0')
+            ++intBegin;
+        while (fracEnd != fracBegin && fracEnd[-1] == '0')
+            --fracEnd;
 
-                if (std::isalpha(ch) && _str.size() >= 3)
-                {
-                    if (stringCompareIgnoreCase(_str.c_str(), "inf") == 0
-                     || stringCompareIgnoreCase(_str.c_str(), "+inf") == 0)
-                    {
-                        _value->_exponent = std::numeric_limits<short>::max();
-                        _state = state_end;
-                    }
-                    else if (stringCompareIgnoreCase(_str.c_str(), "-inf") == 0)
-                    {
-                        _value->_negative = true;
-                        _value->_exponent = std::numeric_limits<short>::max();
-                        _state = state_end;
-                    }
-                    else if (stringCompareIgnoreCase(_str.c_str(), "nan") == 0)
-                    {
-                        _value->_exponent = 0;
-                        _state = state_end;
-                    }
-                }
+        long scale = exp - (fracEnd - fracBegin);
 
-                break;
+        if (fracBegin == fracEnd)
+            _setDigits(intBegin, intEnd, exp, negative);
+        else if (intBegin == intEnd)
+            _setDigits(fracBegin, fracEnd, scale, negative);
+        else if ((intEnd - intBegin) + (fracEnd - fracBegin) <= static_cast<long>(maxDigits))
+        {
+            Coefficient c;
+            accumulate(intBegin, intEnd, c);
+            for (const char* p = fracBegin; p != fracEnd; ++p)
+                c = c * 10 + (*p - '0');
+            _coefficient = c;
+            _negative = negative;
+            _normalize(scale);
+        }
+        else
+        {
+            std::string digits(intBegin, intEnd);
+            digits.append(fracBegin, fracEnd);
+            _setDigits(digits.data(), digits.data() + digits.size(), scale, negative);
+        }
+    }
 
-            case state_end:
-                if (!std::isspace(ch))
-                    throwConversionError(_str);
+    void Decimal::_setDigits(const char* begin, const char* end, long scale, bool negative)
+    {
+        while (begin != end && *begin == '0')
+            ++begin;
+        while (end != begin && end[-1] == '0')
+        {
+            --end;
+            ++scale;
         }
+
+        _kind = finite;
+        _negative = negative;
+        _digits.clear();
+        _coefficient = 0;
+
+        if (!accumulate(begin, end, _coefficient))
+            _digits.assign(begin, end);
+
+        _normalize(scale);
     }
 
-    void Decimal::Parser::finish()
+    void Decimal::_normalize(long scale)
     {
-        if (_state == state_0 || _state == state_man0 || _state == state_exp0 || _state == state_exp1 || _state == state_special)
-            throwConversionError(_str);
+        _mantissa.reset();
 
-        if (_state == state_man)
+        if (_digits.empty())
         {
-            if (_value->_mantissa.empty())
-                _value->_mantissa = '0';
+            if (_coefficient == 0)
+            {
+                _scale = 0;
+                _negative = false;
+                return;
+            }
+
+            if (_coefficient <= std::numeric_limits<unsigned long long>::max())
+            {
+                unsigned long long c = static_cast<unsigned long long>(_coefficient);
+                while (c % 10 == 0)
+                {
+                    c /= 10;
+                    ++scale;
+                }
+                _coefficient = c;
+            }
             else
-                _eoff = _value->_mantissa.size();
+            {
+                while (_coefficient % 10 == 0)
+                {
+                    _coefficient /= 10;
+                    ++scale;
+                }
+            }
         }
-        else if (_state == state_end && _value->_mantissa.empty())
+        else
         {
-            return;
-        }
+            std::string::size_type n = _digits.find_last_not_of('0');
+            if (n == std::string::npos)
+            {
+                _digits.clear();
+                _coefficient = 0;
+                _scale = 0;
+                _negative = false;
+                return;
+            }
 
-        if (_eneg)
-            _value->_exponent = -_value->_exponent;
+            scale += _digits.size() - n - 1;
+            _digits.erase(n + 1);
+            _digits.erase(0, _digits.find_first_not_of('0'));
 
-        _value->_exponent += _eoff;
+            if (accumulate(_digits.data(), _digits.data() + _digits.size(), _coefficient))
+                _digits.clear();
+        }
 
-        stripZeros(_value->_mantissa);
+        if (scale < std::numeric_limits<short>::min()
+          || scale + static_cast<long>(_numDigits()) > std::numeric_limits<short>::max())
+            throw std::overflow_error("decimal exponent out of range");
 
-        if (_value->_mantissa.empty())
-        {
-            _value->_mantissa = "0";
-            _value->_exponent = 0;
-        }
+        _scale = static_cast<short>(scale);
     }
 
-    Decimal::Decimal()
-        : _mantissa("0"),
-            _exponent(0),
-            _negative(false)
+    unsigned Decimal::_numDigits() const
     {
+        return _digits.empty() ? numDigits(_coefficient)
+                               : static_cast<unsigned>(_digits.size());
     }
 
-    Decimal::LongType Decimal::_getInteger(LongType min, LongType max, short exponent) const
+    char* Decimal::_formatCoefficient(char* buf) const
     {
-        log_debug("getInteger; min=" << min << " max=" << max << " value=" << getDouble());
+        if (_digits.empty())
+            return formatCoefficient(buf, _coefficient);
+        return std::copy(_digits.begin(), _digits.end(), buf);
+    }
 
-        if (!negative())
-            return static_cast<LongType>(_getUnsigned(static_cast<UnsignedLongType>(max), exponent));
+    std::string Decimal::_coefficientDigits() const
+    {
+        if (!_digits.empty())
+            return _digits;
 
-        if (isPositiveInfinity() || isNegativeInfinity() || isNaN())
-            throwOverflowError(*this);
+        char buf[maxCoefficientLength];
+        return std::string(buf, formatCoefficient(buf, _coefficient));
+    }
 
-        // TODO check for overflow:
-        short exp = _exponent + exponent;
+    const std::string& Decimal::mantissa() const
+    {
+        // The digits are created on first use. They are published atomically,
+        // since const methods may be called concurrently.
+        std::shared_ptr<const std::string> m = std::atomic_load(&_mantissa);
+        if (!m)
+        {
+            std::shared_ptr<const std::string> digits = std::make_shared<const std::string>(
+                _kind == finite ? _coefficientDigits() : std::string());
+            if (std::atomic_compare_exchange_strong(&_mantissa, &m, digits))
+                m = digits;
+        }
 
-        if (exp < 0)
+        return *m;
+    }
+
+    short Decimal::exponent() const
+    {
+        if (_kind == infinite)
+            return std::numeric_limits<short>::max();
+        if (_kind == notANumber || isZero())
             return 0;
+        return static_cast<short>(_scale + _numDigits());
+    }
 
-        if (exp == 0)
-            return !_mantissa.empty() && _mantissa[0] >= '5' ? -1 : 0;
+    Decimal::UnsignedLongType Decimal::_getMagnitude(UnsignedLongType max, short exponent) const
+    {
+        if (_kind != finite)
+            throwOverflowError(*this);
+
+        long s = static_cast<long>(_scale) + exponent;
 
-        LongType ret = 0;
-        std::string::size_type n;
-        for (n = 0; exp - n > 0; ++n)
+        if (_digits.empty())
         {
-            LongType d = n < _mantissa.size() ? (_mantissa[n] - '0') : 0;
+            Coefficient ret = _coefficient;
 
-            if (ret < (min + d) / 10)
-                throwOverflowError(*this);
+            if (ret == 0)
+                return 0;
 
-            ret = ret * 10 - d;
-        }
+            if (s > 0)
+            {
+                if (!alignCoefficient(ret, s))
+                    throwOverflowError(*this);
+            }
+            else if (s < -static_cast<long>(maxDigits))
+            {
+                ret = 0;
+            }
+            else if (s < 0)
+            {
+                Coefficient p = pow10(-s);
+                ret = _coefficient / p;
+                if (_coefficient % p >= p / 2)
+                    ++ret;
+            }
 
-        if (n < _mantissa.size() && _mantissa[n] >= '5')
-        {
-            if (ret == min)
+            if (ret > max)
                 throwOverflowError(*this);
-            --ret;
-        }
-
-        return ret;
-    }
-
-    Decimal::UnsignedLongType Decimal::_getUnsigned(UnsignedLongType max, short exponent) const
-    {
-        log_debug("getUnsigned; max=" << max << " value=" << getDouble());
 
-        if (negative() || isPositiveInfinity() || isNegativeInfinity() || isNaN())
-            throwOverflowError(*this);
+            return static_cast<UnsignedLongType>(ret);
+        }
 
-        short exp = _exponent + exponent;
+        // number of digits before the decimal point
+        long exp = s + static_cast<long>(_digits.size());
 
         if (exp < 0)
             return 0;
 
         if (exp == 0)
-            return !_mantissa.empty() && _mantissa[0] >= '5' ? 1 : 0;
+            return _digits[0] >= '5' ? 1 : 0;
 
         UnsignedLongType ret = 0;
-        std::string::size_type n;
-        for (n = 0; exp - n > 0; ++n)
+        long n;
+        for (n = 0; n < exp; ++n)
         {
-            UnsignedLongType d = n < _mantissa.size() ? (_mantissa[n] - '0') : 0;
+            UnsignedLongType d = n < static_cast<long>(_digits.size()) ? (_digits[n] - '0') : 0;
 
             if (ret > (max - d) / 10)
                 throwOverflowError(*this);
@@ -419,7 +622,7 @@ namespace
             ret = ret * 10 + d;
         }
 
-        if (n < _mantissa.size() && _mantissa[n] >= '5')
+        if (n < static_cast<long>(_digits.size()) && _digits[n] >= '5')
         {
             if (ret == max)
                 throwOverflowError(*this);
@@ -429,105 +632,40 @@ namespace
         return ret;
     }
 
-    template <typename Float>
-    void _setDouble(std::string& mantissa, short& exponent, bool& negative, Float value)
+    Decimal::LongType Decimal::_getInteger(LongType min, LongType max, short exponent) const
     {
-        if (value == 0)
-        {
-            negative = false;
-            mantissa = "0";
-            exponent = 0;
-        }
-        else if (value == 1)    // because it is so common
-        {
-            negative = false;
-            mantissa = "1";
-            exponent = 1;
-        }
-        else if (value == std::numeric_limits<Float>::infinity())
-        {
-            negative = false;
-            exponent = std::numeric_limits<short>::max();
-        }
-        else if (value == -std::numeric_limits<Float>::infinity())
-        {
-            negative = true;
-            exponent = std::numeric_limits<short>::max();
-        }
-        else if (value != value) // check for nan
-        {
-            negative = false;
-            exponent = 0;
-        }
-        else
-        {
-            Float v = value;
-            negative = v < 0;
-            if (negative)
-                v = -v;
-
-            exponent = static_cast<short>(std::floor(std::log10(v))) + 1;
-
-            if (exponent > std::numeric_limits<Float>::max_exponent10)
-            {
-                v /= 10;
-                v /= std::pow(static_cast<Float>(10), static_cast<int>(exponent - 1));
-            }
-            else if (exponent < -std::numeric_limits<Float>::max_exponent10)
-            {
-                v *= 10;
-                v /= std::pow(static_cast<Float>(10), static_cast<int>(exponent + 1));
-            }
-            else
-                v /= std::pow(static_cast<Float>(10), static_cast<int>(exponent));
-
-            for (int n = 0; n < std::numeric_limits<Float>::digits10; ++n)
-            {
-                unsigned short d = static_cast<unsigned short>(v * 10);
-                v = v * 10 - d;
-                mantissa += static_cast<char>(d + '0');
-            }
-
-            unsigned short d = static_cast<unsigned short>(v * 10);
-            if (d >= 5)
-            {
-                while (!mantissa.empty() && mantissa.back() == '9')
-                    mantissa.pop_back();
-                if (mantissa.empty())
-                    mantissa = "0";
-                else
-                    ++mantissa[mantissa.size()-1];
-            }
-
-            stripZeros(mantissa);
-        }
+        if (!_negative)
+            return static_cast<LongType>(_getMagnitude(static_cast<UnsignedLongType>(max), exponent));
 
-        log_debug("double value=" << value << " => negative=" << negative << " mantissa=" << mantissa << " exponent=" << exponent);
+        UnsignedLongType ret = _getMagnitude(static_cast<UnsignedLongType>(-(min + 1)) + 1, exponent);
+        return ret == 0 ? 0 : -static_cast<LongType>(ret - 1) - 1;
     }
 
-    Decimal::Decimal(float value)
-    { _setDouble(_mantissa, _exponent, _negative, value); }
-
-    Decimal::Decimal(double value)
-    { _setDouble(_mantissa, _exponent, _negative, value); }
-
-    Decimal::Decimal(long double value)
-    { _setDouble(_mantissa, _exponent, _negative, value); }
-
-    Decimal::Decimal(const std::string& value)
-        : _exponent(0),
-            _negative(false)
+    Decimal::UnsignedLongType Decimal::_getUnsigned(UnsignedLongType max, short exponent) const
     {
-        Parser parser;
-
-        parser.begin(*this);
+        if (_negative)
+            throwOverflowError(*this);
 
-        for (std::string::const_iterator it = value.begin(); it != value.end(); ++it)
-            parser.parse(*it);
+        return _getMagnitude(max, exponent);
+    }
 
-        parser.finish();
+    void Decimal::_setInteger(LongType l, short exponent)
+    {
+        _kind = finite;
+        _digits.clear();
+        _negative = l < 0;
+        _coefficient = _negative ? static_cast<UnsignedLongType>(-(l + 1)) + 1
+                                 : static_cast<UnsignedLongType>(l);
+        _normalize(exponent);
+    }
 
-        log_debug("string value \"" << value << "\" => negative=" << _negative << " mantissa=" << _mantissa << " exponent=" << _exponent);
+    void Decimal::_setUnsigned(UnsignedLongType l, short exponent)
+    {
+        _kind = finite;
+        _digits.clear();
+        _negative = false;
+        _coefficient = l;
+        _normalize(exponent);
     }
 
     long double Decimal::getDouble() const
@@ -541,87 +679,217 @@ namespace
         if (isNaN())
             return std::numeric_limits<long double>::quiet_NaN();
 
-        if (_mantissa == "0")
-            return 0;
-
-        if (!_negative && _mantissa == "1" && _exponent == 1)    // because it is so common
-            return 1;
+        long double ret;
+        int scale = _scale;
 
-        long double ret = 0;
-        long double mul = 1;
-        for (std::string::const_iterator it = _mantissa.begin(); it != _mantissa.end(); ++it)
+        if (_digits.empty())
         {
-            mul /= 10;
-            ret += (*it - '0') * mul;
+            ret = static_cast<long double>(_coefficient);
         }
-
-        if (_exponent == std::numeric_limits<long double>::max_exponent10 + 1)
+        else
         {
-            ret *= std::pow(static_cast<long double>(10), static_cast<int>(_exponent - 1));
-            ret *= 10;
-            if (ret == std::numeric_limits<long double>::infinity())
-                ret = std::numeric_limits<long double>::max();
+            // the leading digits are enough for the precision of long double
+            std::string::size_type n = std::min(_digits.size(), std::string::size_type(36));
+            ret = 0;
+            for (std::string::size_type i = 0; i < n; ++i)
+                ret = ret * 10 + (_digits[i] - '0');
+            scale += static_cast<int>(_digits.size() - n);
         }
-        else if (_exponent == std::numeric_limits<long double>::min_exponent10 - 1)
+
+        if (ret == 0)
+            return 0;
+
+        // apply the scale in steps, so that the power of 10 does not
+        // overflow while the result is still in range
+        while (scale > 256)
         {
-            ret *= std::pow(static_cast<long double>(10), static_cast<int>(_exponent + 1));
-            ret /= 10;
-            if (ret == -std::numeric_limits<long double>::infinity())
-                ret = std::numeric_limits<long double>::min();
+            ret *= 1e256L;
+            scale -= 256;
         }
-        else
+
+        while (scale < -256)
         {
-            ret *= std::pow(static_cast<long double>(10), static_cast<int>(_exponent));
+            ret /= 1e256L;
+            scale += 256;
         }
 
-        if (_negative)
-            ret = -ret;
+        if (scale > 0)
+            ret *= std::pow(static_cast<long double>(10), scale);
+        else if (scale < 0)
+            ret /= std::pow(static_cast<long double>(10), -scale);
 
-        log_debug("getDouble mantissa=" << _mantissa << " exponent=" << _exponent << " negative=" << _negative << " => " << ret);
+        return _negative ? -ret : ret;
+    }
 
-        return ret;
+    int Decimal::_compareMagnitude(const Decimal& other) const
+    {
+        if (isZero() || other.isZero())
+            return isZero() ? (other.isZero() ? 0 : -1) : 1;
+
+        long e1 = _scale + static_cast<long>(_numDigits());
+        long e2 = other._scale + static_cast<long>(other._numDigits());
+        if (e1 != e2)
+            return e1 < e2 ? -1 : 1;
+
+        if (_scale == other._scale && _digits.empty() && other._digits.empty())
+            return _coefficient < other._coefficient ? -1
+                 : _coefficient > other._coefficient ? 1 : 0;
+
+        // The leading digits are at the same position and the coefficients
+        // have no trailing zeros, so the digits can be compared as strings.
+        char buf1[maxCoefficientLength];
+        char buf2[maxCoefficientLength];
+        const char* b1 = _digits.empty() ? buf1 : _digits.data();
+        const char* b2 = other._digits.empty() ? buf2 : other._digits.data();
+        std::size_t len1 = _digits.empty() ? _formatCoefficient(buf1) - buf1 : _digits.size();
+        std::size_t len2 = other._digits.empty() ? other._formatCoefficient(buf2) - buf2 : other._digits.size();
+
+        int c = std::memcmp(b1, b2, std::min(len1, len2));
+        if (c != 0)
+            return c < 0 ? -1 : 1;
+        return len1 < len2 ? -1 : len1 > len2 ? 1 : 0;
     }
 
-    void Decimal::_setInteger(LongType l, short exponent)
+    bool Decimal::operator< (const Decimal& other) const
     {
-        _mantissa = cxxtools::convert<std::string>(l);
+        if (isNaN() || other.isNaN())
+            return false;
 
-        if (_mantissa[0] == '-')
-        {
-            _mantissa.erase(0, 1);
-            _negative = true;
-        }
+        if (_negative != other._negative)
+            return _negative;
+
+        int c;
+        if (_kind == infinite || other._kind == infinite)
+            c = _kind == other._kind ? 0 : _kind == infinite ? 1 : -1;
         else
-            _negative = false;
+            c = _compareMagnitude(other);
 
-        _exponent = exponent + _mantissa.size();
-        stripZeros(_mantissa);
-        log_debug("setInteger(" << l << ", " << exponent << ") => negative=" << _negative << " mantissa=" << _mantissa << " exponent=" << _exponent);
+        return _negative ? c > 0 : c < 0;
     }
 
-    void Decimal::_setUnsigned(UnsignedLongType l, short exponent)
+    Decimal& Decimal::operator+= (const Decimal& other)
     {
-        _mantissa = cxxtools::convert<std::string>(l);
-        _negative = false;
-        _exponent = exponent + _mantissa.size();
-        stripZeros(_mantissa);
-        log_debug("setUnsigned(" << l << ", " << exponent << ") => mantissa=" << _mantissa << " exponent=" << _exponent);
+        if (isNaN())
+            return *this;
+
+        if (other.isNaN())
+            return *this = other;
+
+        if (_kind == infinite || other._kind == infinite)
+        {
+            if (_kind == infinite && other._kind == infinite && _negative != other._negative)
+                *this = nan();
+            else if (other._kind == infinite)
+                *this = other;
+            return *this;
+        }
+
+        if (other.isZero())
+            return *this;
+
+        if (isZero())
+            return *this = other;
+
+        long scale = std::min(_scale, other._scale);
+
+        if (_digits.empty() && other._digits.empty())
+        {
+            Coefficient c1 = _coefficient;
+            Coefficient c2 = other._coefficient;
+            if (alignCoefficient(c1, _scale - scale)
+              && alignCoefficient(c2, other._scale - scale))
+            {
+                if (_negative != other._negative)
+                {
+                    if (c1 >= c2)
+                    {
+                        _coefficient = c1 - c2;
+                    }
+                    else
+                    {
+                        _coefficient = c2 - c1;
+                        _negative = other._negative;
+                    }
+
+                    _normalize(scale);
+                    return *this;
+                }
+
+                if (c1 + c2 >= c1)
+                {
+                    _coefficient = c1 + c2;
+                    _normalize(scale);
+                    return *this;
+                }
+            }
+        }
+
+        // does not fit into the coefficient
+        std::string a = _coefficientDigits();
+        std::string b = other._coefficientDigits();
+        a.append(_scale - scale, '0');
+        b.append(other._scale - scale, '0');
+
+        std::string r;
+        bool negative = _negative;
+        if (_negative == other._negative)
+            r = addDigits(a, b);
+        else if (compareDigits(a, b) >= 0)
+            r = subDigits(a, b);
+        else
+        {
+            r = subDigits(b, a);
+            negative = other._negative;
+        }
+
+        _setDigits(r.data(), r.data() + r.size(), scale, negative);
+        return *this;
     }
 
-    bool Decimal::operator< (const Decimal& other) const
+    Decimal& Decimal::operator*= (const Decimal& other)
     {
-        if (_negative != other._negative)
-            return _negative;
+        if (isNaN())
+            return *this;
+
+        if (other.isNaN())
+            return *this = other;
+
+        bool negative = _negative != other._negative;
 
-        if (_exponent != other._exponent)
-            return _exponent < other._exponent;
+        if (_kind == infinite || other._kind == infinite)
+        {
+            if (isZero() || other.isZero())
+                *this = nan();
+            else
+                *this = Decimal(infinite, negative);
+            return *this;
+        }
+
+        if (isZero() || other.isZero())
+            return *this = Decimal();
+
+        long scale = static_cast<long>(_scale) + other._scale;
+
+        if (_digits.empty() && other._digits.empty()
+          && (numDigits(_coefficient) + numDigits(other._coefficient) <= maxDigits
+                || _coefficient <= maxCoefficient / other._coefficient))
+        {
+            _coefficient *= other._coefficient;
+            _negative = negative;
+            _normalize(scale);
+            return *this;
+        }
 
-        return _mantissa < other._mantissa;
+        // does not fit into the coefficient
+        std::string r = mulDigits(_coefficientDigits(), other._coefficientDigits());
+        _setDigits(r.data(), r.data() + r.size(), scale, negative);
+        return *this;
     }
 
     std::string Decimal::toString() const
     {
-        return (_exponent < -8 || _exponent > 8) ? toStringSci() : toStringFix();
+        short e = exponent();
+        return (e < -8 || e > 8) ? toStringSci() : toStringFix();
     }
 
     std::string Decimal::toStringSci() const
@@ -634,18 +902,22 @@ namespace
             return "nan";
         else
         {
+            char buf[maxCoefficientLength];
+            const char* m = _digits.empty() ? buf : _digits.data();
+            std::size_t len = _digits.empty() ? _formatCoefficient(buf) - buf : _digits.size();
+
             std::string ret;
             if (_negative)
                 ret = '-';
-            ret += _mantissa[0];
-            if (_mantissa.size() > 1)
+            ret += m[0];
+            if (len > 1)
             {
                 ret += '.';
-                ret.append(_mantissa, 1, _mantissa.size() - 1);
+                ret.append(m + 1, len - 1);
             }
 
             ret += 'e';
-            ret += cxxtools::convert<std::string>(_exponent - 1);
+            textconv::append(ret, exponent() - 1);
 
             return ret;
         }
@@ -662,42 +934,48 @@ namespace
         else
         {
             std::string ret;
+            if (_negative)
+                ret = '-';
 
-            if (_exponent < 1)
+            char buf[maxCoefficientLength];
+            const char* m = _digits.empty() ? buf : _digits.data();
+            std::size_t len = _digits.empty() ? _formatCoefficient(buf) - buf : _digits.size();
+            short e = exponent();
+
+            if (e < 1)
             {
-                ret = "0.";
-                ret.append(-_exponent, '0');
-                ret.append(_mantissa);
+                ret += "0.";
+                ret.append(-e, '0');
+                ret.append(m, len);
+            }
+            else if (e < static_cast<short>(len))
+            {
+                ret.append(m, e);
+                ret += '.';
+                ret.append(m + e, len - e);
             }
             else
             {
-                ret = _mantissa;
-                if (_exponent < static_cast<short>(_mantissa.size()))
-                    ret.insert(_exponent, 1, '.');
-                else
-                    ret.append(_exponent - _mantissa.size(), '0');
+                ret.append(m, len);
+                ret.append(e - len, '0');
             }
 
-            if (_negative)
-                ret.insert(0u, 1u, '-');
-
             return ret;
         }
     }
 
     std::istream& operator>> (std::istream& in, Decimal& dec)
     {
-        Decimal::Parser parser;
-        parser.begin(dec);
-
-        int ch;
-        while ((ch = in.rdbuf()->sbumpc()) != std::istream::traits_type::eof() && !std::isspace(std::istream::traits_type::to_char_type(ch)))
+        std::string s;
+        if (in >> s)
         {
-            parser.parse(std::istream::traits_type::to_char_type(ch));
+            Decimal::Parser parser;
+            parser.begin(dec);
+            for (std::string::const_iterator it = s.begin(); it != s.end(); ++it)
+                parser.parse(*it);
+            parser.finish();
         }
 
-        parser.finish();
-
         return in;
     }
 
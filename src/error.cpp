@@ -56,6 +56,10 @@ namespace tntdb
       sql(sql_)
     { }
 
+  PoolTimeout::PoolTimeout()
+    : Error("timeout waiting for a database connection")
+    { }
+
   FieldNotFound::FieldNotFound(const std::string& field_)
     : Error("field \"" + field_ + "\" not found"),
       field(field_)
@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2005 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <tntdb/metrics.h>
+#include <cmath>
+
+namespace tntdb
+{
+LatencyHistogram::LatencyHistogram()
+  : _sum(0)
+{
+    for (unsigned n = 0; n < numBuckets; ++n)
+        _buckets[n] = 0;
+}
+
+LatencyHistogram::LatencyHistogram(const LatencyHistogram& other)
+  : _sum(other._sum.load())
+{
+    for (unsigned n = 0; n < numBuckets; ++n)
+        _buckets[n] = other._buckets[n].load();
+}
+
+LatencyHistogram& LatencyHistogram::operator=(const LatencyHistogram& other)
+{
+    for (unsigned n = 0; n < numBuckets; ++n)
+        _buckets[n] = other._buckets[n].load();
+    _sum = other._sum.load();
+    return *this;
+}
+
+void LatencyHistogram::add(std::chrono::microseconds duration)
+{
+    unsigned long long us = duration.count() > 0 ? duration.count() : 0;
+
+    unsigned bucket = 0;
+    while (bucket < numBuckets - 1 && us >= (1ull << bucket))
+        ++bucket;
+
+    _buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    _sum.fetch_add(us, std::memory_order_relaxed);
+}
+
+unsigned long LatencyHistogram::count() const
+{
+    unsigned long ret = 0;
+    for (unsigned n = 0; n < numBuckets; ++n)
+        ret += _buckets[n];
+    return ret;
+}
+
+std::chrono::microseconds LatencyHistogram::average() const
+{
+    unsigned long c = count();
+    return std::chrono::microseconds(c == 0 ? 0 : _sum / c);
+}
+
+std::chrono::microseconds LatencyHistogram::upperBound(unsigned bucket)
+{
+    return bucket >= numBuckets - 1 ? std::chrono::microseconds::max()
+                                    : std::chrono::microseconds(1ll << bucket);
+}
+
+std::chrono::microseconds LatencyHistogram::quantile(double q) const
+{
+    unsigned long c = count();
+    if (c == 0)
+        return std::chrono::microseconds(0);
+
+    // the rank of the duration, which is the quantile
+    double rank = std::ceil(q * c);
+    unsigned long limit = rank < 1 ? 1
+                        : rank > c ? c
+                        : static_cast<unsigned long>(rank);
+
+    unsigned long sum = 0;
+    for (unsigned n = 0; n < numBuckets; ++n)
+    {
+        sum += _buckets[n];
+        if (sum >= limit)
+            return upperBound(n);
+    }
+
+    return upperBound(numBuckets - 1);
+}
+}
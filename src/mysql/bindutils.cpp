@@ -35,6 +35,7 @@
 #include <tntdb/decimal.h>
 #include <cxxtools/log.h>
 #include <sstream>
+#include <vector>
 #include <string.h>
 
 log_define("tntdb.mysql.bindutils")
@@ -676,6 +677,83 @@ void getBlob(const MYSQL_BIND& bind, Blob& ret)
     }
 }
 
+bool getStringData(const MYSQL_BIND& bind, const char*& data, std::size_t& length)
+{
+    if (isNull(bind))
+        throw NullValue();
+
+    switch (bind.buffer_type)
+    {
+        case MYSQL_TYPE_DECIMAL:
+        case MYSQL_TYPE_NEWDECIMAL:
+            data = static_cast<const char*>(bind.buffer);
+            length = *bind.length;
+            return true;
+
+        default:
+            return getBlobData(bind, data, length);
+    }
+}
+
+bool getBlobData(const MYSQL_BIND& bind, const char*& data, std::size_t& length)
+{
+    if (isNull(bind))
+        throw NullValue();
+
+    switch (bind.buffer_type)
+    {
+        case MYSQL_TYPE_STRING:
+        case MYSQL_TYPE_VAR_STRING:
+        case MYSQL_TYPE_TINY_BLOB:
+        case MYSQL_TYPE_BLOB:
+        case MYSQL_TYPE_MEDIUM_BLOB:
+        case MYSQL_TYPE_LONG_BLOB:
+            data = static_cast<const char*>(bind.buffer);
+            length = *bind.length;
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+std::size_t getLength(const MYSQL_BIND& bind)
+{
+    if (isNull(bind))
+        return 0;
+
+    // the length is only set for types with a variable length
+    switch (bind.buffer_type)
+    {
+        case MYSQL_TYPE_TINY:
+            return 1;
+
+        case MYSQL_TYPE_SHORT:
+        case MYSQL_TYPE_YEAR:
+            return 2;
+
+        case MYSQL_TYPE_INT24:
+            return 3;
+
+        case MYSQL_TYPE_LONG:
+        case MYSQL_TYPE_FLOAT:
+            return 4;
+
+        case MYSQL_TYPE_LONGLONG:
+        case MYSQL_TYPE_DOUBLE:
+            return 8;
+
+        case MYSQL_TYPE_DATE:
+        case MYSQL_TYPE_TIME:
+        case MYSQL_TYPE_DATETIME:
+        case MYSQL_TYPE_TIMESTAMP:
+            return sizeof(MYSQL_TIME);
+
+        default:
+            return bind.length ? *bind.length : 0;
+    }
+}
+
 Date getDate(const MYSQL_BIND& bind)
 {
     if (isNull(bind))
@@ -741,6 +819,55 @@ Datetime getDatetime(const MYSQL_BIND& bind)
     }
 }
 
+void appendLiteral(MYSQL* mysql, const MYSQL_BIND& bind, std::string& sql)
+{
+    if (isNull(bind))
+    {
+        sql += "NULL";
+        return;
+    }
+
+    switch (bind.buffer_type)
+    {
+        case MYSQL_TYPE_TINY:
+        case MYSQL_TYPE_SHORT:
+        case MYSQL_TYPE_INT24:
+        case MYSQL_TYPE_LONG:
+        case MYSQL_TYPE_LONGLONG:
+        {
+            std::string data;
+            getString(bind, data);
+            sql += data;
+            break;
+        }
+
+        case MYSQL_TYPE_FLOAT:
+        case MYSQL_TYPE_DOUBLE:
+        {
+            std::ostringstream s;
+            s.precision(bind.buffer_type == MYSQL_TYPE_FLOAT ? 9 : 17);
+            s << getFloat<double>(bind);
+            sql += s.str();
+            break;
+        }
+
+        default:
+        {
+            // strings, blobs, decimals and date types are passed as quoted strings
+            std::string data;
+            getString(bind, data);
+
+            std::vector<char> buffer(data.size() * 2 + 1);
+            unsigned long length = ::mysql_real_escape_string(mysql,
+                buffer.data(), data.data(), data.size());
+
+            sql += '\'';
+            sql.append(buffer.data(), length);
+            sql += '\'';
+        }
+    }
+}
+
 void transferValue(MYSQL_BIND& fromValue, MYSQL_BIND& toValue,
     bool doRelease)
 {
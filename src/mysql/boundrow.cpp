@@ -28,8 +28,13 @@
 
 #include <tntdb/mysql/impl/boundrow.h>
 #include <tntdb/mysql/impl/boundvalue.h>
+#include <tntdb/mysql/bindutils.h>
 #include <tntdb/value.h>
-#include <tntdb/error.h>
+#include <tntdb/date.h>
+#include <tntdb/time.h>
+#include <tntdb/datetime.h>
+#include <tntdb/decimal.h>
+#include <tntdb/blob.h>
 
 namespace tntdb
 {
@@ -50,15 +55,7 @@ Value BoundRow::getValueByNumber(size_type field_num) const
 
 Value BoundRow::getValueByName(const std::string& field_name) const
 {
-    size_type field_num;
-    for (field_num = 0; field_num < size(); ++field_num)
-        if (getName(field_num) == field_name)
-            break;
-
-    if (field_num >= size())
-        throw FieldNotFound(field_name);
-
-    return getValueByNumber(field_num);
+    return getValueByNumber(getColumnIndex(field_name));
 }
 
 std::string BoundRow::getColumnName(size_type field_num) const
@@ -66,5 +63,122 @@ std::string BoundRow::getColumnName(size_type field_num) const
     return getName(field_num);
 }
 
+BoundRow::size_type BoundRow::getColumnIndex(const std::string& field_name) const
+{
+    if (_columnIndex.empty())
+    {
+        _columnIndex.reserve(size());
+        for (size_type n = 0; n < size(); ++n)
+            _columnIndex.add(getName(n), n);
+    }
+
+    return _columnIndex.get(field_name);
+}
+
+bool BoundRow::isNull(size_type field_num) const
+{
+    return mysql::isNull(getMysqlBind()[field_num]);
+}
+
+bool BoundRow::getBool(size_type field_num) const
+{
+    return mysql::getBool(getMysqlBind()[field_num]);
+}
+
+short BoundRow::getShort(size_type field_num) const
+{
+    return mysql::getShort(getMysqlBind()[field_num]);
+}
+
+int BoundRow::getInt(size_type field_num) const
+{
+    return mysql::getInt(getMysqlBind()[field_num]);
+}
+
+long BoundRow::getLong(size_type field_num) const
+{
+    return mysql::getLong(getMysqlBind()[field_num]);
+}
+
+unsigned BoundRow::getUnsigned(size_type field_num) const
+{
+    return mysql::getUnsigned(getMysqlBind()[field_num]);
+}
+
+unsigned short BoundRow::getUnsignedShort(size_type field_num) const
+{
+    return mysql::getUnsignedShort(getMysqlBind()[field_num]);
+}
+
+unsigned long BoundRow::getUnsignedLong(size_type field_num) const
+{
+    return mysql::getUnsignedLong(getMysqlBind()[field_num]);
+}
+
+int32_t BoundRow::getInt32(size_type field_num) const
+{
+    return mysql::getInt32(getMysqlBind()[field_num]);
+}
+
+uint32_t BoundRow::getUnsigned32(size_type field_num) const
+{
+    return mysql::getUnsigned32(getMysqlBind()[field_num]);
+}
+
+int64_t BoundRow::getInt64(size_type field_num) const
+{
+    return mysql::getInt64(getMysqlBind()[field_num]);
+}
+
+uint64_t BoundRow::getUnsigned64(size_type field_num) const
+{
+    return mysql::getUnsigned64(getMysqlBind()[field_num]);
+}
+
+Decimal BoundRow::getDecimal(size_type field_num) const
+{
+    return mysql::getDecimal(getMysqlBind()[field_num]);
+}
+
+float BoundRow::getFloat(size_type field_num) const
+{
+    return mysql::getFloat(getMysqlBind()[field_num]);
+}
+
+double BoundRow::getDouble(size_type field_num) const
+{
+    return mysql::getDouble(getMysqlBind()[field_num]);
+}
+
+char BoundRow::getChar(size_type field_num) const
+{
+    return mysql::getChar(getMysqlBind()[field_num]);
+}
+
+void BoundRow::getString(size_type field_num, std::string& ret) const
+{
+    mysql::getString(getMysqlBind()[field_num], ret);
+}
+
+void BoundRow::getBlob(size_type field_num, Blob& ret) const
+{
+    mysql::getBlob(getMysqlBind()[field_num], ret);
+}
+
+Date BoundRow::getDate(size_type field_num) const
+{
+    return mysql::getDate(getMysqlBind()[field_num]);
+}
+
+Time BoundRow::getTime(size_type field_num) const
+{
+    return mysql::getTime(getMysqlBind()[field_num]);
+}
+
+Datetime BoundRow::getDatetime(size_type field_num) const
+{
+    return mysql::getDatetime(getMysqlBind()[field_num]);
+}
+
 }
 }
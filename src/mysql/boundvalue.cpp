@@ -133,6 +133,16 @@ void BoundValue::getBlob(Blob& ret) const
     mysql::getBlob(mysql_bind, ret);
 }
 
+bool BoundValue::getStringView(const char*& data, std::size_t& length) const
+{
+    return mysql::getStringData(mysql_bind, data, length);
+}
+
+bool BoundValue::getBlobView(const char*& data, std::size_t& length) const
+{
+    return mysql::getBlobData(mysql_bind, data, length);
+}
+
 Date BoundValue::getDate() const
 {
     return mysql::getDate(mysql_bind);
@@ -29,11 +29,14 @@
 #include <tntdb/mysql/impl/connection.h>
 #include <tntdb/mysql/impl/result.h>
 #include <tntdb/mysql/impl/resultrow.h>
+#include <tntdb/mysql/impl/resultcursor.h>
 #include <tntdb/mysql/impl/rowvalue.h>
 #include <tntdb/mysql/impl/statement.h>
 #include <tntdb/result.h>
 #include <tntdb/statement.h>
 #include <tntdb/mysql/error.h>
+#include <tntdb/mysql/bindutils.h>
+#include <algorithm>
 #include <cctype>
 
 #include <cxxtools/log.h>
@@ -53,6 +56,10 @@ namespace
     }
     const char* zstr(const char* s)
     { return s && s[0] ? s : 0; }
+
+    // Flush delayed statements before the buffer exceeds this size. It is
+    // well below the default max_allowed_packet of the server.
+    const std::string::size_type maxDelayedQuerySize = 0x100000;
 }
 
 void Connection::open(const char* app, const char* host, const char* user,
@@ -85,14 +92,16 @@ Connection::Connection(const char* app, const char* host, const char* user,
     const char* passwd, const char* db, unsigned int port,
     const char* unix_socket, unsigned long client_flag)
   : initialized(false),
-    transactionActive(0)
+    transactionActive(0),
+    delayedInsert(0)
 {
     open(app, host, user, passwd, db, port, unix_socket, client_flag);
 }
 
 Connection::Connection(const std::string& conn, const std::string& username_, const std::string& password_)
   : initialized(false),
-    transactionActive(0)
+    transactionActive(0),
+    delayedInsert(0)
 {
     log_debug("Connection::Connection(\"" << conn << "\", \"" << username_ << "\", password)");
     std::string app;
@@ -263,6 +272,7 @@ void Connection::beginTransaction()
     if (transactionActive == 0)
     {
         log_debug("mysql_autocomit(" << &mysql << ", " << 0 << ')');
+        countRoundTrip(0);
         if (::mysql_autocommit(&mysql, 0) != 0)
             throw MysqlError("mysql_autocommit", &mysql);
     }
@@ -272,21 +282,27 @@ void Connection::beginTransaction()
 
 void Connection::commitTransaction()
 {
+    if (transactionActive <= 1)
+        flushDelayed();
+
     if (transactionActive == 0 || --transactionActive == 0)
     {
         log_debug("mysql_commit(" << &mysql << ')');
+        countRoundTrip(0);
         if (::mysql_commit(&mysql) != 0)
             throw MysqlError("mysql_commit", &mysql);
 
         if (!lockTablesQuery.empty())
         {
             log_debug("mysql_query(\"UNLOCK TABLES\")");
+            countRoundTrip(13);
             if (::mysql_query(&mysql, "UNLOCK TABLES") != 0)
                 throw MysqlError("mysql_query", &mysql);
             lockTablesQuery.clear();
         }
 
         log_debug("mysql_autocomit(" << &mysql << ", " << 1 << ')');
+        countRoundTrip(0);
         if (::mysql_autocommit(&mysql, 1) != 0)
             throw MysqlError("mysql_autocommit", &mysql);
 
@@ -297,19 +313,24 @@ void Connection::rollbackTransaction()
 {
     if (transactionActive == 0 || --transactionActive == 0)
     {
+        clearDelayed();
+
         log_debug("mysql_rollback(" << &mysql << ')');
+        countRoundTrip(0);
         if (::mysql_rollback(&mysql) != 0)
             throw MysqlError("mysql_rollback", &mysql);
 
         if (!lockTablesQuery.empty())
         {
             log_debug("mysql_query(\"UNLOCK TABLES\")");
+            countRoundTrip(13);
             if (::mysql_query(&mysql, "UNLOCK TABLES") != 0)
                 throw MysqlError("mysql_query", &mysql);
             lockTablesQuery.clear();
         }
 
         log_debug("mysql_autocommit(" << &mysql << ", " << 1 << ')');
+        countRoundTrip(0);
         if (::mysql_autocommit(&mysql, 1) != 0)
             throw MysqlError("mysql_autocommit", &mysql);
 
@@ -318,7 +339,10 @@ void Connection::rollbackTransaction()
 
 Connection::size_type Connection::execute(const std::string& query)
 {
+    flushDelayed();
+
     log_debug("mysql_query(\"" << query << "\")");
+    countRoundTrip(query.size());
     if (::mysql_query(&mysql, query.c_str()) != 0)
         throw MysqlError("mysql_query", &mysql);
 
@@ -335,6 +359,8 @@ std::shared_ptr<Result> Connection::myselect(const std::string& query)
     if (res == 0)
         throw MysqlError("mysql_store_result", &mysql);
 
+    countResult(res);
+
     return std::make_shared<Result>(&mysql, res);
 }
 
@@ -349,7 +375,7 @@ Row Connection::selectRow(const std::string& query)
     if (result->size() == 0)
         throw NotFound();
 
-    return tntdb::Row(result->getMysqlRow(0));
+    return tntdb::Row(Result::getMysqlRow(result, 0));
 }
 
 Value Connection::selectValue(const std::string& query)
@@ -358,7 +384,12 @@ Value Connection::selectValue(const std::string& query)
     if (result->size() == 0)
         throw NotFound();
 
-    return tntdb::Value(ResultRow::getMysqlValue(result->getMysqlRow(0), 0));
+    return tntdb::Value(ResultRow::getMysqlValue(Result::getMysqlRow(result, 0), 0));
+}
+
+std::shared_ptr<ICursor> Connection::createCursor(const std::string& query)
+{
+    return std::make_shared<ResultCursor>(*this, query);
 }
 
 tntdb::Statement Connection::prepare(const std::string& query)
@@ -389,9 +420,47 @@ bool Connection::ping()
 {
     int ret = ::mysql_ping(&mysql);
     log_debug("mysql_ping() => " << ret);
+    countRoundTrip(0);
     return ret == 0;
 }
 
+bool Connection::getMetrics(ConnectionMetrics& m)
+{
+    m.roundTrips += metrics.roundTrips;
+    m.bytesSent += metrics.bytesSent;
+    m.bytesReceived += metrics.bytesReceived;
+    m.rowsFetched += metrics.rowsFetched;
+    return true;
+}
+
+void Connection::countRow(const MYSQL_BIND* values, unsigned count)
+{
+    std::size_t bytes = 0;
+    for (unsigned n = 0; n < count; ++n)
+        bytes += getLength(values[n]);
+    countRow(bytes);
+}
+
+void Connection::countRow(MYSQL_RES* result)
+{
+    unsigned count = ::mysql_num_fields(result);
+    unsigned long* lengths = ::mysql_fetch_lengths(result);
+    std::size_t bytes = 0;
+    for (unsigned n = 0; n < count; ++n)
+        bytes += lengths[n];
+    countRow(bytes);
+}
+
+void Connection::countResult(MYSQL_RES* result)
+{
+    // the rows are already in client memory, so we read them once and
+    // seek back to the first row
+    while (::mysql_fetch_row(result))
+        countRow(result);
+
+    ::mysql_data_seek(result, 0);
+}
+
 long Connection::lastInsertId(const std::string& name)
 {
     return static_cast<long>(::mysql_insert_id(&mysql));
@@ -399,6 +468,8 @@ long Connection::lastInsertId(const std::string& name)
 
 void Connection::lockTable(const std::string& tablename, bool exclusive)
 {
+    flushDelayed();
+
     if (lockTablesQuery.empty())
         lockTablesQuery = "LOCK TABLES ";
     else
@@ -408,9 +479,125 @@ void Connection::lockTable(const std::string& tablename, bool exclusive)
     lockTablesQuery += exclusive ? " WRITE" : " READ";
 
     log_debug("mysql_query(\"" << lockTablesQuery << "\")");
+    countRoundTrip(lockTablesQuery.size());
     if (::mysql_query(&mysql, lockTablesQuery.c_str()) != 0)
         throw MysqlError("mysql_query", &mysql);
 }
 
+void Connection::delayExecute(Statement* stmt)
+{
+    if (delayedInsert == stmt)
+    {
+        // extend the pending multi row insert
+        delayedQuery += ',';
+        stmt->appendValues(delayedQuery);
+    }
+    else
+    {
+        if (!delayedQuery.empty())
+            delayedQuery += ";\n";
+        stmt->appendQuery(delayedQuery);
+        delayedStatements.push_back(stmt);
+        delayedInsert = stmt->isMultiRowInsert() ? stmt : 0;
+    }
+}
+
+bool Connection::delayBufferFull() const
+{
+    return delayedQuery.size() >= maxDelayedQuerySize;
+}
+
+void Connection::clearDelayed()
+{
+    for (unsigned n = 0; n < delayedStatements.size(); ++n)
+        if (delayedStatements[n])
+            delayedStatements[n]->resetDelayed();
+
+    delayedQuery.clear();
+    delayedInsert = 0;
+    delayedStatements.clear();
+}
+
+Connection::size_type Connection::flushDelayed()
+{
+    if (delayedQuery.empty())
+        return 0;
+
+    std::string query;
+    query.swap(delayedQuery);
+    std::vector<Statement*> statements = delayedStatements;
+    clearDelayed();
+
+    log_debug("flush " << statements.size() << " delayed queries");
+
+    if (statements.size() == 1)
+    {
+        size_type affected = execute(query);
+        if (statements[0])
+            statements[0]->delayedResult(affected);
+        return affected;
+    }
+
+    // send all statements in one round trip
+    log_debug("mysql_set_server_option(" << &mysql << ", MYSQL_OPTION_MULTI_STATEMENTS_ON)");
+    countRoundTrip(0);
+    if (::mysql_set_server_option(&mysql, MYSQL_OPTION_MULTI_STATEMENTS_ON) != 0)
+        throw MysqlError("mysql_set_server_option", &mysql);
+
+    size_type affected = 0;
+    unsigned n = 0;
+    const char* function = "mysql_real_query";
+
+    log_debug("mysql_real_query(\"" << query << "\")");
+    countRoundTrip(query.size());
+    int ret = ::mysql_real_query(&mysql, query.data(), query.size());
+    while (ret == 0)
+    {
+        log_debug("mysql_store_result(" << &mysql << ')');
+        MYSQL_RES* res = ::mysql_store_result(&mysql);
+        if (res)
+            ::mysql_free_result(res);
+        else
+        {
+            size_type count = ::mysql_affected_rows(&mysql);
+            if (n < statements.size() && statements[n])
+                statements[n]->delayedResult(count);
+            affected += count;
+        }
+        ++n;
+
+        log_debug("mysql_next_result(" << &mysql << ')');
+        ret = ::mysql_next_result(&mysql);
+        function = "mysql_next_result";
+    }
+
+    if (ret > 0)
+    {
+        // fetch the error before resetting the option
+        MysqlError e(function, &mysql);
+        log_debug("mysql_set_server_option(" << &mysql << ", MYSQL_OPTION_MULTI_STATEMENTS_OFF)");
+        countRoundTrip(0);
+        if (::mysql_set_server_option(&mysql, MYSQL_OPTION_MULTI_STATEMENTS_OFF) != 0)
+            log_warn(MysqlError("mysql_set_server_option", &mysql).what());
+        throw e;
+    }
+
+    log_debug("mysql_set_server_option(" << &mysql << ", MYSQL_OPTION_MULTI_STATEMENTS_OFF)");
+    countRoundTrip(0);
+    if (::mysql_set_server_option(&mysql, MYSQL_OPTION_MULTI_STATEMENTS_OFF) != 0)
+        throw MysqlError("mysql_set_server_option", &mysql);
+
+    return affected;
+}
+
+void Connection::releaseDelayed(Statement* stmt)
+{
+    if (delayedInsert == stmt)
+        delayedInsert = 0;
+
+    std::replace(delayedStatements.begin(), delayedStatements.end(),
+        stmt, static_cast<Statement*>(0));
+}
+
 }
 }
@@ -27,6 +27,7 @@
  */
 
 #include <tntdb/mysql/impl/cursor.h>
+#include <tntdb/mysql/impl/connection.h>
 #include <tntdb/mysql/impl/statement.h>
 #include <tntdb/mysql/impl/boundrow.h>
 #include <tntdb/row.h>
@@ -41,35 +42,42 @@ namespace tntdb
 namespace mysql
 {
 Cursor::Cursor(Statement& statement, unsigned fetchsize)
-  : _row(std::make_shared<BoundRow>(statement.getFieldCount())),
+  : _conn(statement.getConnection()),
+    _row(std::make_shared<BoundRow>(statement.getFieldCount())),
     _fields(statement.getFields()),
-    _stmt(statement.createStmt())
+    _stmt(statement.borrowStmt()),
+    _pool(statement.getStmtPool())
 {
-    unsigned field_count = _row->getSize();
-
-    for (unsigned n = 0; n < field_count; ++n)
+    try
     {
-        if (_fields[n].length > 0x10000)
-            // do not allocate buffers > 64k - use mysql_stmt_fetch_column instead later
-            _fields[n].length = 0x10000;
+        unsigned field_count = _row->getSize();
 
-        _row->initOutBuffer(n, _fields[n]);
-    }
+        for (unsigned n = 0; n < field_count; ++n)
+        {
+            if (_fields[n].length > 0x10000)
+                // do not allocate buffers > 64k - use mysql_stmt_fetch_column instead later
+                _fields[n].length = 0x10000;
 
-    log_debug("mysql_stmt_bind_result");
-    if (mysql_stmt_bind_result(_stmt, _row->getMysqlBind()) != 0)
-        throw MysqlStmtError("mysql_stmt_bind_result", _stmt);
+            _row->initOutBuffer(n, _fields[n]);
+        }
+
+        log_debug("mysql_stmt_bind_result");
+        if (mysql_stmt_bind_result(_stmt, _row->getMysqlBind()) != 0)
+            throw MysqlStmtError("mysql_stmt_bind_result", _stmt);
 
-    statement.execute(_stmt, fetchsize);
+        statement.execute(_stmt, fetchsize);
+    }
+    catch (...)
+    {
+        _pool->put(_stmt);
+        throw;
+    }
 }
 
 Cursor::~Cursor()
 {
     if (_stmt)
-    {
-        log_debug("mysql_stmt_close(" << _stmt << ')');
-        ::mysql_stmt_close(_stmt);
-    }
+        _pool->put(_stmt);
 }
 
 Row Cursor::fetch()
@@ -104,6 +112,8 @@ Row Cursor::fetch()
     else if (ret == 1)
         throw MysqlStmtError("mysql_stmt_fetch", _stmt);
 
+    _conn.countRow(_row->getMysqlBind(), _row->getSize());
+
     return Row(_row);
 }
 }
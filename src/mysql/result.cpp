@@ -31,6 +31,7 @@
 #include <tntdb/bits/row.h>
 #include <tntdb/bits/connection.h>
 #include <tntdb/mysql/error.h>
+#include <tntdb/error.h>
 #include <cxxtools/log.h>
 
 log_define("tntdb.mysql.result")
@@ -41,7 +42,8 @@ namespace mysql
 {
 Result::Result(MYSQL* m, MYSQL_RES* r)
   : mysql(m),
-    result(r)
+    result(r),
+    nextRow(0)
 {
     log_debug("mysql-result " << r);
 
@@ -58,17 +60,68 @@ Result::~Result()
     }
 }
 
-std::shared_ptr<ResultRow> Result::getMysqlRow(size_type tup_num) const
+MYSQL_ROW Result::fetchRow(size_type tup_num) const
 {
-    log_debug("mysql_data_seek(" << tup_num << ')');
-    ::mysql_data_seek(result, tup_num);
+    if (tup_num >= size())
+        throw NotFound();
+
+    if (tup_num != nextRow)
+    {
+        if (rowOffsets.empty())
+        {
+            log_debug("build row index");
+
+            ::mysql_data_seek(result, 0);
+            while (true)
+            {
+                MYSQL_ROW_OFFSET offset = ::mysql_row_tell(result);
+                if (::mysql_fetch_row(result) == 0)
+                    break;
+                rowOffsets.push_back(offset);
+            }
+        }
+
+        log_debug("mysql_row_seek(" << tup_num << ')');
+        ::mysql_row_seek(result, rowOffsets[tup_num]);
+    }
 
     log_debug("mysql_fetch_row");
     MYSQL_ROW row = ::mysql_fetch_row(result);
     if (row == 0)
-      throw MysqlError("mysql_fetch_row", mysql);
+    {
+        nextRow = size();
+        throw MysqlError("mysql_fetch_row", mysql);
+    }
+
+    nextRow = tup_num + 1;
+
+    return row;
+}
+
+std::shared_ptr<ResultRow> Result::getMysqlRow(size_type tup_num) const
+{
+    MYSQL_ROW row = fetchRow(tup_num);
+    return std::make_shared<ResultRow>(*this, row, field_count);
+}
+
+std::shared_ptr<ResultRow> Result::getMysqlRow(const std::shared_ptr<Result>& resultref, size_type tup_num)
+{
+    MYSQL_ROW row = resultref->fetchRow(tup_num);
+    return std::make_shared<ResultRow>(resultref, row, resultref->field_count);
+}
+
+const ColumnIndex& Result::getColumnIndex() const
+{
+    std::call_once(columnIndexFlag, [this]()
+    {
+        log_debug("mysql_fetch_fields");
+        MYSQL_FIELD* fields = ::mysql_fetch_fields(result);
+        columnIndex.reserve(field_count);
+        for (size_type n = 0; n < field_count; ++n)
+            columnIndex.add(fields[n].name, n);
+    });
 
-    return std::make_shared<ResultRow>(result, row, field_count);
+    return columnIndex;
 }
 
 Row Result::getRow(size_type tup_num) const
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2005 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <tntdb/mysql/impl/resultcursor.h>
+#include <tntdb/mysql/impl/connection.h>
+#include <tntdb/mysql/impl/result.h>
+#include <tntdb/mysql/impl/resultrow.h>
+#include <tntdb/mysql/error.h>
+#include <tntdb/row.h>
+#include <cxxtools/log.h>
+
+log_define("tntdb.mysql.resultcursor")
+
+namespace tntdb
+{
+namespace mysql
+{
+ResultCursor::ResultCursor(Connection& conn, const std::string& query)
+  : _conn(conn),
+    _mysql(conn.getHandle()),
+    _fieldCount(0)
+{
+    conn.execute(query);
+
+    log_debug("mysql_use_result(" << _mysql << ')');
+    MYSQL_RES* res = ::mysql_use_result(_mysql);
+    if (res == 0)
+        throw MysqlError("mysql_use_result", _mysql);
+
+    _result = std::make_shared<Result>(_mysql, res);
+    _fieldCount = _result->getFieldCount();
+}
+
+Row ResultCursor::fetch()
+{
+    if (!_result)
+        return Row();
+
+    log_debug("mysql_fetch_row(" << _result->getMysqlRes() << ')');
+    MYSQL_ROW row = ::mysql_fetch_row(_result->getMysqlRes());
+    if (row == 0)
+    {
+        // mysql_fetch_row returns 0 on error and at the end of the result
+        if (::mysql_errno(_mysql) != 0)
+            throw MysqlError("mysql_fetch_row", _mysql);
+
+        log_debug("no more rows");
+        _result.reset();
+        return Row();
+    }
+
+    _conn.countRow(_result->getMysqlRes());
+
+    return Row(std::make_shared<ResultRow>(_result, row, _fieldCount));
+}
+}
+}
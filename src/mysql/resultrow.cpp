@@ -30,7 +30,11 @@
 #include <tntdb/mysql/impl/result.h>
 #include <tntdb/mysql/impl/rowvalue.h>
 #include <tntdb/bits/value.h>
-#include <tntdb/error.h>
+#include <tntdb/date.h>
+#include <tntdb/time.h>
+#include <tntdb/datetime.h>
+#include <tntdb/decimal.h>
+#include <tntdb/blob.h>
 #include <cxxtools/log.h>
 
 log_define("tntdb.mysql.resultrow")
@@ -41,25 +45,29 @@ namespace mysql
 {
 ResultRow::ResultRow(std::shared_ptr<Result> resultref, MYSQL_ROW row, unsigned field_count)
     : _resultref(resultref),
+      _result(*resultref),
       _row(row),
       _field_count(field_count)
 {
     log_debug("mysql_fetch_lengths");
-    _lengths = ::mysql_fetch_lengths(resultref->getMysqlRes());
+    unsigned long* lengths = ::mysql_fetch_lengths(resultref->getMysqlRes());
+    _lengths.assign(lengths, lengths + field_count);
 
     log_debug("mysql_fetch_fields");
     _fields = ::mysql_fetch_fields(resultref->getMysqlRes());
 }
 
-ResultRow::ResultRow(MYSQL_RES* res, MYSQL_ROW row, unsigned field_count)
-    : _row(row),
+ResultRow::ResultRow(const Result& result, MYSQL_ROW row, unsigned field_count)
+    : _result(result),
+      _row(row),
       _field_count(field_count)
 {
     log_debug("mysql_fetch_lengths");
-    _lengths = ::mysql_fetch_lengths(res);
+    unsigned long* lengths = ::mysql_fetch_lengths(result.getMysqlRes());
+    _lengths.assign(lengths, lengths + field_count);
 
     log_debug("mysql_fetch_fields");
-    _fields = ::mysql_fetch_fields(res);
+    _fields = ::mysql_fetch_fields(result.getMysqlRes());
 }
 
 unsigned ResultRow::size() const
@@ -79,15 +87,7 @@ Value ResultRow::getValueByNumber(size_type field_num) const
 
 Value ResultRow::getValueByName(const std::string& field_name) const
 {
-    size_type field_num;
-    for (field_num = 0; field_num < size(); ++field_num)
-        if (_fields[field_num].name == field_name)
-             break;
-
-    if (field_num >= size())
-        throw FieldNotFound(field_name);
-
-    return getValueByNumber(field_num);
+    return getValueByNumber(getColumnIndex(field_name));
 }
 
 std::string ResultRow::getColumnName(size_type field_num) const
@@ -95,5 +95,115 @@ std::string ResultRow::getColumnName(size_type field_num) const
     return _fields[field_num].name;
 }
 
+ResultRow::size_type ResultRow::getColumnIndex(const std::string& field_name) const
+{
+    return _result.getColumnIndex().get(field_name);
+}
+
+bool ResultRow::isNull(size_type field_num) const
+{
+    return RowValue(_row, field_num, _lengths[field_num]).isNull();
+}
+
+bool ResultRow::getBool(size_type field_num) const
+{
+    return RowValue(_row, field_num, _lengths[field_num]).getBool();
+}
+
+short ResultRow::getShort(size_type field_num) const
+{
+    return RowValue(_row, field_num, _lengths[field_num]).getShort();
+}
+
+int ResultRow::getInt(size_type field_num) const
+{
+    return RowValue(_row, field_num, _lengths[field_num]).getInt();
+}
+
+long ResultRow::getLong(size_type field_num) const
+{
+    return RowValue(_row, field_num, _lengths[field_num]).getLong();
+}
+
+unsigned ResultRow::getUnsigned(size_type field_num) const
+{
+    return RowValue(_row, field_num, _lengths[field_num]).getUnsigned();
+}
+
+unsigned short ResultRow::getUnsignedShort(size_type field_num) const
+{
+    return RowValue(_row, field_num, _lengths[field_num]).getUnsignedShort();
+}
+
+unsigned long ResultRow::getUnsignedLong(size_type field_num) const
+{
+    return RowValue(_row, field_num, _lengths[field_num]).getUnsignedLong();
+}
+
+int32_t ResultRow::getInt32(size_type field_num) const
+{
+    return RowValue(_row, field_num, _lengths[field_num]).getInt32();
+}
+
+uint32_t ResultRow::getUnsigned32(size_type field_num) const
+{
+    return RowValue(_row, field_num, _lengths[field_num]).getUnsigned32();
+}
+
+int64_t ResultRow::getInt64(size_type field_num) const
+{
+    return RowValue(_row, field_num, _lengths[field_num]).getInt64();
+}
+
+uint64_t ResultRow::getUnsigned64(size_type field_num) const
+{
+    return RowValue(_row, field_num, _lengths[field_num]).getUnsigned64();
+}
+
+Decimal ResultRow::getDecimal(size_type field_num) const
+{
+    return RowValue(_row, field_num, _lengths[field_num]).getDecimal();
+}
+
+float ResultRow::getFloat(size_type field_num) const
+{
+    return RowValue(_row, field_num, _lengths[field_num]).getFloat();
+}
+
+double ResultRow::getDouble(size_type field_num) const
+{
+    return RowValue(_row, field_num, _lengths[field_num]).getDouble();
+}
+
+char ResultRow::getChar(size_type field_num) const
+{
+    return RowValue(_row, field_num, _lengths[field_num]).getChar();
+}
+
+void ResultRow::getString(size_type field_num, std::string& ret) const
+{
+    RowValue(_row, field_num, _lengths[field_num]).getString(ret);
+}
+
+void ResultRow::getBlob(size_type field_num, Blob& ret) const
+{
+    RowValue(_row, field_num, _lengths[field_num]).getBlob(ret);
+}
+
+Date ResultRow::getDate(size_type field_num) const
+{
+    return RowValue(_row, field_num, _lengths[field_num]).getDate();
+}
+
+Time ResultRow::getTime(size_type field_num) const
+{
+    return RowValue(_row, field_num, _lengths[field_num]).getTime();
+}
+
+Datetime ResultRow::getDatetime(size_type field_num) const
+{
+    return RowValue(_row, field_num, _lengths[field_num]).getDatetime();
+}
+
 }
 }
@@ -171,6 +171,20 @@ void RowValue::getBlob(Blob& ret) const
     ret.assign(_row[_col], _len);
 }
 
+bool RowValue::getStringView(const char*& data, std::size_t& length) const
+{
+    data = _row[_col];
+    length = _len;
+    return true;
+}
+
+bool RowValue::getBlobView(const char*& data, std::size_t& length) const
+{
+    data = _row[_col];
+    length = _len;
+    return true;
+}
+
 Date RowValue::getDate() const
 {
     return Date::fromIso(getString());
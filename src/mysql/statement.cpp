@@ -27,7 +27,7 @@
  */
 
 #include <tntdb/mysql/impl/statement.h>
-#include <tntdb/mysql/impl/rowcontainer.h>
+#include <tntdb/mysql/impl/storedresult.h>
 #include <tntdb/mysql/impl/boundrow.h>
 #include <tntdb/mysql/impl/boundvalue.h>
 #include <tntdb/mysql/impl/cursor.h>
@@ -40,6 +40,9 @@
 #include <tntdb/mysql/error.h>
 #include <tntdb/stmtparser.h>
 #include <sstream>
+#include <cctype>
+#include <string.h>
+#include <strings.h>
 #include <cxxtools/log.h>
 
 log_define("tntdb.mysql.statement")
@@ -55,12 +58,18 @@ namespace
     class SE : public StmtEvent
     {
         hostvarMapType& hostvarMap;
+        std::vector<std::string::size_type>& hostvarPos;
+        const StmtParser& parser;
         unsigned idx;
         static const std::string hostvarInd;
 
     public:
-        SE(hostvarMapType& hostvarMap_)
+        SE(hostvarMapType& hostvarMap_,
+           std::vector<std::string::size_type>& hostvarPos_,
+           const StmtParser& parser_)
           : hostvarMap(hostvarMap_),
+            hostvarPos(hostvarPos_),
+            parser(parser_),
             idx(0)
           { }
         std::string onHostVar(const std::string& name);
@@ -71,10 +80,140 @@ namespace
     {
         log_debug("hostvar :" << name << ", idx=" << idx);
         hostvarMap.insert(hostvarMapType::value_type(name, idx++));
+        hostvarPos.push_back(parser.getSql().size());
         return hostvarInd;
     }
 
     const std::string SE::hostvarInd = "?";
+
+    bool isWordAt(const std::string& sql, std::string::size_type pos, const char* word)
+    {
+        std::string::size_type len = ::strlen(word);
+        return sql.size() >= pos + len
+            && ::strncasecmp(sql.data() + pos, word, len) == 0
+            && (sql.size() == pos + len
+                || !(std::isalnum(sql[pos + len]) || sql[pos + len] == '_'));
+    }
+
+    bool precededByValues(const std::string& sql, std::string::size_type pos)
+    {
+        while (pos > 0 && std::isspace(sql[pos - 1]))
+            --pos;
+
+        std::string::size_type end = pos;
+        while (pos > 0 && (std::isalnum(sql[pos - 1]) || sql[pos - 1] == '_'))
+            --pos;
+
+        return (end - pos == 6 && isWordAt(sql, pos, "values"))
+            || (end - pos == 5 && isWordAt(sql, pos, "value"));
+    }
+
+    // Skips whitespace and comments and returns the position of the next
+    // token or npos, when a comment is not terminated. Executable comments
+    // ("/*! ... */") are tokens.
+    std::string::size_type skipSpace(const std::string& sql, std::string::size_type pos)
+    {
+        while (pos < sql.size())
+        {
+            if (std::isspace(sql[pos]))
+                ++pos;
+            else if (sql[pos] == '#'
+                || (sql.compare(pos, 2, "--") == 0
+                    && (pos + 2 == sql.size() || std::isspace(sql[pos + 2]))))
+            {
+                pos = sql.find('\n', pos);
+                if (pos == std::string::npos)
+                    return sql.size();
+            }
+            else if (sql.compare(pos, 2, "/*") == 0 && sql.compare(pos, 3, "/*!") != 0)
+            {
+                pos = sql.find("*/", pos + 2);
+                if (pos == std::string::npos)
+                    return std::string::npos;
+                pos += 2;
+            }
+            else
+                break;
+        }
+
+        return pos;
+    }
+
+    // Scans the query for delayed execution and returns the end of the
+    // statement without a trailing semicolon, comments and whitespace. When
+    // the query is not a single complete statement, npos is returned.
+    //
+    // tuple is set to the position of the value tuple if the query is a
+    // "INSERT ... VALUES (...)" with a single tuple at the end of the
+    // statement and to npos otherwise.
+    std::string::size_type scanQuery(const std::string& sql, std::string::size_type& tuple)
+    {
+        tuple = std::string::npos;
+
+        std::string::size_type pos = skipSpace(sql, 0);
+        if (pos == std::string::npos || pos == sql.size())
+            return std::string::npos;
+
+        bool insert = isWordAt(sql, pos, "insert") || isWordAt(sql, pos, "replace");
+        std::string::size_type tupleEnd = std::string::npos;
+        std::string::size_type end = pos;
+        unsigned depth = 0;
+
+        while (pos < sql.size())
+        {
+            char ch = sql[pos];
+            if (ch == '\'' || ch == '"' || ch == '`')
+            {
+                for (++pos; pos < sql.size() && sql[pos] != ch; ++pos)
+                    if (sql[pos] == '\\')
+                        ++pos;
+                if (pos >= sql.size())
+                    return std::string::npos;
+                ++pos;
+            }
+            else if (ch == ';')
+            {
+                // only comments may follow the semicolon
+                if (depth > 0 || skipSpace(sql, pos + 1) != sql.size())
+                    return std::string::npos;
+                break;
+            }
+            else
+            {
+                if (ch == '(')
+                {
+                    if (depth == 0 && insert && precededByValues(sql, pos))
+                    {
+                        tuple = pos;
+                        tupleEnd = std::string::npos;
+                    }
+                    ++depth;
+                }
+                else if (ch == ')')
+                {
+                    if (depth == 0)
+                        return std::string::npos;
+                    if (--depth == 0 && tuple != std::string::npos && tupleEnd == std::string::npos)
+                        tupleEnd = pos + 1;
+                }
+                ++pos;
+            }
+
+            end = pos;
+            pos = skipSpace(sql, pos);
+            if (pos == std::string::npos)
+                return std::string::npos;
+        }
+
+        if (depth > 0)
+            return std::string::npos;
+
+        // the tuple can be extended only when nothing follows it
+        if (tupleEnd != end)
+            tuple = std::string::npos;
+
+        return end;
+    }
 }
 
 std::shared_ptr<BoundRow> Statement::getRow()
@@ -135,6 +274,9 @@ std::shared_ptr<BoundRow> Statement::fetchRow()
     else if (ret == 1)
         throw MysqlStmtError("mysql_stmt_fetch", stmt);
 
+    if (ptr)
+        conn.countRow(ptr->getMysqlBind(), field_count);
+
     return ptr;
 }
 
@@ -143,22 +285,41 @@ Statement::Statement(Connection& conn_, MYSQL* mysql_,
   : conn(conn_),
     mysql(mysql_),
     stmt(0),
+    stmtPool(std::make_shared<StmtPool>()),
     fields(0),
-    field_count(0)
+    field_count(0),
+    maxDelay(0),
+    delayed(0),
+    delayedAffected(0)
 {
     // parse hostvars
     StmtParser parser;
-    SE se(hostvarMap);
+    SE se(hostvarMap, hostvarPos, parser);
     parser.parse(query_, se);
 
     log_debug("sql=\"" << parser.getSql() << "\" invars " << se.getCount());
 
     query = parser.getSql();
     inVars.setSize(se.getCount());
+    queryEnd = scanQuery(query, valuesPos);
+
+    // link the positions of host variables with the same name
+    nextHostvar.assign(se.getCount(), HostvarHandle::invalidIndex);
+    for (hostvarMapType::const_iterator it = hostvarMap.begin();
+         it != hostvarMap.end(); ++it)
+    {
+        hostvarMapType::const_iterator next = it;
+        ++next;
+        if (next != hostvarMap.end() && next->first == it->first)
+            nextHostvar[it->second] = next->second;
+    }
 }
 
 Statement::~Statement()
 {
+    if (delayed > 0)
+        conn.releaseDelayed(this);
+
     if (stmt)
     {
         log_debug("mysql_stmt_close(" << stmt << ')');
@@ -513,9 +674,201 @@ void Statement::setDatetime(const std::string& col, const Datetime& data)
         log_warn("hostvar \"" << col << "\" not found");
 }
 
+HostvarHandle Statement::hostvar(const std::string& col)
+{
+    hostvarMapType::const_iterator it = hostvarMap.find(col);
+    if (it == hostvarMap.end())
+    {
+        log_warn("hostvar \"" << col << "\" not found");
+        return HostvarHandle(col, HostvarHandle::invalidIndex);
+    }
+
+    return HostvarHandle(col, it->second);
+}
+
+void Statement::setNull(const HostvarHandle& hostvar)
+{
+    log_debug("statement " << stmt << " setNull(:" << hostvar.getName() << ")");
+
+    for (unsigned n = hostvar.getIndex(); n != HostvarHandle::invalidIndex; n = nextHostvar[n])
+        inVars.setNull(n);
+}
+
+void Statement::setBool(const HostvarHandle& hostvar, bool data)
+{
+    log_debug("statement " << stmt << " setBool(:" << hostvar.getName() << ", " << data << ')');
+
+    for (unsigned n = hostvar.getIndex(); n != HostvarHandle::invalidIndex; n = nextHostvar[n])
+        inVars.setBool(n, data);
+}
+
+void Statement::setShort(const HostvarHandle& hostvar, short data)
+{
+    log_debug("statement " << stmt << " setShort(:" << hostvar.getName() << ", " << data << ')');
+
+    for (unsigned n = hostvar.getIndex(); n != HostvarHandle::invalidIndex; n = nextHostvar[n])
+        inVars.setShort(n, data);
+}
+
+void Statement::setInt(const HostvarHandle& hostvar, int data)
+{
+    log_debug("statement " << stmt << " setInt(:" << hostvar.getName() << ", " << data << ')');
+
+    for (unsigned n = hostvar.getIndex(); n != HostvarHandle::invalidIndex; n = nextHostvar[n])
+        inVars.setInt(n, data);
+}
+
+void Statement::setLong(const HostvarHandle& hostvar, long data)
+{
+    log_debug("statement " << stmt << " setLong(:" << hostvar.getName() << ", " << data << ')');
+
+    for (unsigned n = hostvar.getIndex(); n != HostvarHandle::invalidIndex; n = nextHostvar[n])
+        inVars.setLong(n, data);
+}
+
+void Statement::setUnsignedShort(const HostvarHandle& hostvar, unsigned short data)
+{
+    log_debug("statement " << stmt << " setUnsignedShort(:" << hostvar.getName() << ", " << data << ')');
+
+    for (unsigned n = hostvar.getIndex(); n != HostvarHandle::invalidIndex; n = nextHostvar[n])
+        inVars.setUnsignedShort(n, data);
+}
+
+void Statement::setUnsigned(const HostvarHandle& hostvar, unsigned data)
+{
+    log_debug("statement " << stmt << " setUnsigned(:" << hostvar.getName() << ", " << data << ')');
+
+    for (unsigned n = hostvar.getIndex(); n != HostvarHandle::invalidIndex; n = nextHostvar[n])
+        inVars.setUnsigned(n, data);
+}
+
+void Statement::setUnsignedLong(const HostvarHandle& hostvar, unsigned long data)
+{
+    log_debug("statement " << stmt << " setUnsignedLong(:" << hostvar.getName() << ", " << data << ')');
+
+    for (unsigned n = hostvar.getIndex(); n != HostvarHandle::invalidIndex; n = nextHostvar[n])
+        inVars.setUnsignedLong(n, data);
+}
+
+void Statement::setInt32(const HostvarHandle& hostvar, int32_t data)
+{
+    log_debug("statement " << stmt << " setInt32(:" << hostvar.getName() << ", " << data << ')');
+
+    for (unsigned n = hostvar.getIndex(); n != HostvarHandle::invalidIndex; n = nextHostvar[n])
+        inVars.setInt32(n, data);
+}
+
+void Statement::setUnsigned32(const HostvarHandle& hostvar, uint32_t data)
+{
+    log_debug("statement " << stmt << " setUnsigned32(:" << hostvar.getName() << ", " << data << ')');
+
+    for (unsigned n = hostvar.getIndex(); n != HostvarHandle::invalidIndex; n = nextHostvar[n])
+        inVars.setUnsigned32(n, data);
+}
+
+void Statement::setInt64(const HostvarHandle& hostvar, int64_t data)
+{
+    log_debug("statement " << stmt << " setInt64(:" << hostvar.getName() << ", " << data << ')');
+
+    for (unsigned n = hostvar.getIndex(); n != HostvarHandle::invalidIndex; n = nextHostvar[n])
+        inVars.setInt64(n, data);
+}
+
+void Statement::setUnsigned64(const HostvarHandle& hostvar, uint64_t data)
+{
+    log_debug("statement " << stmt << " setUnsigned64(:" << hostvar.getName() << ", " << data << ')');
+
+    for (unsigned n = hostvar.getIndex(); n != HostvarHandle::invalidIndex; n = nextHostvar[n])
+        inVars.setUnsigned64(n, data);
+}
+
+void Statement::setDecimal(const HostvarHandle& hostvar, const Decimal& data)
+{
+    log_debug("statement " << stmt << " setDecimal(:" << hostvar.getName() << ", " << data << ')');
+
+    for (unsigned n = hostvar.getIndex(); n != HostvarHandle::invalidIndex; n = nextHostvar[n])
+        inVars.setDecimal(n, data);
+}
+
+void Statement::setFloat(const HostvarHandle& hostvar, float data)
+{
+    log_debug("statement " << stmt << " setFloat(:" << hostvar.getName() << ", " << data << ')');
+
+    for (unsigned n = hostvar.getIndex(); n != HostvarHandle::invalidIndex; n = nextHostvar[n])
+        inVars.setFloat(n, data);
+}
+
+void Statement::setDouble(const HostvarHandle& hostvar, double data)
+{
+    log_debug("statement " << stmt << " setDouble(:" << hostvar.getName() << ", " << data << ')');
+
+    for (unsigned n = hostvar.getIndex(); n != HostvarHandle::invalidIndex; n = nextHostvar[n])
+        inVars.setDouble(n, data);
+}
+
+void Statement::setChar(const HostvarHandle& hostvar, char data)
+{
+    log_debug("statement " << stmt << " setChar(:" << hostvar.getName() << ", " << data << ')');
+
+    for (unsigned n = hostvar.getIndex(); n != HostvarHandle::invalidIndex; n = nextHostvar[n])
+        inVars.setChar(n, data);
+}
+
+void Statement::setString(const HostvarHandle& hostvar, const std::string& data)
+{
+    log_debug("statement " << stmt << " setString(:" << hostvar.getName() << ", \"" << data << "\")");
+
+    for (unsigned n = hostvar.getIndex(); n != HostvarHandle::invalidIndex; n = nextHostvar[n])
+        inVars.setString(n, data);
+}
+
+void Statement::setBlob(const HostvarHandle& hostvar, const Blob& data)
+{
+    log_debug("statement " << stmt << " setBlob(:" << hostvar.getName() << ", data {" << data.size() << "})");
+
+    for (unsigned n = hostvar.getIndex(); n != HostvarHandle::invalidIndex; n = nextHostvar[n])
+        inVars.setBlob(n, data);
+}
+
+void Statement::setDate(const HostvarHandle& hostvar, const Date& data)
+{
+    log_debug("statement " << stmt << " setDate(:" << hostvar.getName() << ", " << data.getIso() << ')');
+
+    for (unsigned n = hostvar.getIndex(); n != HostvarHandle::invalidIndex; n = nextHostvar[n])
+        inVars.setDate(n, data);
+}
+
+void Statement::setTime(const HostvarHandle& hostvar, const Time& data)
+{
+    log_debug("statement " << stmt << " setTime(:" << hostvar.getName() << ", " << data.getIso() << ')');
+
+    for (unsigned n = hostvar.getIndex(); n != HostvarHandle::invalidIndex; n = nextHostvar[n])
+        inVars.setTime(n, data);
+}
+
+void Statement::setDatetime(const HostvarHandle& hostvar, const Datetime& data)
+{
+    log_debug("statement " << stmt << " setDatetime(:" << hostvar.getName() << ", " << data.getIso() << ')');
+
+    for (unsigned n = hostvar.getIndex(); n != HostvarHandle::invalidIndex; n = nextHostvar[n])
+        inVars.setDatetime(n, data);
+}
+
 Statement::size_type Statement::execute()
 {
     log_debug("execute statement " << stmt);
+
+    // queries, which can't be combined safely, are executed immediately
+    if (maxDelay > 0 && queryEnd != std::string::npos && conn.inTransaction())
+    {
+        conn.delayExecute(this);
+        if (++delayed >= maxDelay || conn.delayBufferFull())
+            return flush();
+        return 0;
+    }
+
+    conn.flushDelayed();
+
     if (hostvarMap.empty())
     {
         return conn.execute(query);
@@ -536,24 +889,96 @@ tntdb::Result Statement::select()
     if (hostvarMap.empty())
         return conn.select(query);
 
-    if (fields)
-        getRow();
+    conn.flushDelayed();
 
     stmt = getStmt();
     execute(stmt, 16);
 
+    // let mysql calculate the maximum length of each column, so that we
+    // can fetch all rows into buffers large enough without truncation
+    log_debug("mysql_stmt_attr_set(STMT_ATTR_UPDATE_MAX_LENGTH, 1)");
+    my_bool updateMaxLength = 1;
+    if (mysql_stmt_attr_set(stmt, STMT_ATTR_UPDATE_MAX_LENGTH, &updateMaxLength) != 0)
+        throw MysqlStmtError("mysql_stmt_attr_set", stmt);
+
+    log_debug("mysql_stmt_store_result(" << stmt << ')');
     if (mysql_stmt_store_result(stmt) != 0)
         throw MysqlStmtError("mysql_stmt_store_result", stmt);
 
-    auto result = std::make_shared<RowContainer>();
+    log_debug("mysql_stmt_result_metadata(" << stmt << ')');
+    MYSQL_RES* metadata = mysql_stmt_result_metadata(stmt);
+    if (!metadata)
+        throw Error("no metadata avaliable");
 
-    while (true)
+    std::shared_ptr<StoredResult> result;
+
+    try
     {
-        auto ptr = fetchRow();
-        if (!ptr)
-            break;
-        result->addRow(ptr);
+        unsigned count = mysql_num_fields(metadata);
+        MYSQL_FIELD* f = mysql_fetch_fields(metadata);
+
+        result = std::make_shared<StoredResult>(f, count, mysql_stmt_num_rows(stmt));
+
+        // a single row buffer is reused for all rows
+        BindValues row(count);
+        for (unsigned n = 0; n < count; ++n)
+        {
+            MYSQL_FIELD field = f[n];
+            field.length = 0;
+            row.initOutBuffer(n, field);
+        }
+
+        log_debug("mysql_stmt_bind_result(" << stmt << ", " << row.getMysqlBind() << ')');
+        if (mysql_stmt_bind_result(stmt, row.getMysqlBind()) != 0)
+            throw MysqlStmtError("mysql_stmt_bind_result", stmt);
+
+        while (true)
+        {
+            log_debug("mysql_stmt_fetch(" << stmt << ')');
+            int ret = mysql_stmt_fetch(stmt);
+
+            if (ret == MYSQL_NO_DATA)
+                break;
+            else if (ret == 1)
+                throw MysqlStmtError("mysql_stmt_fetch", stmt);
+            else if (ret == MYSQL_DATA_TRUNCATED)
+            {
+                // should not happen since max_length is known, but fetch
+                // truncated columns anyway
+                for (unsigned n = 0; n < count; ++n)
+                {
+                    MYSQL_BIND& bind = row.getMysqlBind()[n];
+                    if (*bind.length > bind.buffer_length)
+                    {
+                        MYSQL_FIELD field = f[n];
+                        field.length = *bind.length;
+                        row.initOutBuffer(n, field);
+
+                        log_debug("mysql_stmt_fetch_column(" << stmt << ", BIND, " << n
+                            << ", 0) with " << field.length << " bytes");
+                        if (mysql_stmt_fetch_column(stmt, &bind, n, 0) != 0)
+                          throw MysqlStmtError("mysql_stmt_fetch_column", stmt);
+                    }
+                }
+
+                log_debug("mysql_stmt_bind_result(" << stmt << ", " << row.getMysqlBind() << ')');
+                if (mysql_stmt_bind_result(stmt, row.getMysqlBind()) != 0)
+                    throw MysqlStmtError("mysql_stmt_bind_result", stmt);
+            }
+
+            conn.countRow(row.getMysqlBind(), count);
+            result->addRow(row.getMysqlBind());
+        }
     }
+    catch (...)
+    {
+        log_debug("mysql_free_result(" << metadata << ") (metadata)");
+        ::mysql_free_result(metadata);
+        throw;
+    }
+
+    log_debug("mysql_free_result(" << metadata << ") (metadata)");
+    ::mysql_free_result(metadata);
 
     return tntdb::Result(result);
 }
@@ -562,6 +987,8 @@ std::shared_ptr<BoundRow> Statement::selectBoundRow()
 {
     log_debug("selectRow");
 
+    conn.flushDelayed();
+
     if (fields)
         getRow();
 
@@ -600,13 +1027,107 @@ tntdb::Value Statement::selectValue()
 
 std::shared_ptr<ICursor> Statement::createCursor(unsigned fetchsize)
 {
+    if (hostvarMap.empty())
+        return conn.createCursor(query);
+
+    conn.flushDelayed();
     return std::make_shared<Cursor>(*this, fetchsize);
 }
 
-MYSQL_STMT* Statement::createStmt()
+void Statement::maxNumDelay(size_type n)
+{
+    log_debug("statement " << stmt << " maxNumDelay(" << n << ')');
+    maxDelay = n;
+}
+
+Statement::size_type Statement::numDelayed() const
+{
+    return delayed;
+}
+
+Statement::size_type Statement::flush()
 {
-    MYSQL_STMT* result = getStmt();
-    stmt = 0;
+    log_debug("statement " << stmt << " flush; " << delayed << " delayed");
+
+    conn.flushDelayed();
+
+    size_type ret = delayedAffected;
+    delayedAffected = 0;
+    return ret;
+}
+
+void Statement::appendQuery(std::string& sql) const
+{
+    std::string::size_type pos = 0;
+    for (unsigned n = 0; n < hostvarPos.size() && hostvarPos[n] < queryEnd; ++n)
+    {
+        sql.append(query, pos, hostvarPos[n] - pos);
+        appendLiteral(mysql, inVars.getMysqlBind()[n], sql);
+        pos = hostvarPos[n] + 1;
+    }
+
+    sql.append(query, pos, queryEnd - pos);
+}
+
+void Statement::appendValues(std::string& sql) const
+{
+    std::string::size_type pos = valuesPos;
+    for (unsigned n = 0; n < hostvarPos.size() && hostvarPos[n] < queryEnd; ++n)
+    {
+        if (hostvarPos[n] < valuesPos)
+            continue;
+
+        sql.append(query, pos, hostvarPos[n] - pos);
+        appendLiteral(mysql, inVars.getMysqlBind()[n], sql);
+        pos = hostvarPos[n] + 1;
+    }
+
+    sql.append(query, pos, queryEnd - pos);
+}
+
+StmtPool::~StmtPool()
+{
+    for (auto s : stmts)
+    {
+        log_debug("mysql_stmt_close(" << s << ')');
+        ::mysql_stmt_close(s);
+    }
+}
+
+MYSQL_STMT* StmtPool::get()
+{
+    if (stmts.empty())
+        return 0;
+
+    MYSQL_STMT* stmt = stmts.back();
+    stmts.pop_back();
+    log_debug("reuse stmt handle " << stmt);
+    return stmt;
+}
+
+void StmtPool::put(MYSQL_STMT* stmt)
+{
+    // discard pending rows and errors but keep the prepared statement
+    log_debug("mysql_stmt_reset(" << stmt << ')');
+    if (stmts.size() < maxSize && ::mysql_stmt_reset(stmt) == 0)
+    {
+        stmts.push_back(stmt);
+    }
+    else
+    {
+        log_debug("mysql_stmt_close(" << stmt << ')');
+        ::mysql_stmt_close(stmt);
+    }
+}
+
+MYSQL_STMT* Statement::borrowStmt()
+{
+    MYSQL_STMT* result = stmtPool->get();
+    if (result == 0)
+    {
+        result = getStmt();
+        stmt = 0;
+    }
     return result;
 }
 
@@ -615,6 +1136,10 @@ MYSQL_STMT* Statement::getStmt()
     if (stmt)
         return stmt;
 
+    stmt = stmtPool->get();
+    if (stmt)
+        return stmt;
+
     // initialize statement
     log_debug("mysql_stmt_init(" << mysql << ')');
     stmt = ::mysql_stmt_init(mysql);
@@ -623,6 +1148,7 @@ MYSQL_STMT* Statement::getStmt()
     log_debug("mysql_stmt_init(" << mysql << ") => " << stmt);
 
     log_debug("mysql_stmt_prepare(" << stmt << ", \"" << query << "\")");
+    conn.countRoundTrip(query.size());
     if (mysql_stmt_prepare(stmt, query.data(), query.size()) != 0)
     {
         // MysqlStmtError fetches the last error from MYSQL_STMT, so we need
@@ -681,7 +1207,12 @@ void Statement::execute(MYSQL_STMT* stmt, unsigned fetchsize)
     if (mysql_stmt_bind_param(stmt, inVars.getMysqlBind()) != 0)
         throw MysqlStmtError("mysql_stmt_bind_param", stmt);
 
+    std::size_t bytes = 0;
+    for (unsigned n = 0; n < inVars.getSize(); ++n)
+        bytes += getLength(inVars.getMysqlBind()[n]);
+
     log_debug("mysql_stmt_execute(" << stmt << ')');
+    conn.countRoundTrip(bytes);
     if (mysql_stmt_execute(stmt) != 0)
         throw MysqlStmtError("mysql_stmt_execute", stmt);
 }
@@ -0,0 +1,269 @@
+/*
+ * Copyright (C) 2005 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <tntdb/mysql/impl/storedresult.h>
+#include <tntdb/mysql/impl/storedvalue.h>
+#include <tntdb/row.h>
+#include <tntdb/value.h>
+#include <tntdb/date.h>
+#include <tntdb/time.h>
+#include <tntdb/datetime.h>
+#include <tntdb/decimal.h>
+#include <tntdb/blob.h>
+#include <cxxtools/log.h>
+#include <stdexcept>
+
+log_define("tntdb.mysql.storedresult")
+
+namespace tntdb
+{
+namespace mysql
+{
+StoredResult::StoredResult(const MYSQL_FIELD* fields, unsigned field_count, unsigned long long numRows)
+  : columns(field_count),
+    rowCount(0)
+{
+    columnIndex.reserve(field_count);
+    for (unsigned n = 0; n < field_count; ++n)
+    {
+        columns[n].name = fields[n].name ? fields[n].name : "";
+        columns[n].type = fields[n].type ? fields[n].type : MYSQL_TYPE_VAR_STRING;
+        columns[n].isUnsigned = bool(fields[n].flags & UNSIGNED_FLAG);
+        columnIndex.add(columns[n].name, n);
+    }
+
+    log_debug("result with " << numRows << " rows and " << field_count << " columns");
+
+    offsets.reserve(numRows * field_count + 1);
+    offsets.push_back(0);
+    nulls.reserve(numRows * field_count);
+}
+
+unsigned long StoredResult::fixedSize(enum_field_types type)
+{
+    switch (type)
+    {
+        case MYSQL_TYPE_TINY:
+            return 1;
+
+        case MYSQL_TYPE_SHORT:
+        case MYSQL_TYPE_YEAR:
+            return 2;
+
+        case MYSQL_TYPE_INT24:
+        case MYSQL_TYPE_LONG:
+        case MYSQL_TYPE_FLOAT:
+            return 4;
+
+        case MYSQL_TYPE_LONGLONG:
+        case MYSQL_TYPE_DOUBLE:
+            return 8;
+
+        case MYSQL_TYPE_DATE:
+        case MYSQL_TYPE_NEWDATE:
+        case MYSQL_TYPE_TIME:
+        case MYSQL_TYPE_DATETIME:
+        case MYSQL_TYPE_TIMESTAMP:
+            return sizeof(MYSQL_TIME);
+
+        default:
+            return 0;
+    }
+}
+
+void StoredResult::addRow(const MYSQL_BIND* bind)
+{
+    for (unsigned n = 0; n < columns.size(); ++n)
+    {
+        bool null = *bind[n].is_null;
+        nulls.push_back(null);
+        if (!null)
+        {
+            unsigned long len = fixedSize(columns[n].type);
+            if (len == 0)
+                len = *bind[n].length;
+            const char* p = static_cast<const char*>(bind[n].buffer);
+            data.insert(data.end(), p, p + len);
+        }
+        offsets.push_back(data.size());
+    }
+
+    ++rowCount;
+}
+
+Row StoredResult::getRow(size_type tup_num) const
+{
+    if (tup_num >= rowCount)
+        throw std::out_of_range("row number out of range");
+    return Row(std::make_shared<StoredRow>(shared_from_this(), tup_num));
+}
+
+StoredResult::size_type StoredResult::size() const
+{
+    return rowCount;
+}
+
+StoredResult::size_type StoredResult::getFieldCount() const
+{
+    return columns.size();
+}
+
+StoredRow::size_type StoredRow::size() const
+{
+    return _result->getFieldCount();
+}
+
+Value StoredRow::getValueByNumber(size_type field_num) const
+{
+    if (field_num >= _result->getFieldCount())
+        throw std::out_of_range("field number out of range");
+    return Value(std::make_shared<StoredValue>(_result, _tupNum, field_num));
+}
+
+Value StoredRow::getValueByName(const std::string& field_name) const
+{
+    return getValueByNumber(_result->getColumnIndex(field_name));
+}
+
+std::string StoredRow::getColumnName(size_type field_num) const
+{
+    return _result->getColumn(field_num).name;
+}
+
+StoredRow::size_type StoredRow::getColumnIndex(const std::string& field_name) const
+{
+    return _result->getColumnIndex(field_name);
+}
+
+bool StoredRow::isNull(size_type field_num) const
+{
+    return StoredValue(*_result, _tupNum, field_num).isNull();
+}
+
+bool StoredRow::getBool(size_type field_num) const
+{
+    return StoredValue(*_result, _tupNum, field_num).getBool();
+}
+
+short StoredRow::getShort(size_type field_num) const
+{
+    return StoredValue(*_result, _tupNum, field_num).getShort();
+}
+
+int StoredRow::getInt(size_type field_num) const
+{
+    return StoredValue(*_result, _tupNum, field_num).getInt();
+}
+
+long StoredRow::getLong(size_type field_num) const
+{
+    return StoredValue(*_result, _tupNum, field_num).getLong();
+}
+
+unsigned StoredRow::getUnsigned(size_type field_num) const
+{
+    return StoredValue(*_result, _tupNum, field_num).getUnsigned();
+}
+
+unsigned short StoredRow::getUnsignedShort(size_type field_num) const
+{
+    return StoredValue(*_result, _tupNum, field_num).getUnsignedShort();
+}
+
+unsigned long StoredRow::getUnsignedLong(size_type field_num) const
+{
+    return StoredValue(*_result, _tupNum, field_num).getUnsignedLong();
+}
+
+int32_t StoredRow::getInt32(size_type field_num) const
+{
+    return StoredValue(*_result, _tupNum, field_num).getInt32();
+}
+
+uint32_t StoredRow::getUnsigned32(size_type field_num) const
+{
+    return StoredValue(*_result, _tupNum, field_num).getUnsigned32();
+}
+
+int64_t StoredRow::getInt64(size_type field_num) const
+{
+    return StoredValue(*_result, _tupNum, field_num).getInt64();
+}
+
+uint64_t StoredRow::getUnsigned64(size_type field_num) const
+{
+    return StoredValue(*_result, _tupNum, field_num).getUnsigned64();
+}
+
+Decimal StoredRow::getDecimal(size_type field_num) const
+{
+    return StoredValue(*_result, _tupNum, field_num).getDecimal();
+}
+
+float StoredRow::getFloat(size_type field_num) const
+{
+    return StoredValue(*_result, _tupNum, field_num).getFloat();
+}
+
+double StoredRow::getDouble(size_type field_num) const
+{
+    return StoredValue(*_result, _tupNum, field_num).getDouble();
+}
+
+char StoredRow::getChar(size_type field_num) const
+{
+    return StoredValue(*_result, _tupNum, field_num).getChar();
+}
+
+void StoredRow::getString(size_type field_num, std::string& ret) const
+{
+    StoredValue(*_result, _tupNum, field_num).getString(ret);
+}
+
+void StoredRow::getBlob(size_type field_num, Blob& ret) const
+{
+    StoredValue(*_result, _tupNum, field_num).getBlob(ret);
+}
+
+Date StoredRow::getDate(size_type field_num) const
+{
+    return StoredValue(*_result, _tupNum, field_num).getDate();
+}
+
+Time StoredRow::getTime(size_type field_num) const
+{
+    return StoredValue(*_result, _tupNum, field_num).getTime();
+}
+
+Datetime StoredRow::getDatetime(size_type field_num) const
+{
+    return StoredValue(*_result, _tupNum, field_num).getDatetime();
+}
+
+}
+}
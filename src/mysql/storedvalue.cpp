@@ -0,0 +1,187 @@
+/*
+ * Copyright (C) 2005 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <tntdb/mysql/impl/storedvalue.h>
+#include <tntdb/mysql/impl/storedresult.h>
+#include <tntdb/mysql/bindutils.h>
+#include <tntdb/date.h>
+#include <tntdb/time.h>
+#include <tntdb/datetime.h>
+#include <tntdb/decimal.h>
+#include <string.h>
+
+namespace tntdb
+{
+namespace mysql
+{
+StoredValue::StoredValue(std::shared_ptr<const StoredResult> result, unsigned tup_num, unsigned field_num)
+  : StoredValue(*result, tup_num, field_num)
+{
+    _result = result;
+}
+
+StoredValue::StoredValue(const StoredResult& result, unsigned tup_num, unsigned field_num)
+  : _length(result.getLength(tup_num, field_num)),
+    _isNull(result.isNull(tup_num, field_num))
+{
+    const StoredResult::Column& column = result.getColumn(field_num);
+
+    ::memset(&mysql_bind, 0, sizeof(mysql_bind));
+    mysql_bind.buffer_type = column.type;
+    mysql_bind.is_unsigned = column.isUnsigned;
+    mysql_bind.length = &_length;
+    mysql_bind.is_null = &_isNull;
+    mysql_bind.buffer_length = _length;
+
+    const char* data = result.getData(tup_num, field_num);
+    if (StoredResult::fixedSize(column.type) > 0 && _length <= sizeof(_fixed))
+    {
+        ::memcpy(&_fixed, data, _length);
+        mysql_bind.buffer = &_fixed;
+    }
+    else
+        mysql_bind.buffer = const_cast<char*>(data);
+}
+
+bool StoredValue::isNull() const
+{
+    return mysql::isNull(mysql_bind);
+}
+
+bool StoredValue::getBool() const
+{
+    return mysql::getBool(mysql_bind);
+}
+
+short StoredValue::getShort() const
+{
+    return mysql::getShort(mysql_bind);
+}
+
+int StoredValue::getInt() const
+{
+    return mysql::getInt(mysql_bind);
+}
+
+long StoredValue::getLong() const
+{
+    return mysql::getLong(mysql_bind);
+}
+
+unsigned short StoredValue::getUnsignedShort() const
+{
+    return mysql::getUnsignedShort(mysql_bind);
+}
+
+unsigned StoredValue::getUnsigned() const
+{
+    return mysql::getUnsigned(mysql_bind);
+}
+
+unsigned long StoredValue::getUnsignedLong() const
+{
+    return mysql::getUnsignedLong(mysql_bind);
+}
+
+int32_t StoredValue::getInt32() const
+{
+    return mysql::getInt32(mysql_bind);
+}
+
+uint32_t StoredValue::getUnsigned32() const
+{
+    return mysql::getUnsigned32(mysql_bind);
+}
+
+int64_t StoredValue::getInt64() const
+{
+    return mysql::getInt64(mysql_bind);
+}
+
+uint64_t StoredValue::getUnsigned64() const
+{
+    return mysql::getUnsigned64(mysql_bind);
+}
+
+Decimal StoredValue::getDecimal() const
+{
+    return mysql::getDecimal(mysql_bind);
+}
+
+float StoredValue::getFloat() const
+{
+    return mysql::getFloat(mysql_bind);
+}
+
+double StoredValue::getDouble() const
+{
+    return mysql::getDouble(mysql_bind);
+}
+
+char StoredValue::getChar() const
+{
+    return mysql::getChar(mysql_bind);
+}
+
+void StoredValue::getString(std::string& ret) const
+{
+    mysql::getString(mysql_bind, ret);
+}
+
+void StoredValue::getBlob(Blob& ret) const
+{
+    mysql::getBlob(mysql_bind, ret);
+}
+
+bool StoredValue::getStringView(const char*& data, std::size_t& length) const
+{
+    return mysql::getStringData(mysql_bind, data, length);
+}
+
+bool StoredValue::getBlobView(const char*& data, std::size_t& length) const
+{
+    return mysql::getBlobData(mysql_bind, data, length);
+}
+
+Date StoredValue::getDate() const
+{
+    return mysql::getDate(mysql_bind);
+}
+
+Time StoredValue::getTime() const
+{
+    return mysql::getTime(mysql_bind);
+}
+
+Datetime StoredValue::getDatetime() const
+{
+    return mysql::getDatetime(mysql_bind);
+}
+
+}
+}
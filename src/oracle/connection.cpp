@@ -349,6 +349,12 @@ bool Connection::ping()
     }
 }
 
+bool Connection::isAlive()
+{
+    // the connection is not valid any more after a fork
+    return pid == getpid();
+}
+
 long Connection::lastInsertId(const std::string& name)
 {
     tntdb::Statement stmt;
@@ -71,6 +71,11 @@ tntdb::Value Row::getValueByNumber(size_type field_num) const
 }
 
 tntdb::Value Row::getValueByName(const std::string& field_name) const
+{
+    return tntdb::Value(_values[getColumnIndex(field_name)]);
+}
+
+Row::size_type Row::getColumnIndex(const std::string& field_name) const
 {
     std::string field_name_upper;
     field_name_upper.reserve(field_name.size());
@@ -78,9 +83,9 @@ tntdb::Value Row::getValueByName(const std::string& field_name) const
         it != field_name.end(); ++it)
         field_name_upper += std::toupper(*it);
 
-    for (const auto& v: _values)
-        if (v->getColumnName() == field_name_upper)
-            return tntdb::Value(v);
+    for (size_type n = 0; n < _values.size(); ++n)
+        if (_values[n]->getColumnName() == field_name_upper)
+            return n;
 
     throw FieldNotFound(field_name);
 }
@@ -75,7 +75,12 @@ tntdb::Value SingleRow::getValueByNumber(size_type field_num) const
 
 tntdb::Value SingleRow::getValueByName(const std::string& field_name) const
 {
-    return getValueByNumber(_mr->getColIndexByName(field_name));
+    return getValueByNumber(getColumnIndex(field_name));
+}
+
+SingleRow::size_type SingleRow::getColumnIndex(const std::string& field_name) const
+{
+    return _mr->getColIndexByName(field_name);
 }
 
 std::string SingleRow::getColumnName(size_type field_num) const
@@ -41,7 +41,8 @@ PoolConnection::PoolConnection(std::shared_ptr<IConnection>&& connection, Connec
     : _connectionPool(connectionPool),
       _connection(connection),
       _inTransaction(false),
-      _drop(false)
+      _drop(false),
+      _checkoutTime(ConnectionPool::Clock::now())
 {
     log_debug("PoolConnection " << this << " for connection " << _connection);
 }
@@ -50,10 +51,17 @@ PoolConnection::~PoolConnection()
 {
     // don't put the connection back to the free pool, when there is a
     // pending transaction or something unusual has happened
-    if (_inTransaction || _drop)
+    bool dropped = _inTransaction || _drop;
+    _connectionPool.checkedIn(_checkoutTime, dropped);
+
+    if (dropped)
+    {
         log_debug("don't reuse connection " << _connection);
-   else
-       _connectionPool.put(_connection);
+        _connection.reset();
+        _connectionPool.release();
+    }
+    else
+        _connectionPool.put(_connection);
 }
 
 void PoolConnection::beginTransaction()
@@ -117,6 +125,19 @@ bool PoolConnection::ping()
     return ok;
 }
 
+bool PoolConnection::isAlive()
+{
+    bool ok = _connection->isAlive();
+    if (!ok)
+        _drop = true;
+    return ok;
+}
+
+bool PoolConnection::getMetrics(ConnectionMetrics& metrics)
+{
+    return _connection->getMetrics(metrics);
+}
+
 long PoolConnection::lastInsertId(const std::string& name)
 {
     return _connection->lastInsertId(name);
@@ -0,0 +1,627 @@
+/*
+ * Copyright (C) 2005 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <tntdb/postgresql/binaryformat.h>
+#include <tntdb/impl/textconv.h>
+#include <tntdb/date.h>
+#include <tntdb/time.h>
+#include <tntdb/datetime.h>
+#include <tntdb/decimal.h>
+#include <tntdb/error.h>
+#include <vector>
+#include <limits>
+#include <string.h>
+#include <stdio.h>
+#include <stdint.h>
+
+namespace tntdb
+{
+namespace postgresql
+{
+namespace
+{
+    // postgresql uses network byte order
+    template <typename T>
+    void appendInteger(std::string& ret, T value)
+    {
+        for (int n = sizeof(T) - 1; n >= 0; --n)
+            ret += static_cast<char>((static_cast<uint64_t>(value) >> (n * 8)) & 0xff);
+    }
+
+    bool encodeInteger(Oid type, int64_t value, std::string& ret)
+    {
+        ret.clear();
+        switch (type)
+        {
+            case pgInt2Oid:
+                if (value < std::numeric_limits<int16_t>::min()
+                  || value > std::numeric_limits<int16_t>::max())
+                    return false;
+                appendInteger(ret, static_cast<int16_t>(value));
+                return true;
+
+            case pgInt4Oid:
+                if (value < std::numeric_limits<int32_t>::min()
+                  || value > std::numeric_limits<int32_t>::max())
+                    return false;
+                appendInteger(ret, static_cast<int32_t>(value));
+                return true;
+
+            case pgInt8Oid:
+                appendInteger(ret, value);
+                return true;
+
+            default:
+                return false;
+        }
+    }
+
+    bool encodeUnsigned(Oid type, uint64_t value, std::string& ret)
+    {
+        if (value > static_cast<uint64_t>(std::numeric_limits<int64_t>::max()))
+            return false;
+        return encodeInteger(type, static_cast<int64_t>(value), ret);
+    }
+
+    // Converts a number in fixed point notation ([-]digits[.digits]) to
+    // the binary numeric format: number of digits, weight, sign and display
+    // scale followed by the digits in base 10000.
+    bool encodeNumeric(const std::string& value, std::string& ret)
+    {
+        ret.clear();
+
+        std::string::size_type pos = 0;
+        bool negative = false;
+        if (pos < value.size() && value[pos] == '-')
+        {
+            negative = true;
+            ++pos;
+        }
+
+        std::string intPart;
+        std::string fracPart;
+        bool frac = false;
+        for (; pos < value.size(); ++pos)
+        {
+            char ch = value[pos];
+            if (ch == '.' && !frac)
+                frac = true;
+            else if (ch >= '0' && ch <= '9')
+                (frac ? fracPart : intPart) += ch;
+            else
+                return false;  // inf, nan or unexpected format
+        }
+
+        if (fracPart.size() > 0x3fff)
+            return false;
+
+        uint16_t dscale = fracPart.size();
+
+        intPart.insert(0u, (4 - intPart.size() % 4) % 4, '0');
+        fracPart.append((4 - fracPart.size() % 4) % 4, '0');
+
+        std::vector<int16_t> digits;
+        std::string all = intPart + fracPart;
+        for (std::string::size_type n = 0; n < all.size(); n += 4)
+            digits.push_back(static_cast<int16_t>(
+                (all[n] - '0') * 1000 + (all[n + 1] - '0') * 100
+                + (all[n + 2] - '0') * 10 + (all[n + 3] - '0')));
+
+        int weight = static_cast<int>(intPart.size() / 4) - 1;
+
+        std::vector<int16_t>::size_type first = 0;
+        while (first < digits.size() && digits[first] == 0)
+        {
+            ++first;
+            --weight;
+        }
+
+        std::vector<int16_t>::size_type last = digits.size();
+        while (last > first && digits[last - 1] == 0)
+            --last;
+
+        if (first == last)
+        {
+            weight = 0;
+            negative = false;
+        }
+
+        if (weight < std::numeric_limits<int16_t>::min()
+          || weight > std::numeric_limits<int16_t>::max())
+            return false;
+
+        appendInteger(ret, static_cast<int16_t>(last - first));
+        appendInteger(ret, static_cast<int16_t>(weight));
+        appendInteger(ret, static_cast<uint16_t>(negative ? 0x4000 : 0));
+        appendInteger(ret, dscale);
+        for (std::vector<int16_t>::size_type n = first; n < last; ++n)
+            appendInteger(ret, digits[n]);
+
+        return true;
+    }
+
+    // days since 2000-01-01, which is the epoch of postgresql
+    int32_t pgDays(int year, unsigned month, unsigned day)
+    {
+        year -= month <= 2;
+        const int era = (year >= 0 ? year : year - 399) / 400;
+        const unsigned yoe = static_cast<unsigned>(year - era * 400);
+        const unsigned doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+        const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        // doe counts from 0000-03-01; 730425 is the day number of 2000-01-01
+        return era * 146097 + static_cast<int>(doe) - 730425;
+    }
+
+    int64_t pgMicroseconds(unsigned hour, unsigned minute, unsigned second, unsigned millis)
+    {
+        return ((static_cast<int64_t>(hour) * 60 + minute) * 60 + second) * 1000000
+             + static_cast<int64_t>(millis) * 1000;
+    }
+
+    // inverse of pgDays
+    Date pgDate(int32_t days)
+    {
+        int z = days + 730425;
+        const int era = (z >= 0 ? z : z - 146096) / 146097;
+        const unsigned doe = static_cast<unsigned>(z - era * 146097);
+        const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+        const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+        const unsigned mp = (5 * doy + 2) / 153;
+        const unsigned day = doy - (153 * mp + 2) / 5 + 1;
+        const unsigned month = mp < 10 ? mp + 3 : mp - 9;
+        const int year = static_cast<int>(yoe) + era * 400 + (month <= 2);
+        return Date(year, month, day);
+    }
+
+    Time pgTime(int64_t microseconds)
+    {
+        int64_t millis = microseconds / 1000;
+        return Time(static_cast<unsigned short>(millis / 3600000),
+                    static_cast<unsigned short>(millis / 60000 % 60),
+                    static_cast<unsigned short>(millis / 1000 % 60),
+                    static_cast<unsigned short>(millis % 1000));
+    }
+
+    template <typename T>
+    T readInteger(const char* data)
+    {
+        uint64_t ret = 0;
+        for (unsigned n = 0; n < sizeof(T); ++n)
+            ret = (ret << 8) | static_cast<unsigned char>(data[n]);
+        return static_cast<T>(ret);
+    }
+
+    bool readTimestamp(Oid type, const char* data, int len, int32_t& days, int64_t& microseconds)
+    {
+        if ((type != pgTimestampOid && type != pgTimestamptzOid) || len != 8)
+            return false;
+
+        int64_t t = readInteger<int64_t>(data);
+        days = static_cast<int32_t>(t / (int64_t(86400) * 1000000));
+        microseconds = t % (int64_t(86400) * 1000000);
+        if (microseconds < 0)
+        {
+            --days;
+            microseconds += int64_t(86400) * 1000000;
+        }
+
+        return true;
+    }
+
+    std::string decodeNumeric(const char* data, int len)
+    {
+        if (len < 8)
+            throw TypeError("invalid binary numeric value");
+
+        int ndigits = readInteger<int16_t>(data);
+        int weight = readInteger<int16_t>(data + 2);
+        unsigned sign = readInteger<uint16_t>(data + 4);
+        unsigned dscale = readInteger<uint16_t>(data + 6);
+
+        if (len < 8 + ndigits * 2)
+            throw TypeError("invalid binary numeric value");
+
+        switch (sign)
+        {
+            case 0xc000: return "NaN";
+            case 0xd000: return "Infinity";
+            case 0xf000: return "-Infinity";
+        }
+
+        std::string ret;
+        if (sign == 0x4000)
+            ret = '-';
+
+        char buffer[5];
+        if (weight < 0)
+            ret += '0';
+        else
+        {
+            for (int n = 0; n <= weight; ++n)
+            {
+                int d = n < ndigits ? readInteger<int16_t>(data + 8 + n * 2) : 0;
+                snprintf(buffer, sizeof(buffer), n == 0 ? "%d" : "%04d", d);
+                ret += buffer;
+            }
+        }
+
+        if (dscale > 0)
+        {
+            std::string frac;
+            for (int n = weight + 1; frac.size() < dscale; ++n)
+            {
+                int d = n >= 0 && n < ndigits ? readInteger<int16_t>(data + 8 + n * 2) : 0;
+                snprintf(buffer, sizeof(buffer), "%04d", d);
+                frac += buffer;
+            }
+            frac.resize(dscale);
+            ret += '.';
+            ret += frac;
+        }
+
+        return ret;
+    }
+}
+
+bool encodeBinary(Oid type, short value, std::string& ret)
+{
+    return encodeInteger(type, value, ret);
+}
+
+bool encodeBinary(Oid type, unsigned short value, std::string& ret)
+{
+    return encodeInteger(type, value, ret);
+}
+
+bool encodeBinary(Oid type, int value, std::string& ret)
+{
+    return encodeInteger(type, value, ret);
+}
+
+bool encodeBinary(Oid type, unsigned value, std::string& ret)
+{
+    return encodeInteger(type, value, ret);
+}
+
+bool encodeBinary(Oid type, long value, std::string& ret)
+{
+    return encodeInteger(type, value, ret);
+}
+
+bool encodeBinary(Oid type, unsigned long value, std::string& ret)
+{
+    return encodeUnsigned(type, value, ret);
+}
+
+bool encodeBinary(Oid type, long long value, std::string& ret)
+{
+    return encodeInteger(type, value, ret);
+}
+
+bool encodeBinary(Oid type, unsigned long long value, std::string& ret)
+{
+    return encodeUnsigned(type, value, ret);
+}
+
+bool encodeBinary(Oid type, bool value, std::string& ret)
+{
+    if (type != pgBoolOid)
+        return false;
+
+    ret.assign(1, value ? '\1' : '\0');
+    return true;
+}
+
+bool encodeBinary(Oid type, float value, std::string& ret)
+{
+    if (type == pgFloat8Oid)
+        return encodeBinary(type, static_cast<double>(value), ret);
+
+    if (type != pgFloat4Oid)
+        return false;
+
+    uint32_t i;
+    ::memcpy(&i, &value, sizeof(i));
+    ret.clear();
+    appendInteger(ret, i);
+    return true;
+}
+
+bool encodeBinary(Oid type, double value, std::string& ret)
+{
+    if (type != pgFloat8Oid)
+        return false;
+
+    uint64_t i;
+    ::memcpy(&i, &value, sizeof(i));
+    ret.clear();
+    appendInteger(ret, i);
+    return true;
+}
+
+bool encodeBinary(Oid type, const Decimal& value, std::string& ret)
+{
+    if (type != pgNumericOid)
+        return false;
+
+    if (value.isNaN())
+    {
+        ret.clear();
+        appendInteger(ret, static_cast<int16_t>(0));
+        appendInteger(ret, static_cast<int16_t>(0));
+        appendInteger(ret, static_cast<uint16_t>(0xc000));
+        appendInteger(ret, static_cast<uint16_t>(0));
+        return true;
+    }
+
+    return encodeNumeric(value.toStringFix(), ret);
+}
+
+bool encodeBinary(Oid type, const Date& value, std::string& ret)
+{
+    if (type != pgDateOid || value.isNull())
+        return false;
+
+    ret.clear();
+    appendInteger(ret, pgDays(value.getYear(), value.getMonth(), value.getDay()));
+    return true;
+}
+
+bool encodeBinary(Oid type, const Time& value, std::string& ret)
+{
+    if (type != pgTimeOid || value.isNull())
+        return false;
+
+    ret.clear();
+    appendInteger(ret, pgMicroseconds(value.getHour(), value.getMinute(),
+                                      value.getSecond(), value.getMillis()));
+    return true;
+}
+
+bool encodeBinary(Oid type, const Datetime& value, std::string& ret)
+{
+    if (type != pgTimestampOid || value.isNull())
+        return false;
+
+    int64_t days = pgDays(value.getYear(), value.getMonth(), value.getDay());
+    ret.clear();
+    appendInteger(ret, days * 86400 * 1000000
+                     + pgMicroseconds(value.getHour(), value.getMinute(),
+                                      value.getSecond(), value.getMillis()));
+    return true;
+}
+
+bool decodeBinary(Oid type, const char* data, int len, int64_t& ret)
+{
+    switch (type)
+    {
+        case pgBoolOid:
+            if (len != 1)
+                return false;
+            ret = data[0] != 0;
+            return true;
+
+        case pgInt2Oid:
+            if (len != 2)
+                return false;
+            ret = readInteger<int16_t>(data);
+            return true;
+
+        case pgInt4Oid:
+            if (len != 4)
+                return false;
+            ret = readInteger<int32_t>(data);
+            return true;
+
+        case pgInt8Oid:
+            if (len != 8)
+                return false;
+            ret = readInteger<int64_t>(data);
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+bool decodeBinary(Oid type, const char* data, int len, double& ret)
+{
+    switch (type)
+    {
+        case pgFloat4Oid:
+        {
+            if (len != 4)
+                return false;
+            uint32_t i = readInteger<uint32_t>(data);
+            float f;
+            ::memcpy(&f, &i, sizeof(f));
+            ret = f;
+            return true;
+        }
+
+        case pgFloat8Oid:
+        {
+            if (len != 8)
+                return false;
+            uint64_t i = readInteger<uint64_t>(data);
+            ::memcpy(&ret, &i, sizeof(ret));
+            return true;
+        }
+
+        default:
+        {
+            int64_t i;
+            if (!decodeBinary(type, data, len, i))
+                return false;
+            ret = static_cast<double>(i);
+            return true;
+        }
+    }
+}
+
+bool decodeBinary(Oid type, const char* data, int len, bool& ret)
+{
+    int64_t i;
+    if (!decodeBinary(type, data, len, i))
+        return false;
+    ret = i != 0;
+    return true;
+}
+
+bool decodeBinary(Oid type, const char* data, int len, Date& ret)
+{
+    if (type == pgDateOid && len == 4)
+    {
+        ret = pgDate(readInteger<int32_t>(data));
+        return true;
+    }
+
+    int32_t days;
+    int64_t microseconds;
+    if (!readTimestamp(type, data, len, days, microseconds))
+        return false;
+
+    ret = pgDate(days);
+    return true;
+}
+
+bool decodeBinary(Oid type, const char* data, int len, Time& ret)
+{
+    if (type == pgTimeOid && len == 8)
+    {
+        ret = pgTime(readInteger<int64_t>(data));
+        return true;
+    }
+
+    int32_t days;
+    int64_t microseconds;
+    if (!readTimestamp(type, data, len, days, microseconds))
+        return false;
+
+    ret = pgTime(microseconds);
+    return true;
+}
+
+bool decodeBinary(Oid type, const char* data, int len, Datetime& ret)
+{
+    if (type == pgDateOid && len == 4)
+    {
+        ret = Datetime(pgDate(readInteger<int32_t>(data)), Time(0, 0, 0));
+        return true;
+    }
+
+    int32_t days;
+    int64_t microseconds;
+    if (!readTimestamp(type, data, len, days, microseconds))
+        return false;
+
+    ret = Datetime(pgDate(days), pgTime(microseconds));
+    return true;
+}
+
+void binaryToString(Oid type, const char* data, int len, std::string& ret)
+{
+    switch (type)
+    {
+        case pgBoolOid:
+            if (len == 1)
+            {
+                ret = data[0] ? "t" : "f";
+                return;
+            }
+            break;
+
+        case pgInt2Oid:
+        case pgInt4Oid:
+        case pgInt8Oid:
+        {
+            int64_t i;
+            if (decodeBinary(type, data, len, i))
+            {
+                ret = textconv::toString(i);
+                return;
+            }
+            break;
+        }
+
+        case pgFloat4Oid:
+        case pgFloat8Oid:
+        {
+            double d;
+            if (decodeBinary(type, data, len, d))
+            {
+                ret = textconv::toString(d);
+                return;
+            }
+            break;
+        }
+
+        case pgNumericOid:
+            ret = decodeNumeric(data, len);
+            return;
+
+        case pgDateOid:
+        {
+            Date d;
+            if (decodeBinary(type, data, len, d))
+            {
+                ret = d.getIso();
+                return;
+            }
+            break;
+        }
+
+        case pgTimeOid:
+        {
+            Time t;
+            if (decodeBinary(type, data, len, t))
+            {
+                ret = t.getIso();
+                return;
+            }
+            break;
+        }
+
+        case pgTimestampOid:
+        case pgTimestamptzOid:
+        {
+            Datetime dt;
+            if (decodeBinary(type, data, len, dt))
+            {
+                ret = dt.getIso();
+                return;
+            }
+            break;
+        }
+    }
+
+    ret.assign(data, len);
+}
+
+}
+}
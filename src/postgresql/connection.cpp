@@ -38,6 +38,7 @@
 #include <cxxtools/log.h>
 #include <new>
 #include <poll.h>
+#include <string.h>
 
 log_define("tntdb.postgresql.connection")
 
@@ -45,13 +46,79 @@ namespace tntdb
 {
 namespace postgresql
 {
+namespace
+{
+    bool isSpace(char ch)
+    {
+        return ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r';
+    }
+
+    // Read the results of the pipeline, before more commands are queued.
+    // The server blocks, when its results are not read, while we block
+    // sending more commands.
+    const unsigned maxPipelineEntries = 1000;
+
+    // Removes an option, which libpq does not know, from the connection
+    // string and returns its value. Both the keyword/value form and the
+    // query string of the uri form are supported.
+    bool extractOption(std::string& conninfo, const std::string& key, std::string& value)
+    {
+        std::string::size_type pos = 0;
+        while ((pos = conninfo.find(key + '=', pos)) != std::string::npos)
+        {
+            if (pos == 0 || isSpace(conninfo[pos - 1])
+                || conninfo[pos - 1] == '?' || conninfo[pos - 1] == '&')
+                break;
+            ++pos;
+        }
+
+        if (pos == std::string::npos)
+            return false;
+
+        bool uri = pos > 0 && (conninfo[pos - 1] == '?' || conninfo[pos - 1] == '&');
+
+        std::string::size_type begin = pos + key.size() + 1;
+        std::string::size_type end = begin;
+        while (end < conninfo.size() && !isSpace(conninfo[end]) && !(uri && conninfo[end] == '&'))
+            ++end;
+
+        value = conninfo.substr(begin, end - begin);
+
+        if (uri)
+        {
+            // remove one of the separators around the option
+            if (conninfo[pos - 1] == '&')
+                --pos;
+            else if (end < conninfo.size() && conninfo[end] == '&')
+                ++end;
+            else
+                --pos;
+        }
+        else
+        {
+            while (end < conninfo.size() && isSpace(conninfo[end]))
+                ++end;
+        }
+
+        conninfo.erase(pos, end - pos);
+        return true;
+    }
+}
+
 Connection::Connection(const std::string& url_, const std::string& username, const std::string& password)
   : transactionActive(0),
-    stmtCounter(0)
+    stmtCounter(0),
+    pipelineMode(false),
+    maxUnusedPrepared(defaultMaxUnusedPrepared)
 {
-    log_debug("PQconnectdb(\"" << url_ << "\")");
+    std::string conninfo = url_;
+    std::string value;
+    if (extractOption(conninfo, "tntdb_max_unused_prepared", value))
+        maxUnusedPrepared = cxxtools::convert<unsigned>(value);
+
+    log_debug("PQconnectdb(\"" << conninfo << "\")");
 
-    conn = PQconnectdb(url(url_, username, password).c_str());
+    conn = PQconnectdb(url(conninfo, username, password).c_str());
     if (conn == 0)
         throw std::bad_alloc();
 
@@ -82,6 +149,9 @@ void Connection::beginTransaction()
 
 void Connection::commitTransaction()
 {
+    if (transactionActive <= 1)
+        flushDelayed();
+
     if (transactionActive == 0 || --transactionActive == 0)
     {
         execute("COMMIT");
@@ -93,6 +163,15 @@ void Connection::rollbackTransaction()
 {
     if (transactionActive == 0 || --transactionActive == 0)
     {
+        try
+        {
+            flushDelayed();
+        }
+        catch (const std::exception& e)
+        {
+            log_debug("ignore error in delayed statement: " << e.what());
+        }
+
         execute("ROLLBACK");
         deallocateStatements();
     }
@@ -102,9 +181,12 @@ Connection::size_type Connection::execute(const std::string& query)
 {
     log_debug("execute(\"" << query << "\")");
 
+    flushDelayed();
+
     log_debug("PQexec(" << conn << ", \"" << query << "\")");
     PGresult* result = PQexec(conn, query.c_str());
     log_debug("PGresult=" << static_cast<void*>(result));
+    countRoundTrip(query.size());
     if (isError(result))
     {
         log_error(PQresultErrorMessage(result));
@@ -123,15 +205,20 @@ Connection::size_type Connection::execute(const std::string& query)
 
 std::shared_ptr<Result> Connection::pgselect(const std::string& query)
 {
+    flushDelayed();
+
     log_debug("PQexec(" << conn << ", \"" << query << "\")");
     PGresult* result = PQexec(conn, query.c_str());
     log_debug("PGresult=" << static_cast<void*>(result));
+    countRoundTrip(query.size());
     if (isError(result))
     {
         log_error(PQresultErrorMessage(result));
         throw PgSqlError(query, "PQexec", result, true);
     }
 
+    countResult(result);
+
     return std::make_shared<Result>(result);
 }
 
@@ -189,12 +276,23 @@ bool Connection::ping()
 {
     log_debug("ping()");
 
+    try
+    {
+        flushDelayed();
+    }
+    catch (const std::exception& e)
+    {
+        log_warn("error in delayed statement: " << e.what());
+    }
+
     if (PQsendQuery(conn, "select 1") == 0)
     {
         log_debug("failed to send statement \"select 1\" to database in Connection::ping()");
         return false;
     }
 
+    countRoundTrip(8);
+
     while (true)
     {
         struct pollfd fd;
@@ -230,6 +328,45 @@ bool Connection::ping()
     }
 }
 
+bool Connection::isAlive()
+{
+    // An idle connection receives data only, when the server sends a notice
+    // or closes the connection. Consume it without blocking, so that libpq
+    // notices a closed connection.
+    struct pollfd fd;
+    fd.fd = PQsocket(conn);
+    if (fd.fd < 0)
+        return false;
+
+    fd.events = POLLIN;
+    if (::poll(&fd, 1, 0) == 1 && PQconsumeInput(conn) == 0)
+    {
+        log_debug("PQconsumeInput failed in Connection::isAlive()");
+        return false;
+    }
+
+    return PQstatus(conn) == CONNECTION_OK;
+}
+
+bool Connection::getMetrics(ConnectionMetrics& m)
+{
+    m.roundTrips += metrics.roundTrips;
+    m.bytesSent += metrics.bytesSent;
+    m.bytesReceived += metrics.bytesReceived;
+    m.rowsFetched += metrics.rowsFetched;
+    return true;
+}
+
+void Connection::countResult(const PGresult* result)
+{
+    int rows = PQntuples(result);
+    int columns = PQnfields(result);
+    for (int r = 0; r < rows; ++r)
+        for (int c = 0; c < columns; ++c)
+            metrics.bytesReceived += PQgetlength(result, r, c);
+    metrics.rowsFetched += rows;
+}
+
 long Connection::lastInsertId(const std::string& name)
 {
     long ret = 0;
@@ -276,6 +413,7 @@ void Connection::deallocateStatements()
         log_debug("PQexec(" << getPGConn() << ", \"" << sql << "\")");
         PGresult* result = PQexec(getPGConn(), sql.c_str());
         log_debug("PGresult=" << static_cast<void*>(result));
+        countRoundTrip(sql.size());
 
         if (isError(result))
             log_error("error deallocating statement: " << PQresultErrorMessage(result));
@@ -287,6 +425,85 @@ void Connection::deallocateStatements()
     stmtsToDeallocate.clear();
 }
 
+bool Connection::acquirePrepared(const std::string& query, const std::vector<Oid>& paramTypes, std::string& name)
+{
+    PreparedStatements::iterator it = preparedStatements.find(query);
+    if (it == preparedStatements.end() || it->second.paramTypes != paramTypes)
+        return false;
+
+    PreparedStatement& p = it->second;
+    if (p.refs++ == 0)
+        unusedPrepared.erase(p.unused);
+
+    log_debug("reuse prepared statement " << p.name);
+    name = p.name;
+    return true;
+}
+
+bool Connection::integerDatetimes() const
+{
+    const char* value = PQparameterStatus(conn, "integer_datetimes");
+    return value && strcmp(value, "on") == 0;
+}
+
+bool Connection::registerPrepared(const std::string& query, const std::string& name, const std::vector<Oid>& paramTypes)
+{
+    if (preparedStatements.find(query) != preparedStatements.end())
+        return false;
+
+    PreparedStatement& p = preparedStatements[query];
+    p.name = name;
+    p.paramTypes = paramTypes;
+    p.refs = 1;
+    return true;
+}
+
+void Connection::releasePrepared(const std::string& query)
+{
+    PreparedStatements::iterator it = preparedStatements.find(query);
+    if (it == preparedStatements.end())
+        return;
+
+    PreparedStatement& p = it->second;
+    if (--p.refs > 0)
+        return;
+
+    p.unused = unusedPrepared.insert(unusedPrepared.end(), query);
+    deallocateUnused();
+}
+
+void Connection::setMaxUnusedPrepared(unsigned n)
+{
+    maxUnusedPrepared = n;
+    deallocateUnused();
+}
+
+void Connection::deallocateUnused()
+{
+    while (unusedPrepared.size() > maxUnusedPrepared)
+    {
+        PreparedStatements::iterator lru = preparedStatements.find(unusedPrepared.front());
+        log_debug("deallocate least recently used statement " << lru->second.name);
+        deallocateStatement(lru->second.name);
+        preparedStatements.erase(lru);
+        unusedPrepared.pop_front();
+    }
+}
+
+void Connection::forgetPrepared(const std::string& name)
+{
+    for (PreparedStatements::iterator it = preparedStatements.begin(); it != preparedStatements.end(); ++it)
+    {
+        if (it->second.name == name)
+        {
+            if (it->second.refs == 0)
+                unusedPrepared.erase(it->second.unused);
+            preparedStatements.erase(it);
+            return;
+        }
+    }
+}
+
 void Connection::lockTable(const std::string& tablename, bool exclusive)
 {
     std::string query = "LOCK TABLE ";
@@ -296,5 +513,235 @@ void Connection::lockTable(const std::string& tablename, bool exclusive)
     tntdb::Statement lockStmt = prepare(query);
     lockStmt.execute();
 }
+
+void Connection::enterPipelineMode()
+{
+#ifdef LIBPQ_HAS_PIPELINING
+    if (!pipelineMode)
+    {
+        log_debug("PQenterPipelineMode(" << conn << ')');
+        if (PQenterPipelineMode(conn) == 0)
+            throw PgConnError("PQenterPipelineMode", conn);
+        pipelineMode = true;
+    }
+#endif
+}
+
+void Connection::addPipelineEntry(Statement* stmt, bool prepare)
+{
+    PipelineEntry e;
+    e.stmt = stmt;
+    e.prepare = prepare;
+    if (prepare)
+        e.stmtName = stmt->getStmtName();
+    pipeline.push_back(e);
+}
+
+#ifdef LIBPQ_HAS_PIPELINING
+// Leaves pipeline mode, when the results of the pipeline are read. When
+// reading fails, the remaining results are discarded and the statements
+// of the unread commands are reset, so that the connection stays usable.
+class Connection::PipelineGuard
+{
+    Connection& _conn;
+    std::vector<PipelineEntry>& _entries;
+
+public:
+    std::vector<PipelineEntry>::size_type next;
+    bool syncSent;
+    bool syncRead;
+    bool done;
+
+    PipelineGuard(Connection& conn, std::vector<PipelineEntry>& entries)
+        : _conn(conn),
+          _entries(entries),
+          next(0),
+          syncSent(false),
+          syncRead(false),
+          done(false)
+        { }
+
+    ~PipelineGuard()
+    {
+        if (!done)
+            abort();
+    }
+
+    void abort();
+};
+
+void Connection::PipelineGuard::abort()
+{
+    PGconn* conn = _conn.conn;
+
+    for ( ; next < _entries.size(); ++next)
+    {
+        const PipelineEntry& e = _entries[next];
+        if (e.prepare)
+        {
+            _conn.forgetPrepared(e.stmtName);
+            if (e.stmt)
+                e.stmt->prepareFailed();
+        }
+        else if (e.stmt)
+            e.stmt->delayedResult(0);
+    }
+
+    if (!syncSent)
+    {
+        log_debug("PQpipelineSync(" << conn << ')');
+        syncSent = PQpipelineSync(conn) != 0;
+    }
+
+    // discard the results up to the result of the sync; two null results
+    // in a row mean, that there is nothing more to read
+    unsigned nulls = 0;
+    while (syncSent && !syncRead && nulls < 2 && PQstatus(conn) != CONNECTION_BAD)
+    {
+        PGresult* result = PQgetResult(conn);
+        if (result == 0)
+        {
+            ++nulls;
+            continue;
+        }
+
+        nulls = 0;
+        syncRead = PQresultStatus(result) == PGRES_PIPELINE_SYNC;
+        PQclear(result);
+    }
+
+    log_debug("PQexitPipelineMode(" << conn << ')');
+    if (PQexitPipelineMode(conn) == 0)
+        log_warn("PQexitPipelineMode failed: " << PQerrorMessage(conn));
+
+    _conn.pipelineMode = false;
+}
+#endif
+
+void Connection::flushDelayed()
+{
+#ifdef LIBPQ_HAS_PIPELINING
+    if (!pipelineMode)
+        return;
+
+    std::vector<PipelineEntry> entries;
+    entries.swap(pipeline);
+
+    PipelineGuard guard(*this, entries);
+
+    log_debug("PQpipelineSync(" << conn << ')');
+    if (PQpipelineSync(conn) == 0)
+        throw PgConnError("PQpipelineSync", conn);
+    guard.syncSent = true;
+
+    // the commands are already counted when sent; all results are read with
+    // a single round trip
+    countRoundTrip(0);
+
+    std::string errorQuery;
+    PGresult* errorResult = 0;
+
+    try
+    {
+        for ( ; guard.next < entries.size(); ++guard.next)
+        {
+            const PipelineEntry& e = entries[guard.next];
+
+            // each command returns its results followed by a null result
+            log_debug("PQgetResult(" << conn << ')');
+            PGresult* result = PQgetResult(conn);
+            log_debug("PGresult=" << static_cast<void*>(result));
+            if (result)
+            {
+                PGresult* r;
+                while ((r = PQgetResult(conn)) != 0)
+                    PQclear(r);
+            }
+            else if (errorResult == 0)
+            {
+                // no result at all; the connection is probably lost and
+                // the guard resets this and the remaining commands
+                throw PgSqlError(e.stmt ? e.stmt->getQuery() : std::string(), "PQgetResult", conn);
+            }
+
+            size_type count = 0;
+            if (result == 0 || isError(result))
+            {
+                if (e.prepare)
+                {
+                    forgetPrepared(e.stmtName);
+                    if (e.stmt)
+                        e.stmt->prepareFailed();
+                }
+
+                // commands after a failed one are aborted; report the first error
+                if (errorResult == 0 && PQresultStatus(result) != PGRES_PIPELINE_ABORTED)
+                {
+                    log_error(PQresultErrorMessage(result));
+                    errorQuery = e.stmt ? e.stmt->getQuery() : std::string();
+                    errorResult = result;
+                    result = 0;
+                }
+            }
+            else if (!e.prepare)
+            {
+                std::string t = PQcmdTuples(result);
+                count = t.empty() ? 0 : cxxtools::convert<size_type>(t);
+            }
+
+            if (!e.prepare && e.stmt)
+                e.stmt->delayedResult(count);
+
+            if (result)
+            {
+                log_debug("PQclear(" << result << ')');
+                PQclear(result);
+            }
+        }
+
+        // read the result of the sync
+        log_debug("PQgetResult(" << conn << ')');
+        PGresult* result = PQgetResult(conn);
+        if (result)
+        {
+            guard.syncRead = PQresultStatus(result) == PGRES_PIPELINE_SYNC;
+            PQclear(result);
+        }
+    }
+    catch (...)
+    {
+        if (errorResult)
+            PQclear(errorResult);
+        throw;
+    }
+
+    if (guard.syncRead)
+    {
+        log_debug("PQexitPipelineMode(" << conn << ')');
+        guard.done = PQexitPipelineMode(conn) != 0;
+        if (guard.done)
+            pipelineMode = false;
+    }
+
+    if (errorResult)
+        throw PgSqlError(errorQuery, "PQsendQueryPrepared", errorResult, true);
+
+    if (!guard.done)
+        throw PgConnError("PQexitPipelineMode", conn);
+#endif
+}
+
+bool Connection::pipelineFull() const
+{
+    return pipeline.size() >= maxPipelineEntries;
+}
+
+void Connection::releaseDelayed(Statement* stmt)
+{
+    for (std::vector<PipelineEntry>::size_type n = 0; n < pipeline.size(); ++n)
+        if (pipeline[n].stmt == stmt)
+            pipeline[n].stmt = 0;
+}
+
 }
 }
@@ -48,16 +48,24 @@ Cursor::~Cursor()
 {
     if (!cursorName.empty())
     {
-        std::string sql = "CLOSE " + cursorName;
+        try
+        {
+            std::string sql = "CLOSE " + cursorName;
 
-        log_debug("PQexec(" << getPGConn() << ", \"" << sql << "\")");
-        PGresult* result = PQexec(getPGConn(), sql.c_str());
+            log_debug("PQexec(" << getPGConn() << ", \"" << sql << "\")");
+            PGresult* result = PQexec(getPGConn(), sql.c_str());
+            stmt.getConnection()->countRoundTrip(sql.size());
 
-        if (isError(result))
-          log_error("error closing cursor: " << PQresultErrorMessage(result));
+            if (isError(result))
+              log_error("error closing cursor: " << PQresultErrorMessage(result));
 
-        log_debug("PQclear(" << result << ')');
-        PQclear(result);
+            log_debug("PQclear(" << result << ')');
+            PQclear(result);
+        }
+        catch (const std::exception& e)
+        {
+            log_error("error closing cursor: " << e.what());
+        }
     }
 }
 
@@ -65,21 +73,26 @@ Row Cursor::fetch()
 {
     if (cursorName.empty())
     {
+        stmt.getConnection()->flushDelayed();
+
         // create cursorname
         std::ostringstream s;
         s << "tntdbcur" << this;
 
+        // a binary cursor returns the fetched rows in binary format
         std::string sql = "DECLARE " + s.str()
+          + (stmt.getResultFormat() ? " BINARY" : "")
           + " CURSOR WITH HOLD FOR "
           + stmt.getQuery();
 
         // declare cursor
         log_debug("PQexecParams(" << getPGConn() << ", \"" << sql
-          << "\", " << stmt.getNParams() << ", 0, paramValues, paramLengths, 0, 0)");
+          << "\", " << stmt.getNParams() << ", paramTypes, paramValues, paramLengths, paramFormats, 0)");
         PGresult* result = PQexecParams(getPGConn(), sql.c_str(),
-          stmt.getNParams(), 0,
+          stmt.getNParams(), stmt.getParamTypes(),
           stmt.getParamValues(), stmt.getParamLengths(),
           stmt.getParamFormats(), 0);
+        stmt.getConnection()->countRoundTrip(sql.size() + stmt.getParamBytes());
 
         if (isError(result))
         {
@@ -43,6 +43,13 @@ Result::Result(PGresult* result)
     log_debug("postgresql-result " << _result);
 }
 
+Result::Result(PGresult* result, const std::shared_ptr<const Result>& columnsFrom)
+  : _result(result),
+    _columnsFrom(columnsFrom)
+{
+    log_debug("postgresql-result " << _result);
+}
+
 Result::~Result()
 {
     if (_result)
@@ -52,6 +59,22 @@ Result::~Result()
     }
 }
 
+const ColumnIndex& Result::getColumnIndex() const
+{
+    if (_columnsFrom)
+        return _columnsFrom->getColumnIndex();
+
+    std::call_once(_columnIndexFlag, [this]()
+    {
+        size_type fc = getFieldCount();
+        _columnIndex.reserve(fc);
+        for (size_type n = 0; n < fc; ++n)
+            _columnIndex.add(PQfname(_result, n), n);
+    });
+
+    return _columnIndex;
+}
+
 Row Result::getRow(size_type tup_num) const
 {
     return Row(std::make_shared<ResultRow>(*this, tup_num));
@@ -31,7 +31,11 @@
 #include <tntdb/postgresql/impl/resultvalue.h>
 #include <tntdb/bits/row.h>
 #include <tntdb/bits/value.h>
-#include <tntdb/error.h>
+#include <tntdb/date.h>
+#include <tntdb/time.h>
+#include <tntdb/datetime.h>
+#include <tntdb/decimal.h>
+#include <tntdb/blob.h>
 
 namespace tntdb
 {
@@ -60,16 +64,7 @@ Value ResultRow::getValueByNumber(size_type field_num) const
 
 Value ResultRow::getValueByName(const std::string& field_name) const
 {
-    unsigned fc = _result.getFieldCount();
-    unsigned n;
-    for (n = 0; n < fc; ++n)
-        if (field_name == PQfname(getPGresult(), n))
-            break;
-
-    if (n == fc)
-        throw FieldNotFound(field_name);
-
-    return getValueByNumber(n);
+    return getValueByNumber(getColumnIndex(field_name));
 }
 
 std::string ResultRow::getColumnName(size_type field_num) const
@@ -77,6 +72,116 @@ std::string ResultRow::getColumnName(size_type field_num) const
     return PQfname(getPGresult(), field_num);
 }
 
+ResultRow::size_type ResultRow::getColumnIndex(const std::string& field_name) const
+{
+    return _result.getColumnIndex().get(field_name);
+}
+
+bool ResultRow::isNull(size_type field_num) const
+{
+    return ResultValue(_result, _rownumber, field_num).isNull();
+}
+
+bool ResultRow::getBool(size_type field_num) const
+{
+    return ResultValue(_result, _rownumber, field_num).getBool();
+}
+
+short ResultRow::getShort(size_type field_num) const
+{
+    return ResultValue(_result, _rownumber, field_num).getShort();
+}
+
+int ResultRow::getInt(size_type field_num) const
+{
+    return ResultValue(_result, _rownumber, field_num).getInt();
+}
+
+long ResultRow::getLong(size_type field_num) const
+{
+    return ResultValue(_result, _rownumber, field_num).getLong();
+}
+
+unsigned ResultRow::getUnsigned(size_type field_num) const
+{
+    return ResultValue(_result, _rownumber, field_num).getUnsigned();
+}
+
+unsigned short ResultRow::getUnsignedShort(size_type field_num) const
+{
+    return ResultValue(_result, _rownumber, field_num).getUnsignedShort();
+}
+
+unsigned long ResultRow::getUnsignedLong(size_type field_num) const
+{
+    return ResultValue(_result, _rownumber, field_num).getUnsignedLong();
+}
+
+int32_t ResultRow::getInt32(size_type field_num) const
+{
+    return ResultValue(_result, _rownumber, field_num).getInt32();
+}
+
+uint32_t ResultRow::getUnsigned32(size_type field_num) const
+{
+    return ResultValue(_result, _rownumber, field_num).getUnsigned32();
+}
+
+int64_t ResultRow::getInt64(size_type field_num) const
+{
+    return ResultValue(_result, _rownumber, field_num).getInt64();
+}
+
+uint64_t ResultRow::getUnsigned64(size_type field_num) const
+{
+    return ResultValue(_result, _rownumber, field_num).getUnsigned64();
+}
+
+Decimal ResultRow::getDecimal(size_type field_num) const
+{
+    return ResultValue(_result, _rownumber, field_num).getDecimal();
+}
+
+float ResultRow::getFloat(size_type field_num) const
+{
+    return ResultValue(_result, _rownumber, field_num).getFloat();
+}
+
+double ResultRow::getDouble(size_type field_num) const
+{
+    return ResultValue(_result, _rownumber, field_num).getDouble();
+}
+
+char ResultRow::getChar(size_type field_num) const
+{
+    return ResultValue(_result, _rownumber, field_num).getChar();
+}
+
+void ResultRow::getString(size_type field_num, std::string& ret) const
+{
+    ResultValue(_result, _rownumber, field_num).getString(ret);
+}
+
+void ResultRow::getBlob(size_type field_num, Blob& ret) const
+{
+    ResultValue(_result, _rownumber, field_num).getBlob(ret);
+}
+
+Date ResultRow::getDate(size_type field_num) const
+{
+    return ResultValue(_result, _rownumber, field_num).getDate();
+}
+
+Time ResultRow::getTime(size_type field_num) const
+{
+    return ResultValue(_result, _rownumber, field_num).getTime();
+}
+
+Datetime ResultRow::getDatetime(size_type field_num) const
+{
+    return ResultValue(_result, _rownumber, field_num).getDatetime();
+}
+
 PGresult* ResultRow::getPGresult() const
 {
     return _result.getPGresult();
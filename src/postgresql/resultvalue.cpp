@@ -28,10 +28,15 @@
 
 #include <tntdb/postgresql/impl/resultvalue.h>
 #include <tntdb/postgresql/impl/result.h>
+#include <tntdb/postgresql/binaryformat.h>
+#include <tntdb/impl/textconv.h>
 #include <tntdb/error.h>
+#include <tntdb/date.h>
+#include <tntdb/time.h>
+#include <tntdb/datetime.h>
+#include <tntdb/decimal.h>
 #include <sstream>
 #include <cxxtools/log.h>
-#include <cxxtools/convert.h>
 #include <limits>
 
 log_define("tntdb.postgresql.resultvalue")
@@ -40,6 +45,47 @@ namespace tntdb
 {
 namespace postgresql
 {
+namespace
+{
+    // dates in traditional (mm/dd/yyyy) or german (dd.mm.yyyy) style
+    const char* scanRegionalDate(const char* begin, const char* end, Date& ret)
+    {
+        unsigned short n1, n2, year;
+        const char* p = textconv::scanNumber(begin, end, n1);
+        if (p == 0 || p == end || (*p != '/' && *p != '.'))
+            return 0;
+
+        char sep = *p;
+        p = textconv::scanNumber(p + 1, end, n2);
+        if (p == 0 || p == end || *p != sep)
+            return 0;
+
+        p = textconv::scanNumber(p + 1, end, year);
+        if (p == 0)
+            return 0;
+
+        if (sep == '/')
+            ret.set(year, n1, n2);
+        else
+            ret.set(year, n2, n1);
+
+        return p;
+    }
+
+    template <typename T>
+    T parseText(const char* data, int len, const char* tname)
+    {
+        T ret;
+        if (!textconv::parse(data, data + len, ret))
+        {
+            std::ostringstream msg;
+            msg << "can't convert \"" << std::string(data, len) << "\" to " << tname;
+            throw TypeError(msg.str());
+        }
+        return ret;
+    }
+}
+
 ResultValue::ResultValue(const std::shared_ptr<Result>& resultref, const Result& result, unsigned rownumber, int tup_num)
     : _resultref(resultref),
       _result(result),
@@ -55,6 +101,54 @@ ResultValue::ResultValue(const Result& result, unsigned rownumber, int tup_num)
 {
 }
 
+bool ResultValue::isBinary() const
+{
+    return PQfformat(_result.getPGresult(), _tup_num) == 1;
+}
+
+Oid ResultValue::getType() const
+{
+    return PQftype(_result.getPGresult(), _tup_num);
+}
+
+const char* ResultValue::getData() const
+{
+    if (PQgetisnull(_result.getPGresult(), _rownumber, _tup_num))
+      throw NullValue();
+    return PQgetvalue(_result.getPGresult(), _rownumber, _tup_num);
+}
+
+int ResultValue::getLength() const
+{
+    return PQgetlength(_result.getPGresult(), _rownumber, _tup_num);
+}
+
+template <typename T>
+T ResultValue::getInteger(const char* tname) const
+{
+    int64_t value;
+    if (!isBinary())
+        return parseText<T>(getData(), getLength(), tname);
+
+    if (decodeBinary(getType(), getData(), getLength(), value))
+    {
+        if ((std::numeric_limits<T>::is_signed
+                ? value < static_cast<int64_t>(std::numeric_limits<T>::min())
+                : value < 0)
+          || (value > 0 && static_cast<uint64_t>(value) > static_cast<uint64_t>(std::numeric_limits<T>::max())))
+        {
+            std::ostringstream msg;
+            msg << "value " << value << " out of range";
+            throw TypeError(msg.str());
+        }
+
+        return static_cast<T>(value);
+    }
+
+    std::string str = getString();
+    return parseText<T>(str.data(), str.size(), tname);
+}
+
 bool ResultValue::isNull() const
 {
     return PQgetisnull(_result.getPGresult(), _rownumber, _tup_num) != 0;
@@ -62,6 +156,17 @@ bool ResultValue::isNull() const
 
 bool ResultValue::getBool() const
 {
+    if (isBinary())
+    {
+        bool ret;
+        if (decodeBinary(getType(), getData(), getLength(), ret))
+            return ret;
+        std::string value = getString();
+        return !value.empty() && (value[0] == 't' || value[0] == 'T'
+            || value[0] == 'y' || value[0] == 'Y'
+            || value[0] == '1');
+    }
+
     char* value = PQgetvalue(_result.getPGresult(), _rownumber, _tup_num);
     return value[0] == 't' || value[0] == 'T'
         || value[0] == 'y' || value[0] == 'Y'
@@ -70,71 +175,94 @@ bool ResultValue::getBool() const
 
 short ResultValue::getShort() const
 {
-    return cxxtools::convert<short>(getString());
+    return getInteger<short>("short");
 }
 
 int ResultValue::getInt() const
 {
-    return cxxtools::convert<int>(getString());
+    return getInteger<int>("int");
 }
 
 long ResultValue::getLong() const
 {
-    return cxxtools::convert<long>(getString());
+    return getInteger<long>("long");
 }
 
 unsigned short ResultValue::getUnsignedShort() const
 {
-    return cxxtools::convert<unsigned short>(getString());
+    return getInteger<unsigned short>("unsigned short");
 }
 
 unsigned ResultValue::getUnsigned() const
 {
-    return cxxtools::convert<unsigned>(getString());
+    return getInteger<unsigned>("unsigned");
 }
 
 unsigned long ResultValue::getUnsignedLong() const
 {
-    return cxxtools::convert<unsigned long>(getString());
+    return getInteger<unsigned long>("unsigned long");
 }
 
 int32_t ResultValue::getInt32() const
 {
-    return cxxtools::convert<int32_t>(getString());
+    return getInteger<int32_t>("int32_t");
 }
 
 uint32_t ResultValue::getUnsigned32() const
 {
-    return cxxtools::convert<uint32_t>(getString());
+    return getInteger<uint32_t>("uint32_t");
 }
 
 int64_t ResultValue::getInt64() const
 {
-    return cxxtools::convert<int64_t>(getString());
+    return getInteger<int64_t>("int64_t");
 }
 
 uint64_t ResultValue::getUnsigned64() const
 {
-    return cxxtools::convert<uint64_t>(getString());
+    return getInteger<uint64_t>("uint64_t");
 }
 
 Decimal ResultValue::getDecimal() const
 {
+    int64_t value;
+    if (isBinary() && decodeBinary(getType(), getData(), getLength(), value))
+        return Decimal(static_cast<long long>(value));
+    if (!isBinary())
+        return Decimal(getData(), getData() + getLength());
     return Decimal(getString());
 }
 
 float ResultValue::getFloat() const
 {
-    return cxxtools::convert<float>(getString());
+    double value;
+    if (isBinary() && decodeBinary(getType(), getData(), getLength(), value))
+        return static_cast<float>(value);
+    if (!isBinary())
+        return parseText<float>(getData(), getLength(), "float");
+    std::string str = getString();
+    return parseText<float>(str.data(), str.size(), "float");
 }
 
 double ResultValue::getDouble() const
 {
-    return cxxtools::convert<double>(getString());
+    double value;
+    if (isBinary() && decodeBinary(getType(), getData(), getLength(), value))
+        return value;
+    if (!isBinary())
+        return parseText<double>(getData(), getLength(), "double");
+    std::string str = getString();
+    return parseText<double>(str.data(), str.size(), "double");
 }
 
 char ResultValue::getChar() const
 {
+    if (isBinary())
+    {
+        std::string value = getString();
+        return value.empty() ? '\0' : value[0];
+    }
+
     char* value = PQgetvalue(_result.getPGresult(), _rownumber, _tup_num);
     return *value;
 }
@@ -145,11 +273,21 @@ void ResultValue::getString(std::string& ret) const
       throw NullValue();
     char* value = PQgetvalue(_result.getPGresult(), _rownumber, _tup_num);
     int len = PQgetlength(_result.getPGresult(), _rownumber, _tup_num);
-    ret.assign(value, len);
+    if (isBinary())
+        binaryToString(getType(), value, len, ret);
+    else
+        ret.assign(value, len);
 }
 
 void ResultValue::getBlob(Blob& ret) const
 {
+    if (isBinary())
+    {
+        // bytea values are not escaped in binary format
+        ret.assign(getData(), getLength());
+        return;
+    }
+
     char* value = PQgetvalue(_result.getPGresult(), _rownumber, _tup_num);
     int len = PQgetlength(_result.getPGresult(), _rownumber, _tup_num);
     log_debug("PQgetlength returns " << len);
@@ -159,109 +297,97 @@ void ResultValue::getBlob(Blob& ret) const
     PQfreemem(data);
 }
 
+bool ResultValue::getStringView(const char*& data, std::size_t& length) const
+{
+    // binary values are converted by getString
+    if (isBinary())
+        return false;
+
+    if (PQgetisnull(_result.getPGresult(), _rownumber, _tup_num))
+      throw NullValue();
+    data = PQgetvalue(_result.getPGresult(), _rownumber, _tup_num);
+    length = PQgetlength(_result.getPGresult(), _rownumber, _tup_num);
+    return true;
+}
+
+bool ResultValue::getBlobView(const char*& data, std::size_t& length) const
+{
+    // escaped bytea values are unescaped by getBlob
+    if (!isBinary())
+        return false;
+
+    data = getData();
+    length = getLength();
+    return true;
+}
+
 Date ResultValue::getDate() const
 {
-    std::string value = PQgetvalue(_result.getPGresult(), _rownumber, _tup_num);
-    if (value.find('-') != std::string::npos)
-    {
-        // ISO 8601/SQL standard
-        char ch;
-        unsigned short year, month, day;
-        std::istringstream in(value);
-        in >> year >> ch >> month >> ch >> day;
-        if (in)
-          return Date(year, month, day);
-    }
-    else if (value.find('/') != std::string::npos)
+    if (isBinary())
     {
-        // tradition style
-        char ch;
-        unsigned short year, month, day;
-        std::istringstream in(value);
-        in >> month >> ch >> day >> ch >> year;
-        if (in)
-          return Date(year, month, day);
-    }
-    else if (value.find('.') != std::string::npos)
-    {
-        // german/regional style
-        char ch;
-        unsigned short year, month, day;
-        std::istringstream in(value);
-        in >> day >> ch >> month >> ch >> year;
-        if (in)
-          return Date(year, month, day);
+        Date ret;
+        if (decodeBinary(getType(), getData(), getLength(), ret))
+            return ret;
     }
 
+    const char* data = getData();
+    const char* end = data + getLength();
+    Date ret;
+    if (textconv::scanIsoDate(data, end, ret) || scanRegionalDate(data, end, ret))
+        return ret;
+
     std::ostringstream msg;
-    msg << "can't convert \"" << value << "\" to Date";
+    msg << "can't convert \"" << data << "\" to Date";
     throw TypeError(msg.str());
 }
 
 Time ResultValue::getTime() const
 {
-    std::string value = PQgetvalue(_result.getPGresult(), _rownumber, _tup_num);
-    char ch;
-    unsigned short hour, min, sec, msec;
-    float fsec;
-    std::istringstream in(value);
-    in >> hour >> ch >> min >> ch >> fsec;
-    if (in)
+    if (isBinary())
     {
-        fsec += .0005;
-        sec = static_cast<unsigned short>(fsec);
-        msec = static_cast<unsigned short>((fsec - sec) * 1000);
-        return Time(hour, min, sec, msec);
+        Time ret;
+        if (decodeBinary(getType(), getData(), getLength(), ret))
+            return ret;
     }
 
+    // the time may be followed by a time zone
+    const char* data = getData();
+    Time ret;
+    if (textconv::scanIsoTime(data, data + getLength(), ret))
+        return ret;
+
     std::ostringstream msg;
-    msg << "can't convert \"" << value << "\" to Time";
+    msg << "can't convert \"" << data << "\" to Time";
     throw TypeError(msg.str());
 }
 
 Datetime ResultValue::getDatetime() const
 {
-    std::string value = PQgetvalue(_result.getPGresult(), _rownumber, _tup_num);
-    log_debug("datetime value=" << value);
-    if (value.find('-') != std::string::npos)
+    if (isBinary())
     {
-        // ISO 8601/SQL standard
-        char ch;
-        unsigned short year, month, day, hour, min, sec, msec;
-        float fsec;
-        std::istringstream in(value);
-        in >> year >> ch >> month >> ch >> day >> hour >> ch >> min >> ch >> fsec;
-        if (in)
-        {
-            fsec += .0005;
-            sec = static_cast<unsigned short>(fsec);
-            msec = static_cast<unsigned short>((fsec - sec) * 1000);
-            return Datetime(year, month, day, hour, min, sec, msec);
-        }
-    }
-    else if (value.find('/') != std::string::npos)
-    {
-        // traditional style
-        char ch;
-        unsigned short year, month, day, hour, min, sec;
-        std::istringstream in(value);
-        in >> month >> ch >> day >> ch >> year >> hour >> ch >> min >> ch >> sec;
-        if (in)
-          return Datetime(year, month, day, hour, min, sec);
-    }
-    else if (value.find('.') != std::string::npos)
-    {
-        // german/regional style
-        char ch;
-        unsigned short year, month, day, hour, min, sec;
-        std::istringstream in(value);
-        in >> day >> ch >> month >> ch >> year >> hour >> ch >> min >> ch >> sec;
-        if (in)
-          return Datetime(year, month, day, hour, min, sec);
+        Datetime ret;
+        if (decodeBinary(getType(), getData(), getLength(), ret))
+            return ret;
     }
 
+    const char* data = getData();
+    const char* end = data + getLength();
+    log_debug("datetime value=" << data);
+
+    // ISO 8601/SQL standard, optionally followed by a time zone
+    Datetime ret;
+    if (textconv::scanIsoDatetime(data, end, ret))
+        return ret;
+
+    // traditional or german style
+    Date date;
+    Time time;
+    const char* p = scanRegionalDate(data, end, date);
+    if (p && p != end && *p == ' ' && textconv::scanIsoTime(p + 1, end, time))
+        return Datetime(date, time);
+
     std::ostringstream msg;
-    msg << "can't convert \"" << value << "\" to Datetime";
+    msg << "can't convert \"" << data << "\" to Datetime";
     throw TypeError(msg.str());
 }
 
@@ -32,15 +32,20 @@
 #include <tntdb/postgresql/impl/resultrow.h>
 #include <tntdb/postgresql/impl/resultvalue.h>
 #include <tntdb/postgresql/impl/cursor.h>
+#include <tntdb/postgresql/impl/streamcursor.h>
 #include <tntdb/postgresql/error.h>
+#include <tntdb/postgresql/binaryformat.h>
+#include <tntdb/impl/textconv.h>
 #include <tntdb/bits/result.h>
 #include <tntdb/bits/row.h>
 #include <tntdb/bits/value.h>
+#include <tntdb/date.h>
+#include <tntdb/time.h>
+#include <tntdb/datetime.h>
 #include <tntdb/stmtparser.h>
 #include <sstream>
 #include <limits>
 #include <cxxtools/log.h>
-#include <cxxtools/convert.h>
 #include "config.h"
 
 log_define("tntdb.postgresql.statement")
@@ -92,10 +97,63 @@ namespace
         r << '$' << (n + 1);
         return r.str();
     }
+
+    // text representation of parameters, which are not passed in binary format
+    template <typename T>
+    std::string toText(T data)
+    {
+        return textconv::toString(data);
+    }
+
+    std::string toText(const char* data)       { return data; }
+    std::string toText(const Decimal& data)    { return data.toString(); }
+    std::string toText(bool data)              { return data ? "1" : "0"; }
+    std::string toText(const Date& data)       { return data.getIso(); }
+    std::string toText(const Time& data)       { return data.getIso(); }
+    std::string toText(const Datetime& data)   { return data.getIso(); }
+
+    // types, with which values are passed to the server with binaryParams;
+    // strings and blobs are passed without a type, so that the server infers
+    // it
+    template <typename T>
+    Oid paramType(const T&)                     { return 0; }
+
+    Oid paramType(bool)                         { return pgBoolOid; }
+    Oid paramType(short)                        { return pgInt2Oid; }
+    Oid paramType(unsigned short)               { return pgInt4Oid; }
+    Oid paramType(int)                          { return pgInt4Oid; }
+    Oid paramType(unsigned)                     { return pgInt8Oid; }
+    Oid paramType(long)                         { return sizeof(long) > 4 ? pgInt8Oid : pgInt4Oid; }
+    Oid paramType(long long)                    { return pgInt8Oid; }
+    Oid paramType(float)                        { return pgFloat4Oid; }
+    Oid paramType(double)                       { return pgFloat8Oid; }
+    Oid paramType(const Decimal&)               { return pgNumericOid; }
+    Oid paramType(const Date&)                  { return pgDateOid; }
+    Oid paramType(const Time&)                  { return pgTimeOid; }
+    Oid paramType(const Datetime&)              { return pgTimestampOid; }
+
+    Oid paramType(unsigned long long data)
+    {
+        return data > static_cast<unsigned long long>(std::numeric_limits<int64_t>::max())
+             ? pgNumericOid : pgInt8Oid;
+    }
+
+    Oid paramType(unsigned long data)
+    {
+        return paramType(static_cast<unsigned long long>(data));
+    }
 }
 
 Statement::Statement(Connection* conn_, const std::string& query_)
-  : conn(conn_)
+  : conn(conn_),
+    maxDelay(0),
+    delayed(0),
+    delayedAffected(0),
+    resultFormat(0),
+    typedParams(false),
+    streaming(false),
+    sharedStmt(false),
+    executed(false)
 {
     // parse hostvars
     StmtParser parser;
@@ -109,12 +167,55 @@ Statement::Statement(Connection* conn_, const std::string& query_)
     paramValues.resize(se.getMaxIdx());
     paramLengths.resize(se.getMaxIdx());
     paramFormats.resize(se.getMaxIdx());
+    bindTypes.resize(se.getMaxIdx());
 }
 
 Statement::~Statement()
 {
-    if (!stmtName.empty())
+    try
+    {
+        if (delayed > 0)
+            conn->releaseDelayed(this);
+
+        releaseStmt();
+    }
+    catch (const std::exception& e)
+    {
+        log_error("error releasing statement " << stmtName << ": " << e.what());
+    }
+}
+
+bool Statement::acquirePrepared()
+{
+    sharedStmt = conn->acquirePrepared(query, bindTypes, stmtName);
+    if (sharedStmt)
+        paramTypes = bindTypes;
+    return sharedStmt;
+}
+
+void Statement::releaseStmt()
+{
+    if (sharedStmt)
+        conn->releasePrepared(query);
+    else if (!stmtName.empty())
         conn->deallocateStatement(stmtName);
+
+    stmtName.clear();
+    paramTypes.clear();
+    sharedStmt = false;
+}
+
+void Statement::checkParamTypes()
+{
+#ifdef HAVE_PQPREPARE
+    // A statement is prepared with the types of the bound values. When
+    // other types are bound later, it is prepared again with them.
+    if (!stmtName.empty() && paramTypes != bindTypes)
+    {
+        log_debug("parameter types of statement " << stmtName << " changed");
+        releaseStmt();
+    }
+#endif
 }
 
 void Statement::doPrepare()
@@ -126,9 +227,10 @@ void Statement::doPrepare()
     // prepare statement
 #ifdef HAVE_PQPREPARE
     log_debug("PQprepare(" << getPGConn() << ", \"" << s.str()
-      << "\", \"" << query << "\", 0, 0)");
+      << "\", \"" << query << "\", " << values.size() << ", paramTypes)");
     PGresult* result = PQprepare(getPGConn(),
-        s.str().c_str(), query.c_str(), 0, 0);
+        s.str().c_str(), query.c_str(), getNParams(), getParamTypes());
+    conn->countRoundTrip(query.size());
 
     if (isError(result))
     {
@@ -146,6 +248,7 @@ void Statement::doPrepare()
 
     log_debug("PQexec(" << getPGConn() << ", \"" << sql.str() << "\")");
     PGresult* result = PQexec(getPGConn(), sql.str().c_str());
+    conn->countRoundTrip(sql.str().size());
 
     if (isError(result))
     {
@@ -158,17 +261,152 @@ void Statement::doPrepare()
 
     log_debug("PQclear(" << result << ')');
     PQclear(result);
+
+#ifdef HAVE_PQPREPARE
+    // the statement is prepared with the types of the bound values
+    paramTypes = bindTypes;
+    sharedStmt = conn->registerPrepared(query, stmtName, paramTypes);
+#endif
+}
+
+const std::string& Statement::getPreparedName()
+{
+    conn->flushDelayed();
+    checkParamTypes();
+
+    if (stmtName.empty() && !acquirePrepared())
+        doPrepare();
+
+    return stmtName;
+}
+
+PGresult* Statement::execUnnamed()
+{
+    log_debug("PQexecParams(" << getPGConn() << ", \"" << query
+      << "\", " << values.size() << ", paramTypes, paramValues, paramLengths, paramFormats, " << resultFormat << ')');
+    PGresult* result = PQexecParams(getPGConn(), query.c_str(),
+        getNParams(), getParamTypes(), getParamValues(), getParamLengths(), getParamFormats(), resultFormat);
+    conn->countRoundTrip(query.size() + getParamBytes());
+
+    if (isError(result))
+    {
+        log_error(PQresultErrorMessage(result));
+        throw PgSqlError(query, "PQexecParams", result, true);
+    }
+
+    return result;
+}
+
+#ifdef LIBPQ_HAS_PIPELINING
+PGresult* Statement::prepareAndExec()
+{
+    // prepare and execute the statement in one round trip
+    std::ostringstream s;
+    s << "tntdbstmt" << conn->getNextStmtNumber();
+    std::string name = s.str();
+    PGconn* pgconn = getPGConn();
+
+    log_debug("PQenterPipelineMode(" << pgconn << ')');
+    if (PQenterPipelineMode(pgconn) == 0)
+        throw PgConnError("PQenterPipelineMode", pgconn);
+
+    log_debug("PQsendPrepare(" << pgconn << ", \"" << name << "\", \"" << query << "\", " << values.size() << ", paramTypes)");
+    log_debug("PQsendQueryPrepared(" << pgconn << ", \"" << name
+      << "\", " << values.size() << ", paramValues, paramLengths, paramFormats, " << resultFormat << ')');
+    log_debug("PQpipelineSync(" << pgconn << ')');
+    if (PQsendPrepare(pgconn, name.c_str(), query.c_str(), getNParams(), getParamTypes()) == 0
+      || PQsendQueryPrepared(pgconn, name.c_str(), getNParams(), getParamValues(),
+             getParamLengths(), getParamFormats(), resultFormat) == 0
+      || PQpipelineSync(pgconn) == 0)
+    {
+        PgSqlError e(query, "PQsendQueryPrepared", pgconn);
+        PQexitPipelineMode(pgconn);
+        throw e;
+    }
+
+    conn->countRoundTrip(query.size() + getParamBytes());
+
+    // each command returns one result followed by a null result
+    PGresult* results[2];
+    for (unsigned n = 0; n < 2; ++n)
+    {
+        log_debug("PQgetResult(" << pgconn << ')');
+        results[n] = PQgetResult(pgconn);
+        if (results[n])
+        {
+            PGresult* r;
+            while ((r = PQgetResult(pgconn)) != 0)
+                PQclear(r);
+        }
+    }
+
+    // result of the sync
+    PGresult* sync = PQgetResult(pgconn);
+    if (sync)
+        PQclear(sync);
+
+    log_debug("PQexitPipelineMode(" << pgconn << ')');
+    PQexitPipelineMode(pgconn);
+
+    if (results[0] == 0 || isError(results[0]))
+    {
+        if (results[1])
+            PQclear(results[1]);
+        if (results[0] == 0)
+            throw PgSqlError(query, "PQsendPrepare", pgconn);
+        log_error(PQresultErrorMessage(results[0]));
+        throw PgSqlError(query, "PQsendPrepare", results[0], true);
+    }
+
+    PQclear(results[0]);
+    stmtName = name;
+    paramTypes = bindTypes;
+    sharedStmt = conn->registerPrepared(query, stmtName, paramTypes);
+
+    if (results[1] == 0)
+        throw PgSqlError(query, "PQsendQueryPrepared", pgconn);
+
+    if (isError(results[1]))
+    {
+        log_error(PQresultErrorMessage(results[1]));
+        throw PgSqlError(query, "PQsendQueryPrepared", results[1], true);
+    }
+
+    return results[1];
 }
+#endif
 
 PGresult* Statement::execPrepared()
 {
-    if (stmtName.empty())
+    conn->flushDelayed();
+    checkParamTypes();
+
+    if (stmtName.empty() && !acquirePrepared())
+    {
+#ifdef HAVE_PQPREPARE
+        // Many statements are executed just once. They are not prepared
+        // but executed using the unnamed statement.
+        if (!executed)
+        {
+            executed = true;
+            return execUnnamed();
+        }
+#endif
+
+#ifdef LIBPQ_HAS_PIPELINING
+        return prepareAndExec();
+#else
         doPrepare();
+#endif
+    }
+
+    executed = true;
 
     log_debug("PQexecPrepared(" << getPGConn() << ", \"" << stmtName
-      << "\", " << values.size() << ", paramValues, paramLengths, paramFormats, 0)");
+      << "\", " << values.size() << ", paramValues, paramLengths, paramFormats, " << resultFormat << ')');
     PGresult* result = PQexecPrepared(getPGConn(), stmtName.c_str(),
-        getNParams(), getParamValues(), getParamLengths(), getParamFormats(), 0);
+        getNParams(), getParamValues(), getParamLengths(), getParamFormats(), resultFormat);
+    conn->countRoundTrip(stmtName.size() + getParamBytes());
 
     if (isError(result))
     {
@@ -179,91 +417,140 @@ PGresult* Statement::execPrepared()
     return result;
 }
 
-template <typename T>
-void Statement::setValue(const std::string& col, T data)
+void Statement::sendPrepared()
 {
-    hostvarMapType::const_iterator it = hostvarMap.find(col);
-    if (it == hostvarMap.end())
-        log_warn("hostvariable :" << col << " not found");
-    else
+#ifdef LIBPQ_HAS_PIPELINING
+    if (conn->pipelineFull())
+        conn->flushDelayed();
+
+    checkParamTypes();
+
+    if (stmtName.empty() && !acquirePrepared())
     {
-        std::string v = cxxtools::convert<std::string>(data);
-        values[it->second].setValue(v);
-        paramFormats[it->second] = 0;
+        if (conn->inPipelineMode())
+        {
+            // we can't wait for the result of PQprepare, so we add it
+            // to the pipeline
+            std::ostringstream s;
+            s << "tntdbstmt" << conn->getNextStmtNumber();
+
+            log_debug("PQsendPrepare(" << getPGConn() << ", \"" << s.str()
+              << "\", \"" << query << "\", " << values.size() << ", paramTypes)");
+            if (PQsendPrepare(getPGConn(), s.str().c_str(), query.c_str(), getNParams(), getParamTypes()) == 0)
+                throw PgSqlError(query, "PQsendPrepare", getPGConn());
+            conn->countSent(query.size());
+
+            stmtName = s.str();
+            paramTypes = bindTypes;
+            sharedStmt = conn->registerPrepared(query, stmtName, paramTypes);
+            conn->addPipelineEntry(this, true);
+        }
+        else
+            doPrepare();
     }
+
+    conn->enterPipelineMode();
+
+    log_debug("PQsendQueryPrepared(" << getPGConn() << ", \"" << stmtName
+      << "\", " << values.size() << ", paramValues, paramLengths, paramFormats, 0)");
+    if (PQsendQueryPrepared(getPGConn(), stmtName.c_str(),
+        getNParams(), getParamValues(), getParamLengths(), getParamFormats(), 0) == 0)
+        throw PgSqlError(query, "PQsendQueryPrepared", getPGConn());
+    conn->countSent(stmtName.size() + getParamBytes());
+
+    conn->addPipelineEntry(this, false);
+#endif
 }
 
-template <>
-void Statement::setValue(const std::string& col, float data)
+HostvarHandle Statement::hostvar(const std::string& col)
 {
-    hostvarMapType::const_iterator it = hostvarMap.find(col);
-    if (it == hostvarMap.end())
-        log_warn("hostvariable :" << col << " not found");
-    else
-    {
-        std::ostringstream v;
-        v.precision(24);
-        v << data;
-        values[it->second].setValue(v.str());
-        paramFormats[it->second] = 0;
-    }
+    return HostvarHandle(col, hostvarIndex(col));
 }
 
-template <>
-void Statement::setValue(const std::string& col, double data)
+unsigned Statement::hostvarIndex(const std::string& col) const
 {
     hostvarMapType::const_iterator it = hostvarMap.find(col);
     if (it == hostvarMap.end())
-        log_warn("hostvariable :" << col << " not found");
-    else
     {
-        std::ostringstream v;
-        v.precision(24);
-        v << data;
-        values[it->second].setValue(v.str());
-        paramFormats[it->second] = 0;
+        log_warn("hostvariable :" << col << " not found");
+        return HostvarHandle::invalidIndex;
     }
+
+    return it->second;
 }
 
-template <>
-void Statement::setValue(const std::string& col, Decimal data)
+template <typename T>
+void Statement::setValue(unsigned n, T data)
 {
-    hostvarMapType::const_iterator it = hostvarMap.find(col);
-    if (it == hostvarMap.end())
-        log_warn("hostvariable :" << col << " not found");
-    else
+    if (n != HostvarHandle::invalidIndex)
     {
-        std::ostringstream v;
-        v.precision(24);
-        v << data;
-        values[it->second].setValue(v.str());
-        paramFormats[it->second] = 0;
+        // Values are passed as text without a type, so that the server
+        // infers the type from the query. With binaryParams they are passed
+        // in binary format with the type of their C++ type. Values, which
+        // can't be represented in binary, are passed as text of that type.
+        Oid type = typedParams ? paramType(data) : 0;
+
+        // time values are passed as 64 bit integers only with integer
+        // datetimes
+        bool binary = typedParams
+                   && ((type != pgTimeOid && type != pgTimestampOid)
+                       || conn->integerDatetimes());
+
+        if (binary && encodeBinary(type, data, binaryValue))
+        {
+            values[n].setValue(binaryValue);
+            paramFormats[n] = 1;
+            bindTypes[n] = type;
+        }
+        else
+            setTextValue(n, toText(data), type);
     }
 }
 
+void Statement::setTextValue(unsigned n, const std::string& data, Oid type)
+{
+    values[n].setValue(data);
+    paramFormats[n] = 0;
+    bindTypes[n] = type;
+}
+
 template <typename T>
-void Statement::setStringValue(const std::string& col, T data, bool binary)
+void Statement::setFloatValue(unsigned n, T data)
 {
-    hostvarMapType::const_iterator it = hostvarMap.find(col);
-    if (it == hostvarMap.end())
-        log_warn("hostvariable :" << col << " not found");
+    if (n == HostvarHandle::invalidIndex)
+        return;
+
+    Oid type = typedParams ? paramType(data) : 0;
+
+    if (data != data)
+        setTextValue(n, "NaN", type);
+    else if (data == std::numeric_limits<T>::infinity())
+        setTextValue(n, "Infinity", type);
+    else if (data == -std::numeric_limits<T>::infinity())
+        setTextValue(n, "-Infinity", type);
     else
+        setValue(n, data);
+}
+
+template <typename T>
+void Statement::setStringValue(unsigned n, T data, bool binary)
+{
+    if (n != HostvarHandle::invalidIndex)
     {
-        values[it->second].setValue(data);
-        paramFormats[it->second] = binary;
+        values[n].setValue(data);
+        paramFormats[n] = binary;
+        bindTypes[n] = 0;
     }
 }
 
-template <typename T>
-void Statement::setIsoValue(const std::string& col, T data)
+void Statement::setNullValue(unsigned n)
 {
-    hostvarMapType::const_iterator it = hostvarMap.find(col);
-    if (it == hostvarMap.end())
-        log_warn("hostvariable :" << col << " not found");
-    else
+    if (n != HostvarHandle::invalidIndex)
     {
-        values[it->second].setValue(data.getIso());
-        paramFormats[it->second] = 0;
+        // null values keep the type, so that the statement needs not to be
+        // prepared again
+        values[n].setNull();
+        paramFormats[n] = 0;
     }
 }
 
@@ -279,191 +566,317 @@ void Statement::setType(const std::string& col, const std::string& type)
 void Statement::clear()
 {
     log_debug("clear()");
-    for (valuesType::iterator it = values.begin(); it != values.end(); ++it)
-        it->setNull();
+    for (unsigned n = 0; n < values.size(); ++n)
+        setNullValue(n);
 }
 
 void Statement::setNull(const std::string& col)
 {
     log_debug("setNull(\"" << col << "\")");
+    setNullValue(hostvarIndex(col));
+}
 
-    hostvarMapType::const_iterator it = hostvarMap.find(col);
-    if (it == hostvarMap.end())
-        log_warn("hostvariable :" << col << " not found");
-    else
-    {
-        values[it->second].setNull();
-        paramFormats[it->second] = 0;
-    }
+void Statement::setNull(const HostvarHandle& hostvar)
+{
+    log_debug("setNull(:" << hostvar.getName() << ')');
+    setNullValue(hostvar.getIndex());
 }
 
 void Statement::setBool(const std::string& col, bool data)
 {
     log_debug("setBool(\"" << col << "\", " << data << ')');
-
-    hostvarMapType::const_iterator it = hostvarMap.find(col);
-    if (it == hostvarMap.end())
-        log_warn("hostvariable :" << col << " not found");
-    else
-    {
-        values[it->second].setValue(data ? "1" : "0");
-        paramFormats[it->second] = 0;
-    }
-
+    setValue(hostvarIndex(col), data);
     SET_TYPE(col, "bool");
 }
 
+void Statement::setBool(const HostvarHandle& hostvar, bool data)
+{
+    log_debug("setBool(:" << hostvar.getName() << ", " << data << ')');
+    setValue(hostvar.getIndex(), data);
+    SET_TYPE(hostvar.getName(), "bool");
+}
+
 void Statement::setShort(const std::string& col, short data)
 {
     log_debug("setShort(\"" << col << "\", " << data << ')');
-    setValue(col, data);
+    setValue(hostvarIndex(col), data);
     SET_TYPE(col, "short");
 }
 
+void Statement::setShort(const HostvarHandle& hostvar, short data)
+{
+    log_debug("setShort(:" << hostvar.getName() << ", " << data << ')');
+    setValue(hostvar.getIndex(), data);
+    SET_TYPE(hostvar.getName(), "short");
+}
+
 void Statement::setInt(const std::string& col, int data)
 {
     log_debug("setInt(\"" << col << "\", " << data << ')');
-    setValue(col, data);
+    setValue(hostvarIndex(col), data);
     SET_TYPE(col, "int");
 }
 
+void Statement::setInt(const HostvarHandle& hostvar, int data)
+{
+    log_debug("setInt(:" << hostvar.getName() << ", " << data << ')');
+    setValue(hostvar.getIndex(), data);
+    SET_TYPE(hostvar.getName(), "int");
+}
+
 void Statement::setLong(const std::string& col, long data)
 {
     log_debug("setLong(\"" << col << "\", " << data << ')');
-    setValue(col, data);
+    setValue(hostvarIndex(col), data);
     SET_TYPE(col, "long");
 }
 
+void Statement::setLong(const HostvarHandle& hostvar, long data)
+{
+    log_debug("setLong(:" << hostvar.getName() << ", " << data << ')');
+    setValue(hostvar.getIndex(), data);
+    SET_TYPE(hostvar.getName(), "long");
+}
+
 void Statement::setUnsignedShort(const std::string& col, unsigned short data)
 {
     log_debug("setUnsignedShort(\"" << col << "\", " << data << ')');
-    setValue(col, data);
+    setValue(hostvarIndex(col), data);
     SET_TYPE(col, "unsigned short");
 }
 
+void Statement::setUnsignedShort(const HostvarHandle& hostvar, unsigned short data)
+{
+    log_debug("setUnsignedShort(:" << hostvar.getName() << ", " << data << ')');
+    setValue(hostvar.getIndex(), data);
+    SET_TYPE(hostvar.getName(), "unsigned short");
+}
+
 void Statement::setUnsigned(const std::string& col, unsigned data)
 {
     log_debug("setUnsigned(\"" << col << "\", " << data << ')');
-    setValue(col, data);
+    setValue(hostvarIndex(col), data);
     SET_TYPE(col, "unsigned");
 }
 
+void Statement::setUnsigned(const HostvarHandle& hostvar, unsigned data)
+{
+    log_debug("setUnsigned(:" << hostvar.getName() << ", " << data << ')');
+    setValue(hostvar.getIndex(), data);
+    SET_TYPE(hostvar.getName(), "unsigned");
+}
+
 void Statement::setUnsignedLong(const std::string& col, unsigned long data)
 {
     log_debug("setUnsignedLong(\"" << col << "\", " << data << ')');
-    setValue(col, data);
+    setValue(hostvarIndex(col), data);
     SET_TYPE(col, "unsigned long");
 }
 
+void Statement::setUnsignedLong(const HostvarHandle& hostvar, unsigned long data)
+{
+    log_debug("setUnsignedLong(:" << hostvar.getName() << ", " << data << ')');
+    setValue(hostvar.getIndex(), data);
+    SET_TYPE(hostvar.getName(), "unsigned long");
+}
+
 void Statement::setInt32(const std::string& col, int32_t data)
 {
     log_debug("setInt32(\"" << col << "\", " << data << ')');
-    setValue(col, data);
+    setValue(hostvarIndex(col), data);
     SET_TYPE(col, "int");
 }
 
+void Statement::setInt32(const HostvarHandle& hostvar, int32_t data)
+{
+    log_debug("setInt32(:" << hostvar.getName() << ", " << data << ')');
+    setValue(hostvar.getIndex(), data);
+    SET_TYPE(hostvar.getName(), "int");
+}
+
 void Statement::setUnsigned32(const std::string& col, uint32_t data)
 {
     log_debug("setUnsigned32(\"" << col << "\", " << data << ')');
-    setValue(col, data);
+    setValue(hostvarIndex(col), data);
     SET_TYPE(col, "int");
 }
 
+void Statement::setUnsigned32(const HostvarHandle& hostvar, uint32_t data)
+{
+    log_debug("setUnsigned32(:" << hostvar.getName() << ", " << data << ')');
+    setValue(hostvar.getIndex(), data);
+    SET_TYPE(hostvar.getName(), "int");
+}
+
 void Statement::setInt64(const std::string& col, int64_t data)
 {
     log_debug("setInt64(\"" << col << "\", " << data << ')');
-    setValue(col, data);
+    setValue(hostvarIndex(col), data);
     SET_TYPE(col, "bigint");
 }
 
+void Statement::setInt64(const HostvarHandle& hostvar, int64_t data)
+{
+    log_debug("setInt64(:" << hostvar.getName() << ", " << data << ')');
+    setValue(hostvar.getIndex(), data);
+    SET_TYPE(hostvar.getName(), "bigint");
+}
+
 void Statement::setUnsigned64(const std::string& col, uint64_t data)
 {
     log_debug("setUnsigned64(\"" << col << "\", " << data << ')');
-    setValue(col, data);
+    setValue(hostvarIndex(col), data);
     SET_TYPE(col, "bigint");
 }
 
+void Statement::setUnsigned64(const HostvarHandle& hostvar, uint64_t data)
+{
+    log_debug("setUnsigned64(:" << hostvar.getName() << ", " << data << ')');
+    setValue(hostvar.getIndex(), data);
+    SET_TYPE(hostvar.getName(), "bigint");
+}
+
 void Statement::setDecimal(const std::string& col, const Decimal& data)
 {
     log_debug("setDecimal(\"" << col << "\", " << data << ')');
-    setValue(col, data);
+    setValue(hostvarIndex(col), data);
     SET_TYPE(col, "numeric");
 }
 
+void Statement::setDecimal(const HostvarHandle& hostvar, const Decimal& data)
+{
+    log_debug("setDecimal(:" << hostvar.getName() << ", " << data << ')');
+    setValue(hostvar.getIndex(), data);
+    SET_TYPE(hostvar.getName(), "numeric");
+}
+
 void Statement::setFloat(const std::string& col, float data)
 {
     log_debug("setFloat(\"" << col << "\", " << data << ')');
-    if (data != data)
-        setValue(col, "NaN");
-    else if (data == std::numeric_limits<float>::infinity())
-        setValue(col, "Infinity");
-    else if (data == -std::numeric_limits<float>::infinity())
-        setValue(col, "-Infinity");
-    else
-        setValue(col, data);
+    setFloatValue(hostvarIndex(col), data);
     SET_TYPE(col, "numeric");
 }
 
+void Statement::setFloat(const HostvarHandle& hostvar, float data)
+{
+    log_debug("setFloat(:" << hostvar.getName() << ", " << data << ')');
+    setFloatValue(hostvar.getIndex(), data);
+    SET_TYPE(hostvar.getName(), "numeric");
+}
+
 void Statement::setDouble(const std::string& col, double data)
 {
     log_debug("setDouble(\"" << col << "\", " << data << ')');
-    if (data != data)
-        setValue(col, "NaN");
-    else if (data == std::numeric_limits<double>::infinity())
-        setValue(col, "Infinity");
-    else if (data == -std::numeric_limits<double>::infinity())
-        setValue(col, "-Infinity");
-    else
-        setValue(col, data);
+    setFloatValue(hostvarIndex(col), data);
     SET_TYPE(col, "numeric");
 }
 
+void Statement::setDouble(const HostvarHandle& hostvar, double data)
+{
+    log_debug("setDouble(:" << hostvar.getName() << ", " << data << ')');
+    setFloatValue(hostvar.getIndex(), data);
+    SET_TYPE(hostvar.getName(), "numeric");
+}
+
 void Statement::setChar(const std::string& col, char data)
 {
     log_debug("setChar(\"" << col << "\", '" << data << "')");
-    setStringValue(col, std::string(1, data));
+    setStringValue(hostvarIndex(col), std::string(1, data));
     SET_TYPE(col, "text");
 }
 
+void Statement::setChar(const HostvarHandle& hostvar, char data)
+{
+    log_debug("setChar(:" << hostvar.getName() << ", '" << data << "')");
+    setStringValue(hostvar.getIndex(), std::string(1, data));
+    SET_TYPE(hostvar.getName(), "text");
+}
+
 void Statement::setString(const std::string& col, const std::string& data)
 {
     log_debug("setString(\"" << col << "\", \"" << data << "\")");
-    setStringValue(col, data);
+    setStringValue(hostvarIndex(col), data);
     SET_TYPE(col, "text");
 }
 
+void Statement::setString(const HostvarHandle& hostvar, const std::string& data)
+{
+    log_debug("setString(:" << hostvar.getName() << ", \"" << data << "\")");
+    setStringValue(hostvar.getIndex(), data);
+    SET_TYPE(hostvar.getName(), "text");
+}
+
 void Statement::setBlob(const std::string& col, const Blob& data)
 {
     log_debug("setBlob(\"" << col << "\", Blob)");
-    setStringValue(col, std::string(data.data(), data.size()), true);
+    setStringValue(hostvarIndex(col), std::string(data.data(), data.size()), true);
     SET_TYPE(col, "blob");
 }
 
+void Statement::setBlob(const HostvarHandle& hostvar, const Blob& data)
+{
+    log_debug("setBlob(:" << hostvar.getName() << ", Blob)");
+    setStringValue(hostvar.getIndex(), std::string(data.data(), data.size()), true);
+    SET_TYPE(hostvar.getName(), "blob");
+}
+
 void Statement::setDate(const std::string& col, const Date& data)
 {
     log_debug("setDate(\"" << col << "\", " << data.getIso() << ')');
-    setIsoValue(col, data);
+    setValue(hostvarIndex(col), data);
     SET_TYPE(col, "date");
 }
 
+void Statement::setDate(const HostvarHandle& hostvar, const Date& data)
+{
+    log_debug("setDate(:" << hostvar.getName() << ", " << data.getIso() << ')');
+    setValue(hostvar.getIndex(), data);
+    SET_TYPE(hostvar.getName(), "date");
+}
+
 void Statement::setTime(const std::string& col, const Time& data)
 {
     log_debug("setTime(\"" << col << "\", " << data.getIso() << ')');
-    setIsoValue(col, data);
+    setValue(hostvarIndex(col), data);
     SET_TYPE(col, "time");
 }
 
+void Statement::setTime(const HostvarHandle& hostvar, const Time& data)
+{
+    log_debug("setTime(:" << hostvar.getName() << ", " << data.getIso() << ')');
+    setValue(hostvar.getIndex(), data);
+    SET_TYPE(hostvar.getName(), "time");
+}
+
 void Statement::setDatetime(const std::string& col, const Datetime& data)
 {
     log_debug("setDatetime(\"" << col << "\", " << data.getIso() << ')');
-    setIsoValue(col, data);
+    setValue(hostvarIndex(col), data);
     SET_TYPE(col, "datetime");
 }
 
+void Statement::setDatetime(const HostvarHandle& hostvar, const Datetime& data)
+{
+    log_debug("setDatetime(:" << hostvar.getName() << ", " << data.getIso() << ')');
+    setValue(hostvar.getIndex(), data);
+    SET_TYPE(hostvar.getName(), "datetime");
+}
+
 Statement::size_type Statement::execute()
 {
     log_debug("execute()");
 
+#ifdef LIBPQ_HAS_PIPELINING
+    if (maxDelay > 0 && conn->inTransaction())
+    {
+        // queue the statement in the pipeline; the results are read on flush
+        sendPrepared();
+        if (++delayed >= maxDelay)
+            return flush();
+        return 0;
+    }
+#endif
+
     PGresult* result = execPrepared();
 
     std::istringstream tuples(PQcmdTuples(result));
@@ -480,12 +893,15 @@ tntdb::Result Statement::select()
 {
     log_debug("select()");
     PGresult* result = execPrepared();
+    conn->countResult(result);
     return tntdb::Result(std::make_shared<Result>(result));
 }
 
 tntdb::Row Statement::selectRow()
 {
-    auto result = std::make_shared<Result>(execPrepared());
+    PGresult* pgresult = execPrepared();
+    conn->countResult(pgresult);
+    auto result = std::make_shared<Result>(pgresult);
 
     if (result->size() <= 0)
         throw NotFound();
@@ -495,7 +911,9 @@ tntdb::Row Statement::selectRow()
 
 tntdb::Value Statement::selectValue()
 {
-    auto result = std::make_shared<Result>(execPrepared());
+    PGresult* pgresult = execPrepared();
+    conn->countResult(pgresult);
+    auto result = std::make_shared<Result>(pgresult);
 
     if (result->size() <= 0)
         throw NotFound();
@@ -505,9 +923,33 @@ tntdb::Value Statement::selectValue()
 
 std::shared_ptr<ICursor> Statement::createCursor(unsigned fetchsize)
 {
+    if (streaming)
+        return std::make_shared<StreamCursor>(*this, fetchsize);
     return std::make_shared<Cursor>(*this, fetchsize);
 }
 
+void Statement::maxNumDelay(size_type n)
+{
+    log_debug("maxNumDelay(" << n << ')');
+    maxDelay = n;
+}
+
+Statement::size_type Statement::numDelayed() const
+{
+    return delayed;
+}
+
+Statement::size_type Statement::flush()
+{
+    log_debug("flush(); " << delayed << " delayed");
+
+    conn->flushDelayed();
+
+    size_type ret = delayedAffected;
+    delayedAffected = 0;
+    return ret;
+}
+
 const char* const* Statement::getParamValues()
 {
     for (unsigned n = 0; n < values.size(); ++n)
@@ -522,6 +964,14 @@ const int* Statement::getParamLengths()
     return &paramLengths[0];
 }
 
+std::size_t Statement::getParamBytes()
+{
+    std::size_t bytes = 0;
+    for (unsigned n = 0; n < values.size(); ++n)
+        bytes += values[n].getLength();
+    return bytes;
+}
+
 PGconn* Statement::getPGConn()
 {
     return conn->getPGConn();
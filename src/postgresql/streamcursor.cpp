@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2005 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <tntdb/postgresql/impl/streamcursor.h>
+#include <tntdb/postgresql/impl/statement.h>
+#include <tntdb/postgresql/impl/connection.h>
+#include <tntdb/postgresql/impl/result.h>
+#include <tntdb/postgresql/impl/resultrow.h>
+#include <tntdb/postgresql/error.h>
+#include <tntdb/row.h>
+#include <cxxtools/log.h>
+#include <mutex>
+
+log_define("tntdb.postgresql.streamcursor")
+
+namespace tntdb
+{
+namespace postgresql
+{
+StreamCursor::StreamCursor(Statement& statement, unsigned fetchSize)
+  : stmt(statement),
+    conn(statement.getPGConn()),
+    currentRow(0),
+    done(false)
+{
+    const std::string& stmtName = stmt.getPreparedName();
+
+    log_debug("PQsendQueryPrepared(" << conn << ", \"" << stmtName
+      << "\", " << stmt.getNParams() << ", paramValues, paramLengths, paramFormats, "
+      << stmt.getResultFormat() << ')');
+    if (PQsendQueryPrepared(conn, stmtName.c_str(), stmt.getNParams(),
+            stmt.getParamValues(), stmt.getParamLengths(), stmt.getParamFormats(),
+            stmt.getResultFormat()) == 0)
+        throw PgSqlError(stmt.getQuery(), "PQsendQueryPrepared", conn);
+    stmt.getConnection()->countRoundTrip(stmtName.size() + stmt.getParamBytes());
+
+#ifdef LIBPQ_HAS_CHUNK_MODE
+    log_debug("PQsetChunkedRowsMode(" << conn << ", " << fetchSize << ')');
+    if (fetchSize > 1 && PQsetChunkedRowsMode(conn, fetchSize) != 0)
+        return;
+#else
+    if (fetchSize > 1)
+    {
+        // libpq before version 17 can only read the rows one by one
+        static std::once_flag warned;
+        std::call_once(warned, [fetchSize]()
+        {
+            log_warn("fetch size " << fetchSize << " has no effect on streaming cursors without libpq 17; rows are read one by one");
+        });
+    }
+#endif
+
+    log_debug("PQsetSingleRowMode(" << conn << ')');
+    if (PQsetSingleRowMode(conn) == 0)
+        log_warn("failed to set single row mode; result is read at once");
+}
+
+StreamCursor::~StreamCursor()
+{
+    if (!done)
+    {
+        // Outside a transaction we stop the server from sending rows, which
+        // are not needed anyway. In a transaction this would abort it, so
+        // the rest of the result is read.
+        if (!stmt.getConnection()->inTransaction())
+        {
+            PGcancel* cancel = PQgetCancel(conn);
+            if (cancel)
+            {
+                char errbuf[256];
+                log_debug("PQcancel");
+                if (!PQcancel(cancel, errbuf, sizeof(errbuf)))
+                    log_warn("failed to cancel query: " << errbuf);
+                PQfreeCancel(cancel);
+            }
+        }
+
+        discardResults();
+    }
+}
+
+void StreamCursor::discardResults()
+{
+    PGresult* result;
+    while ((result = PQgetResult(conn)) != 0)
+    {
+        log_debug("PQclear(" << result << ')');
+        PQclear(result);
+    }
+}
+
+void StreamCursor::finish(PGresult* result)
+{
+    done = true;
+    currentResult.reset();
+
+    if (isError(result))
+    {
+        log_error(PQresultErrorMessage(result));
+        PgSqlError e(stmt.getQuery(), "PQgetResult", result, true);
+        discardResults();
+        throw e;
+    }
+
+    log_debug("PQclear(" << result << ')');
+    PQclear(result);
+    discardResults();
+}
+
+Row StreamCursor::fetch()
+{
+    while (!currentResult || currentRow >= currentResult->size())
+    {
+        if (done)
+            return Row();
+
+        log_debug("PQgetResult(" << conn << ')');
+        PGresult* result = PQgetResult(conn);
+        if (result == 0)
+        {
+            done = true;
+            currentResult.reset();
+            return Row();
+        }
+
+        ExecStatusType status = PQresultStatus(result);
+        if (status == PGRES_SINGLE_TUPLE
+#ifdef LIBPQ_HAS_CHUNK_MODE
+            || status == PGRES_TUPLES_CHUNK
+#endif
+            )
+        {
+            stmt.getConnection()->countResult(result);
+            currentResult = std::make_shared<Result>(result, firstResult);
+            if (!firstResult)
+                firstResult = currentResult;
+            currentRow = 0;
+        }
+        else if (status == PGRES_TUPLES_OK && PQntuples(result) > 0)
+        {
+            // single row mode was not activated, so we got all rows at once
+            stmt.getConnection()->countResult(result);
+            currentResult = std::make_shared<Result>(result);
+            currentRow = 0;
+            done = true;
+            discardResults();
+        }
+        else
+        {
+            // the last result of the query, which has no rows in single row
+            // mode or an error
+            finish(result);
+        }
+    }
+
+    return Row(std::make_shared<ResultRow>(currentResult, currentRow++));
+}
+}
+}
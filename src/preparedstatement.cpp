@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2005 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <tntdb/preparedstatement.h>
+#include <tntdb/stmtparser.h>
+#include <tntdb/error.h>
+#include <cxxtools/log.h>
+#include <algorithm>
+#include <sstream>
+
+log_define("tntdb.preparedstatement")
+
+namespace tntdb
+{
+namespace
+{
+    // Collects the distinct host variables in the order of their first
+    // occurrence.
+    class HostvarCollector : public StmtEvent
+    {
+        std::vector<std::string> _names;
+
+    public:
+        std::string onHostVar(const std::string& name)
+        {
+            if (std::find(_names.begin(), _names.end(), name) == _names.end())
+                _names.push_back(name);
+            return std::string();
+        }
+
+        const std::vector<std::string>& getNames() const  { return _names; }
+    };
+}
+
+PreparedStatementBase::PreparedStatementBase(Connection& conn, const std::string& query, unsigned numArgs)
+{
+    HostvarCollector collector;
+    StmtParser parser;
+    parser.parse(query, collector);
+
+    const std::vector<std::string>& names = collector.getNames();
+    if (names.size() != numArgs)
+    {
+        std::ostringstream msg;
+        msg << "statement has " << names.size() << " host variables but "
+            << numArgs << " arguments are declared";
+        throw SqlError(query, msg.str());
+    }
+
+    _stmt = conn.prepare(query);
+
+    _hostvars.reserve(names.size());
+    for (std::vector<std::string>::const_iterator it = names.begin(); it != names.end(); ++it)
+    {
+        log_debug("resolve host variable :" << *it);
+        _hostvars.push_back(_stmt.hostvar(*it));
+    }
+}
+
+}
@@ -155,6 +155,23 @@ bool Connection::ping()
     return true;
 }
 
+bool Connection::isAlive()
+{
+    for (Connections::iterator it = connections.begin(); it != connections.end(); ++it)
+        if (!it->isAlive())
+            return false;
+    return true;
+}
+
+bool Connection::getMetrics(ConnectionMetrics& metrics)
+{
+    bool ret = false;
+    for (Connections::iterator it = connections.begin(); it != connections.end(); ++it)
+        if (it->getMetrics(metrics))
+            ret = true;
+    return ret;
+}
+
 long Connection::lastInsertId(const std::string& name)
 {
     return connections.begin()->lastInsertId(name);
@@ -27,22 +27,44 @@
  */
 
 #include <tntdb/impl/result.h>
+#include <tntdb/impl/row.h>
 #include <tntdb/row.h>
+#include <stdexcept>
 
 namespace tntdb
 {
   Row ResultImpl::getRow(size_type tup_num) const
   {
-    return data[tup_num];
+    if (tup_num >= size())
+      throw std::out_of_range("row number out of range");
+    return Row(std::make_shared<RowImpl>(shared_from_this(), tup_num));
   }
 
   ResultImpl::size_type ResultImpl::size() const
   {
-    return data.size();
+    return columnNames.empty() ? 0 : cells.size() / columnNames.size();
   }
 
   ResultImpl::size_type ResultImpl::getFieldCount() const
   {
-    return data.empty() ? 0 : data.begin()->size();
+    return columnNames.size();
+  }
+
+  void ResultImpl::addText(const char* value, std::size_t length)
+  {
+    Cell& cell = newCell(textCell);
+    cell.offset = data.size();
+    cell.length = static_cast<uint32_t>(length);
+    data.insert(data.end(), value, value + length);
+  }
+
+  void ResultImpl::addReal(double value, const char* text, std::size_t length)
+  {
+    Cell& cell = newCell(realCell);
+    cell.offset = data.size();
+    cell.length = static_cast<uint32_t>(length);
+    const char* v = reinterpret_cast<const char*>(&value);
+    data.insert(data.end(), v, v + sizeof(value));
+    data.insert(data.end(), text, text + length);
   }
 }
@@ -0,0 +1,340 @@
+/*
+ * Copyright (C) 2005 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <tntdb/impl/resultvalue.h>
+#include <tntdb/impl/textconv.h>
+#include <tntdb/date.h>
+#include <tntdb/time.h>
+#include <tntdb/datetime.h>
+#include <tntdb/decimal.h>
+#include <tntdb/blob.h>
+#include <tntdb/error.h>
+#include <limits>
+#include <sstream>
+#include <cmath>
+
+namespace
+{
+bool isTrue(char ch)
+{
+    return ch == 't' || ch == 'T' || ch == 'y' || ch == 'Y' || ch == '1';
+}
+
+void throwConversionError(const char* begin, const char* end, const char* tname)
+{
+    std::ostringstream msg;
+    msg << "can't convert \"" << std::string(begin, end) << "\" to " << tname;
+    throw tntdb::TypeError(msg.str());
+}
+
+template <typename T>
+T fromInteger(int64_t value, const char* tname)
+{
+    if ((std::numeric_limits<T>::is_signed
+            ? value < static_cast<int64_t>(std::numeric_limits<T>::min())
+            : value < 0)
+      || (value > 0 && static_cast<uint64_t>(value) > static_cast<uint64_t>(std::numeric_limits<T>::max())))
+    {
+        std::ostringstream msg;
+        msg << "value " << value << " out of range for " << tname;
+        throw tntdb::TypeError(msg.str());
+    }
+
+    return static_cast<T>(value);
+}
+
+}
+
+namespace tntdb
+{
+const char* ResultValueImpl::toText(char* buf, const char*& end) const
+{
+    switch (_cell.type)
+    {
+        case ResultImpl::nullCell:
+            throw NullValue();
+
+        case ResultImpl::integerCell:
+            end = textconv::format(buf, static_cast<long long>(_cell.integer));
+            return buf;
+
+        case ResultImpl::doubleCell:
+            end = textconv::format(buf, _cell.dbl);
+            return buf;
+
+        default:
+            end = getText() + _cell.length;
+            return getText();
+    }
+}
+
+template <typename T>
+T ResultValueImpl::getInteger(const char* tname) const
+{
+    switch (_cell.type)
+    {
+        case ResultImpl::nullCell:
+            throw NullValue();
+
+        case ResultImpl::integerCell:
+            return fromInteger<T>(_cell.integer, tname);
+
+        case ResultImpl::doubleCell:
+        case ResultImpl::realCell:
+        {
+            double d = getDbl();
+            if (d != std::floor(d) || d < -9223372036854775808.0 || d >= 9223372036854775808.0)
+            {
+                std::ostringstream msg;
+                msg << "can't convert " << d << " to " << tname;
+                throw TypeError(msg.str());
+            }
+            return fromInteger<T>(static_cast<int64_t>(d), tname);
+        }
+
+        default:
+        {
+            T ret;
+            const char* text = getText();
+            if (!textconv::parse(text, text + _cell.length, ret))
+                throwConversionError(text, text + _cell.length, tname);
+            return ret;
+        }
+    }
+}
+
+template <typename T>
+T ResultValueImpl::getFloat(const char* tname) const
+{
+    switch (_cell.type)
+    {
+        case ResultImpl::nullCell:
+            throw NullValue();
+
+        case ResultImpl::integerCell:
+            return static_cast<T>(_cell.integer);
+
+        case ResultImpl::doubleCell:
+        case ResultImpl::realCell:
+            return static_cast<T>(getDbl());
+
+        default:
+        {
+            T ret;
+            const char* text = getText();
+            if (!textconv::parse(text, text + _cell.length, ret))
+                throwConversionError(text, text + _cell.length, tname);
+            return ret;
+        }
+    }
+}
+
+bool ResultValueImpl::isNull() const
+{
+    return _cell.type == ResultImpl::nullCell;
+}
+
+bool ResultValueImpl::getBool() const
+{
+    switch (_cell.type)
+    {
+        case ResultImpl::nullCell:
+            throw NullValue();
+
+        case ResultImpl::integerCell:
+            return _cell.integer != 0;
+
+        case ResultImpl::doubleCell:
+        case ResultImpl::realCell:
+            return getDbl() != 0;
+
+        default:
+            return _cell.length > 0 && isTrue(getText()[0]);
+    }
+}
+
+short ResultValueImpl::getShort() const
+{
+    return getInteger<short>("short");
+}
+
+int ResultValueImpl::getInt() const
+{
+    return getInteger<int>("int");
+}
+
+long ResultValueImpl::getLong() const
+{
+    return getInteger<long>("long");
+}
+
+unsigned short ResultValueImpl::getUnsignedShort() const
+{
+    return getInteger<unsigned short>("unsigned short");
+}
+
+unsigned ResultValueImpl::getUnsigned() const
+{
+    return getInteger<unsigned>("unsigned");
+}
+
+unsigned long ResultValueImpl::getUnsignedLong() const
+{
+    return getInteger<unsigned long>("unsigned long");
+}
+
+int32_t ResultValueImpl::getInt32() const
+{
+    return getInteger<int32_t>("int32_t");
+}
+
+uint32_t ResultValueImpl::getUnsigned32() const
+{
+    return getInteger<uint32_t>("uint32_t");
+}
+
+int64_t ResultValueImpl::getInt64() const
+{
+    return getInteger<int64_t>("int64_t");
+}
+
+uint64_t ResultValueImpl::getUnsigned64() const
+{
+    return getInteger<uint64_t>("uint64_t");
+}
+
+Decimal ResultValueImpl::getDecimal() const
+{
+    switch (_cell.type)
+    {
+        case ResultImpl::nullCell:
+            throw NullValue();
+
+        case ResultImpl::integerCell:
+            return Decimal(static_cast<long long>(_cell.integer));
+
+        case ResultImpl::doubleCell:
+            return Decimal(_cell.dbl);
+
+        default:
+            return Decimal(getText(), getText() + _cell.length);
+    }
+}
+
+float ResultValueImpl::getFloat() const
+{
+    return getFloat<float>("float");
+}
+
+double ResultValueImpl::getDouble() const
+{
+    return getFloat<double>("double");
+}
+
+char ResultValueImpl::getChar() const
+{
+    char buf[textconv::maxFloatLength];
+    const char* end;
+    const char* text = toText(buf, end);
+    if (text == end)
+        throw NullValue();
+    return *text;
+}
+
+void ResultValueImpl::getString(std::string& ret) const
+{
+    char buf[textconv::maxFloatLength];
+    const char* end;
+    const char* text = toText(buf, end);
+    ret.assign(text, end);
+}
+
+void ResultValueImpl::getBlob(Blob& ret) const
+{
+    char buf[textconv::maxFloatLength];
+    const char* end;
+    const char* text = toText(buf, end);
+    ret.assign(text, end - text);
+}
+
+bool ResultValueImpl::getStringView(const char*& data, std::size_t& length) const
+{
+    if (_cell.type == ResultImpl::nullCell)
+        throw NullValue();
+
+    // numbers without text are formatted by getString
+    if (_cell.type != ResultImpl::textCell && _cell.type != ResultImpl::realCell)
+        return false;
+
+    data = getText();
+    length = _cell.length;
+    return true;
+}
+
+bool ResultValueImpl::getBlobView(const char*& data, std::size_t& length) const
+{
+    return getStringView(data, length);
+}
+
+Date ResultValueImpl::getDate() const
+{
+    char buf[textconv::maxFloatLength];
+    const char* end;
+    const char* text = toText(buf, end);
+
+    Date ret;
+    if (textconv::scanIsoDate(text, end, ret) == 0)
+        throw TypeError("failed to convert string \"" + std::string(text, end) + "\" into date");
+    return ret;
+}
+
+Time ResultValueImpl::getTime() const
+{
+    char buf[textconv::maxFloatLength];
+    const char* end;
+    const char* text = toText(buf, end);
+
+    Time ret;
+    if (textconv::scanIsoTime(text, end, ret) != end)
+        throw TypeError("failed to convert string \"" + std::string(text, end) + "\" into time");
+    return ret;
+}
+
+Datetime ResultValueImpl::getDatetime() const
+{
+    char buf[textconv::maxFloatLength];
+    const char* end;
+    const char* text = toText(buf, end);
+
+    Datetime ret;
+    if (textconv::scanIsoDatetime(text, end, ret) != end)
+        throw TypeError("failed to convert string \"" + std::string(text, end) + "\" into datetime");
+    return ret;
+}
+
+}
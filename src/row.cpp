@@ -28,9 +28,124 @@
 
 #include <tntdb/bits/row.h>
 #include <tntdb/bits/row_iterator.h>
+#include <tntdb/bits/value.h>
+#include <tntdb/error.h>
 
 namespace tntdb
 {
+  IRow::size_type IRow::getColumnIndex(const std::string& field_name) const
+  {
+    for (size_type n = 0; n < size(); ++n)
+      if (getColumnName(n) == field_name)
+        return n;
+    throw FieldNotFound(field_name);
+  }
+
+  bool IRow::isNull(size_type field_num) const
+  {
+    return getValueByNumber(field_num).isNull();
+  }
+
+  bool IRow::getBool(size_type field_num) const
+  {
+    return getValueByNumber(field_num).getBool();
+  }
+
+  short IRow::getShort(size_type field_num) const
+  {
+    return getValueByNumber(field_num).getShort();
+  }
+
+  int IRow::getInt(size_type field_num) const
+  {
+    return getValueByNumber(field_num).getInt();
+  }
+
+  long IRow::getLong(size_type field_num) const
+  {
+    return getValueByNumber(field_num).getLong();
+  }
+
+  unsigned IRow::getUnsigned(size_type field_num) const
+  {
+    return getValueByNumber(field_num).getUnsigned();
+  }
+
+  unsigned short IRow::getUnsignedShort(size_type field_num) const
+  {
+    return getValueByNumber(field_num).getUnsignedShort();
+  }
+
+  unsigned long IRow::getUnsignedLong(size_type field_num) const
+  {
+    return getValueByNumber(field_num).getUnsignedLong();
+  }
+
+  int32_t IRow::getInt32(size_type field_num) const
+  {
+    return getValueByNumber(field_num).getInt32();
+  }
+
+  uint32_t IRow::getUnsigned32(size_type field_num) const
+  {
+    return getValueByNumber(field_num).getUnsigned32();
+  }
+
+  int64_t IRow::getInt64(size_type field_num) const
+  {
+    return getValueByNumber(field_num).getInt64();
+  }
+
+  uint64_t IRow::getUnsigned64(size_type field_num) const
+  {
+    return getValueByNumber(field_num).getUnsigned64();
+  }
+
+  Decimal IRow::getDecimal(size_type field_num) const
+  {
+    return getValueByNumber(field_num).getDecimal();
+  }
+
+  float IRow::getFloat(size_type field_num) const
+  {
+    return getValueByNumber(field_num).getFloat();
+  }
+
+  double IRow::getDouble(size_type field_num) const
+  {
+    return getValueByNumber(field_num).getDouble();
+  }
+
+  char IRow::getChar(size_type field_num) const
+  {
+    return getValueByNumber(field_num).getChar();
+  }
+
+  void IRow::getString(size_type field_num, std::string& ret) const
+  {
+    getValueByNumber(field_num).getString(ret);
+  }
+
+  void IRow::getBlob(size_type field_num, Blob& ret) const
+  {
+    getValueByNumber(field_num).getBlob(ret);
+  }
+
+  Date IRow::getDate(size_type field_num) const
+  {
+    return getValueByNumber(field_num).getDate();
+  }
+
+  Time IRow::getTime(size_type field_num) const
+  {
+    return getValueByNumber(field_num).getTime();
+  }
+
+  Datetime IRow::getDatetime(size_type field_num) const
+  {
+    return getValueByNumber(field_num).getDatetime();
+  }
+
   Row::const_iterator Row::begin() const
   {
     return const_iterator(*this, 0);
@@ -27,39 +27,153 @@
  */
 
 #include <tntdb/impl/row.h>
-#include <tntdb/impl/value.h>
+#include <tntdb/impl/result.h>
+#include <tntdb/impl/resultvalue.h>
 #include <tntdb/value.h>
-#include <tntdb/error.h>
+#include <tntdb/date.h>
+#include <tntdb/time.h>
+#include <tntdb/datetime.h>
+#include <tntdb/decimal.h>
+#include <tntdb/blob.h>
+#include <stdexcept>
 
 namespace tntdb
 {
   RowImpl::size_type RowImpl::size() const
   {
-    return data.size();
+    return _result->getFieldCount();
+  }
+
+  RowImpl::size_type RowImpl::cellIndex(size_type field_num) const
+  {
+    if (field_num >= size())
+      throw std::out_of_range("field number out of range");
+    return _tupNum * size() + field_num;
   }
 
   Value RowImpl::getValueByNumber(size_type field_num) const
   {
-    return data[field_num].value;
+    return Value(std::make_shared<ResultValueImpl>(_result, cellIndex(field_num)));
   }
 
   Value RowImpl::getValueByName(const std::string& field_name) const
   {
-    data_type::const_iterator it;
+    return getValueByNumber(_result->getColumnIndex(field_name));
+  }
 
-    for (it = data.begin(); it != data.end(); ++it)
-      if (it->name == field_name)
-        break;
+  std::string RowImpl::getColumnName(size_type field_num) const
+  {
+    return _result->getColumnName(field_num);
+  }
 
-    if (it == data.end())
-      throw FieldNotFound(field_name);
+  RowImpl::size_type RowImpl::getColumnIndex(const std::string& field_name) const
+  {
+    return _result->getColumnIndex(field_name);
+  }
 
-    return it->value;
+  bool RowImpl::isNull(size_type field_num) const
+  {
+    return ResultValueImpl(*_result, cellIndex(field_num)).isNull();
   }
 
-  std::string RowImpl::getColumnName(size_type field_num) const
+  bool RowImpl::getBool(size_type field_num) const
+  {
+    return ResultValueImpl(*_result, cellIndex(field_num)).getBool();
+  }
+
+  short RowImpl::getShort(size_type field_num) const
+  {
+    return ResultValueImpl(*_result, cellIndex(field_num)).getShort();
+  }
+
+  int RowImpl::getInt(size_type field_num) const
+  {
+    return ResultValueImpl(*_result, cellIndex(field_num)).getInt();
+  }
+
+  long RowImpl::getLong(size_type field_num) const
+  {
+    return ResultValueImpl(*_result, cellIndex(field_num)).getLong();
+  }
+
+  unsigned RowImpl::getUnsigned(size_type field_num) const
+  {
+    return ResultValueImpl(*_result, cellIndex(field_num)).getUnsigned();
+  }
+
+  unsigned short RowImpl::getUnsignedShort(size_type field_num) const
+  {
+    return ResultValueImpl(*_result, cellIndex(field_num)).getUnsignedShort();
+  }
+
+  unsigned long RowImpl::getUnsignedLong(size_type field_num) const
+  {
+    return ResultValueImpl(*_result, cellIndex(field_num)).getUnsignedLong();
+  }
+
+  int32_t RowImpl::getInt32(size_type field_num) const
+  {
+    return ResultValueImpl(*_result, cellIndex(field_num)).getInt32();
+  }
+
+  uint32_t RowImpl::getUnsigned32(size_type field_num) const
+  {
+    return ResultValueImpl(*_result, cellIndex(field_num)).getUnsigned32();
+  }
+
+  int64_t RowImpl::getInt64(size_type field_num) const
+  {
+    return ResultValueImpl(*_result, cellIndex(field_num)).getInt64();
+  }
+
+  uint64_t RowImpl::getUnsigned64(size_type field_num) const
+  {
+    return ResultValueImpl(*_result, cellIndex(field_num)).getUnsigned64();
+  }
+
+  Decimal RowImpl::getDecimal(size_type field_num) const
+  {
+    return ResultValueImpl(*_result, cellIndex(field_num)).getDecimal();
+  }
+
+  float RowImpl::getFloat(size_type field_num) const
+  {
+    return ResultValueImpl(*_result, cellIndex(field_num)).getFloat();
+  }
+
+  double RowImpl::getDouble(size_type field_num) const
+  {
+    return ResultValueImpl(*_result, cellIndex(field_num)).getDouble();
+  }
+
+  char RowImpl::getChar(size_type field_num) const
+  {
+    return ResultValueImpl(*_result, cellIndex(field_num)).getChar();
+  }
+
+  void RowImpl::getString(size_type field_num, std::string& ret) const
+  {
+    ResultValueImpl(*_result, cellIndex(field_num)).getString(ret);
+  }
+
+  void RowImpl::getBlob(size_type field_num, Blob& ret) const
+  {
+    ResultValueImpl(*_result, cellIndex(field_num)).getBlob(ret);
+  }
+
+  Date RowImpl::getDate(size_type field_num) const
+  {
+    return ResultValueImpl(*_result, cellIndex(field_num)).getDate();
+  }
+
+  Time RowImpl::getTime(size_type field_num) const
+  {
+    return ResultValueImpl(*_result, cellIndex(field_num)).getTime();
+  }
+
+  Datetime RowImpl::getDatetime(size_type field_num) const
   {
-    return data[field_num].name;
+    return ResultValueImpl(*_result, cellIndex(field_num)).getDatetime();
   }
 
 }
@@ -150,6 +150,11 @@ bool Connection::ping()
     return db != 0;
 }
 
+bool Connection::isAlive()
+{
+    return db != 0;
+}
+
 long Connection::lastInsertId(const std::string& name)
 {
     return static_cast<int>(sqlite3_last_insert_rowid(db));
@@ -39,7 +39,8 @@ namespace tntdb
 namespace sqlite
 {
 Cursor::Cursor(Statement* stmt)
-  : _stmt(stmt)
+  : _stmt(stmt),
+    _columnIndex(std::make_shared<ColumnIndex>())
 { }
 
 Row Cursor::fetch()
@@ -54,7 +55,7 @@ Row Cursor::fetch()
     else if (ret != SQLITE_ROW)
         throw Execerror("sqlite3_step", stmt, ret);
 
-    return Row(std::make_shared<StmtRow>(stmt));
+    return Row(std::make_shared<StmtRow>(stmt, _columnIndex));
 }
 }
 }
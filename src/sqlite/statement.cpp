@@ -30,8 +30,7 @@
 #include <tntdb/sqlite/impl/cursor.h>
 #include <tntdb/sqlite/impl/connection.h>
 #include <tntdb/impl/result.h>
-#include <tntdb/impl/row.h>
-#include <tntdb/impl/value.h>
+#include <tntdb/impl/resultvalue.h>
 #include <tntdb/sqlite/error.h>
 #include <tntdb/date.h>
 #include <tntdb/time.h>
@@ -50,6 +49,64 @@ namespace tntdb
 {
 namespace sqlite
 {
+namespace
+{
+    std::shared_ptr<ResultImpl> createResult(sqlite3_stmt* stmt)
+    {
+        std::shared_ptr<ResultImpl> result = std::make_shared<ResultImpl>();
+
+        log_debug("sqlite3_column_count(" << stmt << ')');
+        int count = ::sqlite3_column_count(stmt);
+        for (int i = 0; i < count; ++i)
+        {
+            log_debug("sqlite3_column_name(" << stmt << ", " << i << ')');
+            const char* name = sqlite3_column_name(stmt, i);
+            if (name == 0)
+                throw std::bad_alloc();
+
+            result->addColumn(name);
+        }
+
+        return result;
+    }
+
+    // copies the values of the current row into the result
+    void addRow(ResultImpl& result, sqlite3_stmt* stmt, int count)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            switch (sqlite3_column_type(stmt, i))
+            {
+                case SQLITE_NULL:
+                    result.addNull();
+                    break;
+
+                case SQLITE_INTEGER:
+                    result.addInteger(sqlite3_column_int64(stmt, i));
+                    break;
+
+                case SQLITE_FLOAT:
+                {
+                    // keep the text of sqlite, which is returned by the
+                    // values of cursors as well
+                    double value = sqlite3_column_double(stmt, i);
+                    const unsigned char* text = sqlite3_column_text(stmt, i);
+                    int n = sqlite3_column_bytes(stmt, i);
+                    result.addReal(value, reinterpret_cast<const char*>(text), text ? n : 0);
+                    break;
+                }
+
+                default:
+                {
+                    const void* data = sqlite3_column_blob(stmt, i);
+                    int n = sqlite3_column_bytes(stmt, i);
+                    result.addText(static_cast<const char*>(data), data ? n : 0);
+                }
+            }
+        }
+    }
+}
+
 Statement::Statement(Connection& conn, const std::string& query)
 : _stmt(0),
   _conn(conn),
@@ -142,9 +199,8 @@ void Statement::clear()
     }
 }
 
-void Statement::setNull(const std::string& col)
+void Statement::bindNull(int idx)
 {
-    int idx = getBindIndex(col);
     getBindStmt();
     if (idx != 0)
     {
@@ -158,19 +214,18 @@ void Statement::setNull(const std::string& col)
     }
 }
 
-void Statement::setBool(const std::string& col, bool data)
+void Statement::bindBool(int idx, bool data)
 {
-    setInt(col, data ? 1 : 0);
+    bindInt(idx, data ? 1 : 0);
 }
 
-void Statement::setShort(const std::string& col, short data)
+void Statement::bindShort(int idx, short data)
 {
-    setInt(col, data);
+    bindInt(idx, data);
 }
 
-void Statement::setInt(const std::string& col, int data)
+void Statement::bindInt(int idx, int data)
 {
-    int idx = getBindIndex(col);
     getBindStmt();
     if (idx != 0)
     {
@@ -184,9 +239,8 @@ void Statement::setInt(const std::string& col, int data)
     }
 }
 
-void Statement::setLong(const std::string& col, long data)
+void Statement::bindLong(int idx, long data)
 {
-    int idx = getBindIndex(col);
     getBindStmt();
     if (idx != 0)
     {
@@ -200,55 +254,54 @@ void Statement::setLong(const std::string& col, long data)
     }
 }
 
-void Statement::setInt32(const std::string& col, int32_t data)
+void Statement::bindInt32(int idx, int32_t data)
 {
-    setInt(col, data);
+    bindInt(idx, data);
 }
 
-void Statement::setUnsignedShort(const std::string& col, unsigned short data)
+void Statement::bindUnsignedShort(int idx, unsigned short data)
 {
     if (data > static_cast<unsigned short>(std::numeric_limits<unsigned short>::max()))
     {
         log_warn("possible loss of precision while converting unsigned short " << data
           << " to double");
-        setDouble(col, static_cast<double>(data));
+        bindDouble(idx, static_cast<double>(data));
     }
     else
-        setInt(col, static_cast<int>(data));
+        bindInt(idx, static_cast<int>(data));
 }
 
-void Statement::setUnsigned(const std::string& col, unsigned data)
+void Statement::bindUnsigned(int idx, unsigned data)
 {
     if (data > static_cast<unsigned>(std::numeric_limits<int>::max()))
     {
         log_warn("possible loss of precision while converting unsigned " << data
           << " to double");
-        setDouble(col, static_cast<double>(data));
+        bindDouble(idx, static_cast<double>(data));
     }
     else
-        setInt(col, static_cast<int>(data));
+        bindInt(idx, static_cast<int>(data));
 }
 
-void Statement::setUnsignedLong(const std::string& col, unsigned long data)
+void Statement::bindUnsignedLong(int idx, unsigned long data)
 {
     if (data > static_cast<unsigned long>(std::numeric_limits<long>::max()))
     {
         log_warn("possible loss of precision while converting long unsigned " << data
           << " to double");
-        setDouble(col, static_cast<double>(data));
+        bindDouble(idx, static_cast<double>(data));
     }
     else
-        setLong(col, static_cast<long>(data));
+        bindLong(idx, static_cast<long>(data));
 }
 
-void Statement::setUnsigned32(const std::string& col, uint32_t data)
+void Statement::bindUnsigned32(int idx, uint32_t data)
 {
-    setUnsigned(col, data);
+    bindUnsigned(idx, data);
 }
 
-void Statement::setInt64(const std::string& col, int64_t data)
+void Statement::bindInt64(int idx, int64_t data)
 {
-    int idx = getBindIndex(col);
     getBindStmt();
     if (idx != 0)
     {
@@ -262,12 +315,12 @@ void Statement::setInt64(const std::string& col, int64_t data)
     }
 }
 
-void Statement::setUnsigned64(const std::string& col, uint64_t data)
+void Statement::bindUnsigned64(int idx, uint64_t data)
 {
-    setInt64(col, (int64_t)data);
+    bindInt64(idx, (int64_t)data);
 }
 
-void Statement::setDecimal(const std::string& col, const Decimal& data)
+void Statement::bindDecimal(int idx, const Decimal& data)
 {
     // SQLite 3.4.1 does not support the SQL decimal or numeric types.
     // So double is used instead, but of course binary floating point can
@@ -279,17 +332,16 @@ void Statement::setDecimal(const std::string& col, const Decimal& data)
     // yet the API documentation talks about returning an int, double
     // or text string.
     double d = data.getDouble();
-    setDouble(col, d);
+    bindDouble(idx, d);
 }
 
-void Statement::setFloat(const std::string& col, float data)
+void Statement::bindFloat(int idx, float data)
 {
-    setDouble(col, static_cast<double>(data));
+    bindDouble(idx, static_cast<double>(data));
 }
 
-void Statement::setDouble(const std::string& col, double data)
+void Statement::bindDouble(int idx, double data)
 {
-    int idx = getBindIndex(col);
     getBindStmt();
     if (idx != 0)
     {
@@ -303,9 +355,8 @@ void Statement::setDouble(const std::string& col, double data)
     }
 }
 
-void Statement::setChar(const std::string& col, char data)
+void Statement::bindChar(int idx, char data)
 {
-    int idx = getBindIndex(col);
     getBindStmt();
     if (idx != 0)
     {
@@ -320,9 +371,8 @@ void Statement::setChar(const std::string& col, char data)
     }
 }
 
-void Statement::setString(const std::string& col, const std::string& data)
+void Statement::bindString(int idx, const std::string& data)
 {
-    int idx = getBindIndex(col);
     getBindStmt();
     if (idx != 0)
     {
@@ -337,9 +387,8 @@ void Statement::setString(const std::string& col, const std::string& data)
     }
 }
 
-void Statement::setBlob(const std::string& col, const Blob& data)
+void Statement::bindBlob(int idx, const Blob& data)
 {
-    int idx = getBindIndex(col);
     getBindStmt();
     if (idx != 0)
     {
@@ -354,19 +403,240 @@ void Statement::setBlob(const std::string& col, const Blob& data)
     }
 }
 
+void Statement::bindDate(int idx, const Date& data)
+{
+    bindString(idx, data.getIso());
+}
+
+void Statement::bindTime(int idx, const Time& data)
+{
+    bindString(idx, data.getIso());
+}
+
+void Statement::bindDatetime(int idx, const Datetime& data)
+{
+    bindString(idx, data.getIso());
+}
+
+HostvarHandle Statement::hostvar(const std::string& col)
+{
+    int idx = getBindIndex(col);
+    return HostvarHandle(col, idx == 0 ? HostvarHandle::invalidIndex : idx);
+}
+
+int Statement::getBindIndex(const HostvarHandle& hostvar)
+{
+    return !hostvar ? 0 : static_cast<int>(hostvar.getIndex());
+}
+
+void Statement::setNull(const std::string& col)
+{
+    bindNull(getBindIndex(col));
+}
+
+void Statement::setNull(const HostvarHandle& hostvar)
+{
+    bindNull(getBindIndex(hostvar));
+}
+
+void Statement::setBool(const std::string& col, bool data)
+{
+    bindBool(getBindIndex(col), data);
+}
+
+void Statement::setBool(const HostvarHandle& hostvar, bool data)
+{
+    bindBool(getBindIndex(hostvar), data);
+}
+
+void Statement::setShort(const std::string& col, short data)
+{
+    bindShort(getBindIndex(col), data);
+}
+
+void Statement::setShort(const HostvarHandle& hostvar, short data)
+{
+    bindShort(getBindIndex(hostvar), data);
+}
+
+void Statement::setInt(const std::string& col, int data)
+{
+    bindInt(getBindIndex(col), data);
+}
+
+void Statement::setInt(const HostvarHandle& hostvar, int data)
+{
+    bindInt(getBindIndex(hostvar), data);
+}
+
+void Statement::setLong(const std::string& col, long data)
+{
+    bindLong(getBindIndex(col), data);
+}
+
+void Statement::setLong(const HostvarHandle& hostvar, long data)
+{
+    bindLong(getBindIndex(hostvar), data);
+}
+
+void Statement::setUnsignedShort(const std::string& col, unsigned short data)
+{
+    bindUnsignedShort(getBindIndex(col), data);
+}
+
+void Statement::setUnsignedShort(const HostvarHandle& hostvar, unsigned short data)
+{
+    bindUnsignedShort(getBindIndex(hostvar), data);
+}
+
+void Statement::setUnsigned(const std::string& col, unsigned data)
+{
+    bindUnsigned(getBindIndex(col), data);
+}
+
+void Statement::setUnsigned(const HostvarHandle& hostvar, unsigned data)
+{
+    bindUnsigned(getBindIndex(hostvar), data);
+}
+
+void Statement::setUnsignedLong(const std::string& col, unsigned long data)
+{
+    bindUnsignedLong(getBindIndex(col), data);
+}
+
+void Statement::setUnsignedLong(const HostvarHandle& hostvar, unsigned long data)
+{
+    bindUnsignedLong(getBindIndex(hostvar), data);
+}
+
+void Statement::setInt32(const std::string& col, int32_t data)
+{
+    bindInt32(getBindIndex(col), data);
+}
+
+void Statement::setInt32(const HostvarHandle& hostvar, int32_t data)
+{
+    bindInt32(getBindIndex(hostvar), data);
+}
+
+void Statement::setUnsigned32(const std::string& col, uint32_t data)
+{
+    bindUnsigned32(getBindIndex(col), data);
+}
+
+void Statement::setUnsigned32(const HostvarHandle& hostvar, uint32_t data)
+{
+    bindUnsigned32(getBindIndex(hostvar), data);
+}
+
+void Statement::setInt64(const std::string& col, int64_t data)
+{
+    bindInt64(getBindIndex(col), data);
+}
+
+void Statement::setInt64(const HostvarHandle& hostvar, int64_t data)
+{
+    bindInt64(getBindIndex(hostvar), data);
+}
+
+void Statement::setUnsigned64(const std::string& col, uint64_t data)
+{
+    bindUnsigned64(getBindIndex(col), data);
+}
+
+void Statement::setUnsigned64(const HostvarHandle& hostvar, uint64_t data)
+{
+    bindUnsigned64(getBindIndex(hostvar), data);
+}
+
+void Statement::setDecimal(const std::string& col, const Decimal& data)
+{
+    bindDecimal(getBindIndex(col), data);
+}
+
+void Statement::setDecimal(const HostvarHandle& hostvar, const Decimal& data)
+{
+    bindDecimal(getBindIndex(hostvar), data);
+}
+
+void Statement::setFloat(const std::string& col, float data)
+{
+    bindFloat(getBindIndex(col), data);
+}
+
+void Statement::setFloat(const HostvarHandle& hostvar, float data)
+{
+    bindFloat(getBindIndex(hostvar), data);
+}
+
+void Statement::setDouble(const std::string& col, double data)
+{
+    bindDouble(getBindIndex(col), data);
+}
+
+void Statement::setDouble(const HostvarHandle& hostvar, double data)
+{
+    bindDouble(getBindIndex(hostvar), data);
+}
+
+void Statement::setChar(const std::string& col, char data)
+{
+    bindChar(getBindIndex(col), data);
+}
+
+void Statement::setChar(const HostvarHandle& hostvar, char data)
+{
+    bindChar(getBindIndex(hostvar), data);
+}
+
+void Statement::setString(const std::string& col, const std::string& data)
+{
+    bindString(getBindIndex(col), data);
+}
+
+void Statement::setString(const HostvarHandle& hostvar, const std::string& data)
+{
+    bindString(getBindIndex(hostvar), data);
+}
+
+void Statement::setBlob(const std::string& col, const Blob& data)
+{
+    bindBlob(getBindIndex(col), data);
+}
+
+void Statement::setBlob(const HostvarHandle& hostvar, const Blob& data)
+{
+    bindBlob(getBindIndex(hostvar), data);
+}
+
 void Statement::setDate(const std::string& col, const Date& data)
 {
-    setString(col, data.getIso());
+    bindDate(getBindIndex(col), data);
+}
+
+void Statement::setDate(const HostvarHandle& hostvar, const Date& data)
+{
+    bindDate(getBindIndex(hostvar), data);
 }
 
 void Statement::setTime(const std::string& col, const Time& data)
 {
-    setString(col, data.getIso());
+    bindTime(getBindIndex(col), data);
+}
+
+void Statement::setTime(const HostvarHandle& hostvar, const Time& data)
+{
+    bindTime(getBindIndex(hostvar), data);
 }
 
 void Statement::setDatetime(const std::string& col, const Datetime& data)
 {
-    setString(col, data.getIso());
+    bindDatetime(getBindIndex(col), data);
+}
+
+void Statement::setDatetime(const HostvarHandle& hostvar, const Datetime& data)
+{
+    bindDatetime(getBindIndex(hostvar), data);
 }
 
 Statement::size_type Statement::execute()
@@ -395,7 +665,9 @@ Result Statement::select()
     reset();
     _needReset = true;
 
-    std::shared_ptr<ResultImpl> result = std::make_shared<ResultImpl>();
+    std::shared_ptr<ResultImpl> result = createResult(_stmt);
+    int count = result->getFieldCount();
+
     int ret;
     do
     {
@@ -404,36 +676,7 @@ Result Statement::select()
 
         if (ret == SQLITE_ROW)
         {
-            log_debug("sqlite3_column_count(" << _stmt << ')');
-            int count = ::sqlite3_column_count(_stmt);
-            std::shared_ptr<RowImpl> row = std::make_shared<RowImpl>();
-            for (int i = 0; i < count; ++i)
-            {
-                log_debug("sqlite3_column_bytes(" << _stmt << ", " << i << ')');
-                int n = sqlite3_column_bytes(_stmt, i);
-
-                const void* txt = 0;
-
-                if (n > 0)
-                {
-                    log_debug("sqlite3_column_blob(" << _stmt << ", " << i << ')');
-                    txt = sqlite3_column_blob(_stmt, i);
-                }
-
-                std::shared_ptr<ValueImpl> v;
-                if (txt)
-                    v = std::make_shared<ValueImpl>(
-                    std::string(static_cast<const char*>(txt), n));
-
-                log_debug("sqlite3_column_name(" << _stmt << ", " << i << ')');
-                const char* name = sqlite3_column_name(_stmt, i);
-                if (name == 0)
-                    throw std::bad_alloc();
-
-                row->add(name, Value(v));
-            }
-
-            result->add(Row(row));
+            addRow(*result, _stmt, count);
         }
         else if (ret != SQLITE_DONE)
         {
@@ -443,6 +686,8 @@ Result Statement::select()
 
     } while (ret == SQLITE_ROW);
 
+    log_debug("select returns " << result->size() << " rows");
+
     return Result(result);
 }
 
@@ -458,37 +703,11 @@ Row Statement::selectRow()
         throw NotFound();
     else if (ret == SQLITE_ROW)
     {
-        log_debug("sqlite3_column_count(" << _stmt << ')');
-        int count = ::sqlite3_column_count(_stmt);
-        std::shared_ptr<RowImpl> row = std::make_shared<RowImpl>();
-        for (int i = 0; i < count; ++i)
-        {
-            log_debug("sqlite3_column_bytes(" << _stmt << ", " << i << ')');
-            int n = sqlite3_column_bytes(_stmt, i);
-
-            const void* txt = 0;
-
-            if (n > 0)
-            {
-                log_debug("sqlite3_column_blob(" << _stmt << ", " << i << ')');
-                txt = sqlite3_column_blob(_stmt, i);
-            }
-
-            std::shared_ptr<ValueImpl> v;
-            if (txt)
-                v = std::make_shared<ValueImpl>(
-                    std::string(static_cast<const char*>(txt), n));
-
-            log_debug("sqlite3_column_name(" << _stmt << ", " << i << ')');
-            const char* name = sqlite3_column_name(_stmt, i);
-            if (name == 0)
-                throw std::bad_alloc();
-
-            row->add(name, Value(v));
-        }
+        std::shared_ptr<ResultImpl> result = createResult(_stmt);
+        addRow(*result, _stmt, result->getFieldCount());
 
         reset();
-        return Row(row);
+        return result->getRow(0);
     }
     else
     {
@@ -518,24 +737,12 @@ Value Statement::selectValue()
         if (count == 0)
             throw NotFound();
 
-        log_debug("sqlite3_column_bytes(" << _stmt << ", 0)");
-        int n = sqlite3_column_bytes(_stmt, 0);
-
-        const void* txt = 0;
-
-        if (n > 0)
-        {
-            log_debug("sqlite3_column_blob(" << _stmt << ", 0)");
-            txt = sqlite3_column_blob(_stmt, 0);
-        }
-
-        std::shared_ptr<ValueImpl> v;
-        if (txt)
-            v = std::make_shared<ValueImpl>(
-                std::string(static_cast<const char*>(txt), n));
+        std::shared_ptr<ResultImpl> result = std::make_shared<ResultImpl>();
+        result->addColumn(std::string());
+        addRow(*result, _stmt, 1);
 
         reset();
-        return Value(v);
+        return Value(std::make_shared<ResultValueImpl>(result, 0));
     }
     else
     {
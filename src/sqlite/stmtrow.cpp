@@ -29,6 +29,11 @@
 #include <tntdb/sqlite/impl/stmtrow.h>
 #include <tntdb/sqlite/impl/stmtvalue.h>
 #include <tntdb/value.h>
+#include <tntdb/date.h>
+#include <tntdb/time.h>
+#include <tntdb/datetime.h>
+#include <tntdb/decimal.h>
+#include <tntdb/blob.h>
 
 namespace tntdb
 {
@@ -46,7 +51,7 @@ Value StmtRow::getValueByNumber(size_type field_num) const
 
 Value StmtRow::getValueByName(const std::string& field_name) const
 {
-    return Value(std::make_shared<StmtValue>(stmt, field_name));
+    return getValueByNumber(getColumnIndex(field_name));
 }
 
 std::string StmtRow::getColumnName(size_type field_num) const
@@ -57,5 +62,123 @@ std::string StmtRow::getColumnName(size_type field_num) const
     return name;
 }
 
+StmtRow::size_type StmtRow::getColumnIndex(const std::string& field_name) const
+{
+    if (columnIndex->empty())
+    {
+        size_type count = size();
+        columnIndex->reserve(count);
+        for (size_type n = 0; n < count; ++n)
+            columnIndex->add(getColumnName(n), n);
+    }
+
+    return columnIndex->get(field_name);
+}
+
+bool StmtRow::isNull(size_type field_num) const
+{
+    return StmtValue(stmt, field_num).isNull();
+}
+
+bool StmtRow::getBool(size_type field_num) const
+{
+    return StmtValue(stmt, field_num).getBool();
+}
+
+short StmtRow::getShort(size_type field_num) const
+{
+    return StmtValue(stmt, field_num).getShort();
+}
+
+int StmtRow::getInt(size_type field_num) const
+{
+    return StmtValue(stmt, field_num).getInt();
+}
+
+long StmtRow::getLong(size_type field_num) const
+{
+    return StmtValue(stmt, field_num).getLong();
+}
+
+unsigned StmtRow::getUnsigned(size_type field_num) const
+{
+    return StmtValue(stmt, field_num).getUnsigned();
+}
+
+unsigned short StmtRow::getUnsignedShort(size_type field_num) const
+{
+    return StmtValue(stmt, field_num).getUnsignedShort();
+}
+
+unsigned long StmtRow::getUnsignedLong(size_type field_num) const
+{
+    return StmtValue(stmt, field_num).getUnsignedLong();
+}
+
+int32_t StmtRow::getInt32(size_type field_num) const
+{
+    return StmtValue(stmt, field_num).getInt32();
+}
+
+uint32_t StmtRow::getUnsigned32(size_type field_num) const
+{
+    return StmtValue(stmt, field_num).getUnsigned32();
+}
+
+int64_t StmtRow::getInt64(size_type field_num) const
+{
+    return StmtValue(stmt, field_num).getInt64();
+}
+
+uint64_t StmtRow::getUnsigned64(size_type field_num) const
+{
+    return StmtValue(stmt, field_num).getUnsigned64();
+}
+
+Decimal StmtRow::getDecimal(size_type field_num) const
+{
+    return StmtValue(stmt, field_num).getDecimal();
+}
+
+float StmtRow::getFloat(size_type field_num) const
+{
+    return StmtValue(stmt, field_num).getFloat();
+}
+
+double StmtRow::getDouble(size_type field_num) const
+{
+    return StmtValue(stmt, field_num).getDouble();
+}
+
+char StmtRow::getChar(size_type field_num) const
+{
+    return StmtValue(stmt, field_num).getChar();
+}
+
+void StmtRow::getString(size_type field_num, std::string& ret) const
+{
+    StmtValue(stmt, field_num).getString(ret);
+}
+
+void StmtRow::getBlob(size_type field_num, Blob& ret) const
+{
+    StmtValue(stmt, field_num).getBlob(ret);
+}
+
+Date StmtRow::getDate(size_type field_num) const
+{
+    return StmtValue(stmt, field_num).getDate();
+}
+
+Time StmtRow::getTime(size_type field_num) const
+{
+    return StmtValue(stmt, field_num).getTime();
+}
+
+Datetime StmtRow::getDatetime(size_type field_num) const
+{
+    return StmtValue(stmt, field_num).getDatetime();
+}
+
 }
 }
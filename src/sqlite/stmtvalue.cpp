@@ -181,6 +181,33 @@ namespace tntdb
       }
     }
 
+    bool StmtValue::getStringView(const char*& data, std::size_t& length) const
+    {
+      // the pointer returned by sqlite3_column_blob stays valid until the
+      // next step, reset or finalize of the statement
+      log_debug("sqlite3_column_bytes(" << getStmt() << ", " << iCol << ')');
+      int bytes = ::sqlite3_column_bytes(getStmt(), iCol);
+
+      if (bytes <= 0)
+      {
+        data = "";
+        length = 0;
+      }
+      else
+      {
+        log_debug("sqlite3_column_blob(" << getStmt() << ", " << iCol << ')');
+        data = reinterpret_cast<const char*>(::sqlite3_column_blob(getStmt(), iCol));
+        length = bytes;
+      }
+
+      return true;
+    }
+
+    bool StmtValue::getBlobView(const char*& data, std::size_t& length) const
+    {
+      return getStringView(data, length);
+    }
+
     void StmtValue::getBlob(Blob& ret) const
     {
       log_debug("sqlite3_column_bytes(" << getStmt() << ", " << iCol << ')');
@@ -31,6 +31,7 @@
 #include <tntdb/result.h>
 #include <tntdb/row.h>
 #include <tntdb/value.h>
+#include <tntdb/error.h>
 #include <cxxtools/utf8codec.h>
 #include <cxxtools/log.h>
 
@@ -38,6 +39,21 @@ log_define("tntdb.statement")
 
 namespace tntdb
 {
+const unsigned HostvarHandle::invalidIndex;
+const unsigned HostvarHandle::nameIndex;
+
+namespace
+{
+    // The default implementation passes the name to the driver. A handle,
+    // which does not belong to a host variable, is an error.
+    const std::string& hostvarName(const HostvarHandle& hostvar)
+    {
+        if (!hostvar)
+            throw FieldNotFound(hostvar.getName());
+        return hostvar.getName();
+    }
+}
+
 Statement::size_type Statement::execute()
 {
     log_trace("Statement::execute()");
@@ -83,11 +99,141 @@ Statement::size_type Statement::flush()
     return _stmt->flush();
 }
 
+void Statement::binaryParams(bool enable)
+{
+    _stmt->binaryParams(enable);
+}
+
+void Statement::binaryResults(bool enable)
+{
+    _stmt->binaryResults(enable);
+}
+
+void Statement::streamingCursor(bool enable)
+{
+    _stmt->streamingCursor(enable);
+}
+
 void IStatement::setUString(const std::string& col, const cxxtools::String& data)
 {
     setString(col, cxxtools::Utf8Codec::encode(data));
 }
 
+HostvarHandle IStatement::hostvar(const std::string& col)
+{
+    return HostvarHandle(col, HostvarHandle::nameIndex);
+}
+
+void IStatement::setNull(const HostvarHandle& hostvar)
+{
+    setNull(hostvarName(hostvar));
+}
+
+void IStatement::setBool(const HostvarHandle& hostvar, bool data)
+{
+    setBool(hostvarName(hostvar), data);
+}
+
+void IStatement::setShort(const HostvarHandle& hostvar, short data)
+{
+    setShort(hostvarName(hostvar), data);
+}
+
+void IStatement::setInt(const HostvarHandle& hostvar, int data)
+{
+    setInt(hostvarName(hostvar), data);
+}
+
+void IStatement::setLong(const HostvarHandle& hostvar, long data)
+{
+    setLong(hostvarName(hostvar), data);
+}
+
+void IStatement::setUnsignedShort(const HostvarHandle& hostvar, unsigned short data)
+{
+    setUnsignedShort(hostvarName(hostvar), data);
+}
+
+void IStatement::setUnsigned(const HostvarHandle& hostvar, unsigned data)
+{
+    setUnsigned(hostvarName(hostvar), data);
+}
+
+void IStatement::setUnsignedLong(const HostvarHandle& hostvar, unsigned long data)
+{
+    setUnsignedLong(hostvarName(hostvar), data);
+}
+
+void IStatement::setInt32(const HostvarHandle& hostvar, int32_t data)
+{
+    setInt32(hostvarName(hostvar), data);
+}
+
+void IStatement::setUnsigned32(const HostvarHandle& hostvar, uint32_t data)
+{
+    setUnsigned32(hostvarName(hostvar), data);
+}
+
+void IStatement::setInt64(const HostvarHandle& hostvar, int64_t data)
+{
+    setInt64(hostvarName(hostvar), data);
+}
+
+void IStatement::setUnsigned64(const HostvarHandle& hostvar, uint64_t data)
+{
+    setUnsigned64(hostvarName(hostvar), data);
+}
+
+void IStatement::setDecimal(const HostvarHandle& hostvar, const Decimal& data)
+{
+    setDecimal(hostvarName(hostvar), data);
+}
+
+void IStatement::setFloat(const HostvarHandle& hostvar, float data)
+{
+    setFloat(hostvarName(hostvar), data);
+}
+
+void IStatement::setDouble(const HostvarHandle& hostvar, double data)
+{
+    setDouble(hostvarName(hostvar), data);
+}
+
+void IStatement::setChar(const HostvarHandle& hostvar, char data)
+{
+    setChar(hostvarName(hostvar), data);
+}
+
+void IStatement::setString(const HostvarHandle& hostvar, const std::string& data)
+{
+    setString(hostvarName(hostvar), data);
+}
+
+void IStatement::setBlob(const HostvarHandle& hostvar, const Blob& data)
+{
+    setBlob(hostvarName(hostvar), data);
+}
+
+void IStatement::setDate(const HostvarHandle& hostvar, const Date& data)
+{
+    setDate(hostvarName(hostvar), data);
+}
+
+void IStatement::setTime(const HostvarHandle& hostvar, const Time& data)
+{
+    setTime(hostvarName(hostvar), data);
+}
+
+void IStatement::setDatetime(const HostvarHandle& hostvar, const Datetime& data)
+{
+    setDatetime(hostvarName(hostvar), data);
+}
+
+void IStatement::setUString(const HostvarHandle& hostvar, const cxxtools::String& data)
+{
+    setString(hostvar, cxxtools::Utf8Codec::encode(data));
+}
+
 void IStatement::maxNumDelay(unsigned /*n*/)
 {
 }
@@ -102,5 +248,17 @@ Statement::size_type IStatement::flush()
     return 0;
 }
 
+void IStatement::binaryParams(bool /*enable*/)
+{
+}
+
+void IStatement::binaryResults(bool /*enable*/)
+{
+}
+
+void IStatement::streamingCursor(bool /*enable*/)
+{
+}
+
 }
 
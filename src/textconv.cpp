@@ -0,0 +1,406 @@
+/*
+ * Copyright (C) 2005 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <tntdb/impl/textconv.h>
+#include <tntdb/date.h>
+#include <tntdb/time.h>
+#include <tntdb/datetime.h>
+#include <algorithm>
+#include <limits>
+#include <cstdio>
+#include <cstdlib>
+
+#if __cplusplus >= 201703L && defined(__has_include)
+#  if __has_include(<charconv>)
+#    include <charconv>
+#    define TNTDB_HAVE_CHARCONV
+#  endif
+#endif
+
+#if !defined(TNTDB_HAVE_CHARCONV) || !defined(__cpp_lib_to_chars)
+#  include <locale.h>
+#endif
+
+namespace tntdb
+{
+namespace textconv
+{
+namespace
+{
+    inline bool isSpace(char ch)
+    {
+        return ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r' || ch == '\f' || ch == '\v';
+    }
+
+    inline bool isDigit(char ch)
+    {
+        return ch >= '0' && ch <= '9';
+    }
+
+    // strips white space and a leading '+'; returns false if nothing is left
+    bool trim(const char*& begin, const char*& end)
+    {
+        while (begin != end && isSpace(*begin))
+            ++begin;
+        while (end != begin && isSpace(end[-1]))
+            --end;
+        if (begin != end && *begin == '+')
+        {
+            ++begin;
+            if (begin != end && *begin == '-')
+                return false;
+        }
+        return begin != end;
+    }
+
+    template <typename T>
+    bool parseInteger(const char* begin, const char* end, T& ret)
+    {
+        if (!trim(begin, end))
+            return false;
+
+#ifdef TNTDB_HAVE_CHARCONV
+        std::from_chars_result r = std::from_chars(begin, end, ret);
+        return r.ec == std::errc() && r.ptr == end;
+#else
+        bool negative = false;
+        if (*begin == '-')
+        {
+            if (!std::numeric_limits<T>::is_signed)
+                return false;
+            negative = true;
+            if (++begin == end)
+                return false;
+        }
+
+        unsigned long long max = negative
+            ? static_cast<unsigned long long>(-(std::numeric_limits<T>::min() + 1)) + 1
+            : static_cast<unsigned long long>(std::numeric_limits<T>::max());
+
+        unsigned long long value = 0;
+        for ( ; begin != end; ++begin)
+        {
+            if (!isDigit(*begin))
+                return false;
+            unsigned d = *begin - '0';
+            if (value > (max - d) / 10)
+                return false;
+            value = value * 10 + d;
+        }
+
+        ret = negative ? static_cast<T>(-static_cast<long long>(value - 1) - 1)
+                       : static_cast<T>(value);
+        return true;
+#endif
+    }
+
+#if !defined(TNTDB_HAVE_CHARCONV) || !defined(__cpp_lib_to_chars)
+    // strtod and snprintf use the decimal point of the locale. The "C"
+    // locale is set for the current thread while they are called, so that
+    // the text does not depend on the global locale.
+    class CLocale
+    {
+        locale_t _prev;
+
+        static locale_t get()
+        {
+            static locale_t loc = newlocale(LC_ALL_MASK, "C", static_cast<locale_t>(0));
+            return loc;
+        }
+
+    public:
+        CLocale()
+            : _prev(get() ? uselocale(get()) : static_cast<locale_t>(0))
+            { }
+
+        ~CLocale()
+        {
+            if (_prev)
+                uselocale(_prev);
+        }
+    };
+#endif
+
+    template <typename T>
+    bool parseFloat(const char* begin, const char* end, T& ret)
+    {
+        if (!trim(begin, end))
+            return false;
+
+#if defined(TNTDB_HAVE_CHARCONV) && defined(__cpp_lib_to_chars)
+        std::from_chars_result r = std::from_chars(begin, end, ret);
+        return r.ec == std::errc() && r.ptr == end;
+#else
+        // strtod needs a terminated string
+        char buf[64];
+        std::string s;
+        const char* str;
+        if (static_cast<std::size_t>(end - begin) < sizeof(buf))
+        {
+            std::copy(begin, end, buf);
+            buf[end - begin] = '\0';
+            str = buf;
+        }
+        else
+        {
+            s.assign(begin, end);
+            str = s.c_str();
+        }
+
+        CLocale locale;
+        char* e;
+        double value = std::strtod(str, &e);
+        if (e != str + (end - begin))
+            return false;
+        ret = static_cast<T>(value);
+        return true;
+#endif
+    }
+
+#if !defined(TNTDB_HAVE_CHARCONV) || !defined(__cpp_lib_to_chars)
+    // Formats the value with the fewest digits between minPrecision and
+    // maxPrecision, which read back to the same value.
+    template <typename T>
+    char* formatShortest(char* buf, T value, int minPrecision, int maxPrecision)
+    {
+        CLocale locale;
+        int n = 0;
+        for (int precision = minPrecision; precision <= maxPrecision; ++precision)
+        {
+            n = std::snprintf(buf, maxFloatLength, "%.*g", precision, static_cast<double>(value));
+            if (static_cast<T>(std::strtod(buf, 0)) == value)
+                break;
+        }
+        return buf + n;
+    }
+#endif
+
+    inline char* format2(char* buf, unsigned short n)
+    {
+        buf[0] = static_cast<char>('0' + n / 10 % 10);
+        buf[1] = static_cast<char>('0' + n % 10);
+        return buf + 2;
+    }
+
+    inline char* format3(char* buf, unsigned short n)
+    {
+        buf[0] = static_cast<char>('0' + n / 100 % 10);
+        return format2(buf + 1, n % 100);
+    }
+
+    inline char* format4(char* buf, unsigned short n)
+    {
+        buf[0] = static_cast<char>('0' + n / 1000 % 10);
+        return format3(buf + 1, n % 1000);
+    }
+
+    inline bool getNumber(const char* s, unsigned digits, unsigned short& ret)
+    {
+        ret = 0;
+        for (unsigned n = 0; n < digits; ++n)
+        {
+            if (!isDigit(s[n]))
+                return false;
+            ret = ret * 10 + (s[n] - '0');
+        }
+        return true;
+    }
+}
+
+bool parse(const char* begin, const char* end, short& ret)              { return parseInteger(begin, end, ret); }
+bool parse(const char* begin, const char* end, int& ret)                { return parseInteger(begin, end, ret); }
+bool parse(const char* begin, const char* end, long& ret)               { return parseInteger(begin, end, ret); }
+bool parse(const char* begin, const char* end, long long& ret)          { return parseInteger(begin, end, ret); }
+bool parse(const char* begin, const char* end, unsigned short& ret)     { return parseInteger(begin, end, ret); }
+bool parse(const char* begin, const char* end, unsigned& ret)           { return parseInteger(begin, end, ret); }
+bool parse(const char* begin, const char* end, unsigned long& ret)      { return parseInteger(begin, end, ret); }
+bool parse(const char* begin, const char* end, unsigned long long& ret) { return parseInteger(begin, end, ret); }
+bool parse(const char* begin, const char* end, float& ret)              { return parseFloat(begin, end, ret); }
+bool parse(const char* begin, const char* end, double& ret)             { return parseFloat(begin, end, ret); }
+
+char* format(char* buf, long long value)
+{
+#ifdef TNTDB_HAVE_CHARCONV
+    return std::to_chars(buf, buf + maxIntegerLength, value).ptr;
+#else
+    if (value < 0)
+    {
+        *buf = '-';
+        return format(buf + 1, static_cast<unsigned long long>(-(value + 1)) + 1);
+    }
+    return format(buf, static_cast<unsigned long long>(value));
+#endif
+}
+
+char* format(char* buf, unsigned long long value)
+{
+#ifdef TNTDB_HAVE_CHARCONV
+    return std::to_chars(buf, buf + maxIntegerLength, value).ptr;
+#else
+    char tmp[maxIntegerLength];
+    char* p = tmp + maxIntegerLength;
+    do
+    {
+        *--p = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+    return std::copy(p, tmp + maxIntegerLength, buf);
+#endif
+}
+
+char* format(char* buf, float value)
+{
+#if defined(TNTDB_HAVE_CHARCONV) && defined(__cpp_lib_to_chars)
+    return std::to_chars(buf, buf + maxFloatLength, value).ptr;
+#else
+    return formatShortest(buf, value, 6, 9);
+#endif
+}
+
+char* format(char* buf, double value)
+{
+#if defined(TNTDB_HAVE_CHARCONV) && defined(__cpp_lib_to_chars)
+    return std::to_chars(buf, buf + maxFloatLength, value).ptr;
+#else
+    return formatShortest(buf, value, 15, 17);
+#endif
+}
+
+const char* scanNumber(const char* begin, const char* end, unsigned short& ret)
+{
+    const char* p = begin;
+    ret = 0;
+    while (p != end && isDigit(*p) && p - begin < 4)
+        ret = ret * 10 + (*p++ - '0');
+    return p == begin ? 0 : p;
+}
+
+const char* scanIsoDate(const char* begin, const char* end, Date& ret)
+{
+    // YYYY-MM-DD
+    // 0....+....1
+    unsigned short year, month, day;
+    if (end - begin < 10
+      || begin[4] != '-'
+      || begin[7] != '-'
+      || !getNumber(begin, 4, year)
+      || !getNumber(begin + 5, 2, month)
+      || !getNumber(begin + 8, 2, day))
+        return 0;
+
+    ret.set(year, month, day);
+    return begin + 10;
+}
+
+const char* scanIsoTime(const char* begin, const char* end, Time& ret)
+{
+    // hh:mm:ss[.fff...]
+    // 0....+....1
+    unsigned short hour, minute, second;
+    if (end - begin < 8
+      || begin[2] != ':'
+      || begin[5] != ':'
+      || !getNumber(begin, 2, hour)
+      || !getNumber(begin + 3, 2, minute)
+      || !getNumber(begin + 6, 2, second))
+        return 0;
+
+    const char* p = begin + 8;
+    unsigned short millis = 0;
+    if (p != end && *p == '.')
+    {
+        ++p;
+        const char* f = p;
+        while (p != end && isDigit(*p))
+        {
+            if (p - f < 3)
+                millis = millis * 10 + (*p - '0');
+            else if (p - f == 3 && *p >= '5' && millis < 999)
+                ++millis;
+            ++p;
+        }
+
+        if (p == f)
+            return 0;
+
+        for (long n = p - f; n < 3; ++n)
+            millis *= 10;
+    }
+
+    ret.set(hour, minute, second, millis);
+    return p;
+}
+
+const char* scanIsoDatetime(const char* begin, const char* end, Datetime& ret)
+{
+    Date date;
+    Time time;
+    const char* p = scanIsoDate(begin, end, date);
+    if (p == 0 || p == end || (*p != ' ' && *p != 'T'))
+        return 0;
+
+    p = scanIsoTime(p + 1, end, time);
+    if (p == 0)
+        return 0;
+
+    ret = Datetime(date, time);
+    return p;
+}
+
+char* formatIso(char* buf, const Date& value)
+{
+    // YYYY-MM-DD
+    buf = format4(buf, value.getYear());
+    *buf++ = '-';
+    buf = format2(buf, value.getMonth());
+    *buf++ = '-';
+    return format2(buf, value.getDay());
+}
+
+char* formatIso(char* buf, const Time& value)
+{
+    // hh:mm:ss.sss
+    buf = format2(buf, value.getHour());
+    *buf++ = ':';
+    buf = format2(buf, value.getMinute());
+    *buf++ = ':';
+    buf = format2(buf, value.getSecond());
+    *buf++ = '.';
+    return format3(buf, value.getMillis());
+}
+
+char* formatIso(char* buf, const Datetime& value)
+{
+    // YYYY-MM-DD hh:mm:ss.sss
+    buf = formatIso(buf, value.getDate());
+    *buf++ = ' ';
+    return formatIso(buf, value.getTime());
+}
+
+}
+}
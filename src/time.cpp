@@ -27,8 +27,8 @@
  */
 
 #include <tntdb/time.h>
+#include <tntdb/impl/textconv.h>
 #include <tntdb/error.h>
-#include <cctype>
 #include <sys/time.h>
 #include <time.h>
 
@@ -62,79 +62,18 @@ namespace tntdb
 
   std::string Time::getIso() const
   {
-    // format hh:mm:ss.sss
-    //        0....+....1....+
-    char ret[14];
-    ret[0] = '0' + _hour / 10;
-    ret[1] = '0' + _hour % 10;
-    ret[2] = ':';
-    ret[3] = '0' + _minute / 10;
-    ret[4] = '0' + _minute % 10;
-    ret[5] = ':';
-    ret[6] = '0' + _second / 10;
-    ret[7] = '0' + _second % 10;
-    ret[8] = '.';
-    unsigned short n = _millis;
-    ret[11] = '0' + n % 10;
-    n /= 10;
-    ret[10] = '0' + n % 10;
-    n /= 10;
-    ret[9] = '0' + n % 10;
-
-    return std::string(ret, 12);
-  }
-
-  inline unsigned short getNumber2(const char* s)
-  {
-    if (!std::isdigit(s[0])
-      || !std::isdigit(s[1]))
-      throw TypeError();
-
-    return (s[0] - '0') * 10
-         + (s[1] - '0');
-  }
-
-  inline unsigned short getNumber3(const char* s)
-  {
-    if (!std::isdigit(s[0])
-      || !std::isdigit(s[1])
-      || !std::isdigit(s[2]))
-      throw TypeError();
-
-    return (s[0] - '0') * 100
-         + (s[1] - '0') * 10
-         + (s[2] - '0');
+    char ret[12];
+    return std::string(ret, textconv::formatIso(ret, *this));
   }
 
   Time Time::fromIso(const std::string& s)
   {
     Time ret;
-    const char* d = s.data();
-    try
-    {
-      if (s.size() == 12
-        && d[2] == ':'
-        && d[5] == ':'
-        && d[8] == '.')
-      {
-        ret.set(getNumber2(d), getNumber2(d + 3), getNumber2(d + 6),
-                getNumber3(d + 9));
-      }
-      else if (s.size() == 8
-        && d[2] == ':'
-        && d[5] == ':')
-      {
-        ret.set(getNumber2(d), getNumber2(d + 3), getNumber2(d + 6));
-      }
-      else
-        throw TypeError();
-    }
-    catch (const TypeError&)
-    {
+    const char* end = s.data() + s.size();
+    if (textconv::scanIsoTime(s.data(), end, ret) != end)
       throw TypeError("failed to convert string \"" + s + "\" into time");
-    }
-
     return ret;
   }
+
 }
 
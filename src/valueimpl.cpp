@@ -27,6 +27,7 @@
  */
 
 #include <tntdb/impl/value.h>
+#include <tntdb/impl/textconv.h>
 #include <tntdb/date.h>
 #include <tntdb/time.h>
 #include <tntdb/datetime.h>
@@ -34,7 +35,6 @@
 #include <tntdb/blob.h>
 #include <tntdb/error.h>
 #include <sstream>
-#include <cxxtools/convert.h>
 #include <cxxtools/utf8codec.h>
 
 namespace
@@ -47,16 +47,14 @@ bool isTrue(char ch)
 template <typename T>
 T getValue(const std::string& s, const char* tname)
 {
-    try
-    {
-            return cxxtools::convert<T>(s);
-    }
-    catch (const cxxtools::ConversionError&)
+    T ret;
+    if (!tntdb::textconv::parse(s.data(), s.data() + s.size(), ret))
     {
         std::ostringstream msg;
         msg << "can't convert \"" << s << "\" to " << tname;
         throw tntdb::TypeError(msg.str());
     }
+    return ret;
 }
 
 }
@@ -150,7 +148,7 @@ Decimal ValueImpl::getDecimal() const
 {
     if (null)
         throw NullValue();
-    return getValue<Decimal>(data, "Decimal");
+    return Decimal(data);
 }
 
 float ValueImpl::getFloat() const
@@ -188,6 +186,20 @@ void ValueImpl::getBlob(Blob& ret) const
     ret.assign(data.data(), data.size());
 }
 
+bool ValueImpl::getStringView(const char*& d, std::size_t& length) const
+{
+    if (null)
+        throw NullValue();
+    d = data.data();
+    length = data.size();
+    return true;
+}
+
+bool ValueImpl::getBlobView(const char*& d, std::size_t& length) const
+{
+    return getStringView(d, length);
+}
+
 Date ValueImpl::getDate() const
 {
     if (null)
@@ -216,4 +228,14 @@ void IValue::getUString(cxxtools::String& ret) const
     ret = cxxtools::Utf8Codec::decode(r);
 }
 
+bool IValue::getStringView(const char*& /* data */, std::size_t& /* length */) const
+{
+    return false;
+}
+
+bool IValue::getBlobView(const char*& /* data */, std::size_t& /* length */) const
+{
+    return false;
+}
+
 }
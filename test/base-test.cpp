@@ -31,13 +31,33 @@
 #include <cxxtools/unit/registertest.h>
 #include <cxxtools/log.h>
 #include <stdlib.h>
+#include <limits>
 #include <tntdb/transaction.h>
 #include <tntdb/statement.h>
+#include <tntdb/preparedstatement.h>
+#include <tntdb/error.h>
 #include <tntdb/row.h>
+#include <tntdb/binding.h>
 #include <tntdb/value.h>
 
 log_define("tntdb.unit.base")
 
+namespace
+{
+    struct BoundRecord
+    {
+        int intval;
+        long longval;
+        std::string str;
+    };
+}
+
+TNTDB_BINDING_BEGIN(BoundRecord)
+    TNTDB_BINDING_COLUMN("intcol", intval)
+    TNTDB_BINDING_COLUMN("longcol", longval)
+    TNTDB_BINDING_COLUMN("stringcol", str)
+TNTDB_BINDING_END
+
 class TntdbBaseTest : public TntdbTestBase
 {
 
@@ -47,16 +67,25 @@ public:
     {
         registerMethod("testSelectValue", *this, &TntdbBaseTest::testSelectValue);
         registerMethod("testSelectRow", *this, &TntdbBaseTest::testSelectRow);
+        registerMethod("testStringView", *this, &TntdbBaseTest::testStringView);
         registerMethod("testRowreader", *this, &TntdbBaseTest::testRowreader);
         registerMethod("testSelectResult", *this, &TntdbBaseTest::testSelectResult);
+        registerMethod("testResultOutOfRange", *this, &TntdbBaseTest::testResultOutOfRange);
         registerMethod("testStmtSelectValue", *this, &TntdbBaseTest::testStmtSelectValue);
         registerMethod("testStmtSelectRow", *this, &TntdbBaseTest::testStmtSelectRow);
         registerMethod("testStmtSelectResult", *this, &TntdbBaseTest::testStmtSelectResult);
         registerMethod("testStmtSelectCursor", *this, &TntdbBaseTest::testStmtSelectCursor);
+        registerMethod("testRealText", *this, &TntdbBaseTest::testRealText);
+        registerMethod("testStmtSelectTypedRows", *this, &TntdbBaseTest::testStmtSelectTypedRows);
         registerMethod("testExecPlaceholder", *this, &TntdbBaseTest::testExecPlaceholder);
+        registerMethod("testMixedTypes", *this, &TntdbBaseTest::testMixedTypes);
+        registerMethod("testBinaryParams", *this, &TntdbBaseTest::testBinaryParams);
         registerMethod("testSelectPlaceholder", *this, &TntdbBaseTest::testSelectPlaceholder);
         registerMethod("testSelectMultiplePlaceholder", *this, &TntdbBaseTest::testSelectMultiplePlaceholder);
         registerMethod("testSelectCursorPlaceholder", *this, &TntdbBaseTest::testSelectCursorPlaceholder);
+        registerMethod("testPreparedStatement", *this, &TntdbBaseTest::testPreparedStatement);
+        registerMethod("testBinding", *this, &TntdbBaseTest::testBinding);
+        registerMethod("testBindingRepeated", *this, &TntdbBaseTest::testBindingRepeated);
         registerMethod("testTransaction", *this, &TntdbBaseTest::testTransaction);
         registerMethod("testLimit", *this, &TntdbBaseTest::testLimit);
         registerMethod("testLimitOffset", *this, &TntdbBaseTest::testLimitOffset);
@@ -101,6 +130,26 @@ public:
         CXXTOOLS_UNIT_ASSERT_EQUALS(longVal, 6);
     }
 
+    void testStringView()
+    {
+        conn.execute("insert into tntdbtest(intcol, stringcol) values(4, 'hello')");
+
+        tntdb::Row r = conn.selectRow("select stringcol, intcol from tntdbtest");
+
+        // the view is valid only as long as the value is
+        tntdb::Value v0 = r[0];
+        tntdb::Value v1 = r[1];
+        std::string buffer;
+        const char* data;
+        std::size_t length;
+
+        v0.getStringView(data, length, buffer);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(std::string(data, length), "hello");
+
+        v1.getStringView(data, length, buffer);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(std::string(data, length), "4");
+    }
+
     void testRowreader()
     {
         conn.execute("insert into tntdbtest(intcol, shortcol, longcol) values(4, 5, 6)");
@@ -172,6 +221,22 @@ public:
 
     }
 
+    void testResultOutOfRange()
+    {
+        // the mysql driver seeks to the row, when it is accessed
+        if (dburl.compare(0, 6, "mysql:") != 0)
+            return;
+
+        tntdb::Result empty = conn.select("select intcol from tntdbtest");
+        CXXTOOLS_UNIT_ASSERT_EQUALS(empty.size(), 0);
+        CXXTOOLS_UNIT_ASSERT_THROW(empty.getRow(0), tntdb::NotFound);
+
+        conn.execute("insert into tntdbtest(intcol) values(4)");
+        tntdb::Result r = conn.select("select intcol from tntdbtest");
+        CXXTOOLS_UNIT_ASSERT_THROW(r.getRow(1), tntdb::NotFound);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(r.getRow(0).getInt(0), 4);
+    }
+
     void testStmtSelectValue()
     {
         conn.execute("insert into tntdbtest(intcol) values(4)");
@@ -286,6 +351,48 @@ public:
         }
     }
 
+    void testRealText()
+    {
+        conn.execute("insert into tntdbtest(intcol, doublecol) values(1, 1.0)");
+        conn.execute("insert into tntdbtest(intcol, doublecol) values(2, 0.1)");
+        conn.execute("insert into tntdbtest(intcol, doublecol) values(3, 2.5)");
+
+        // results and cursors return the same text
+        tntdb::Statement sel = conn.prepare("select doublecol from tntdbtest order by intcol");
+        tntdb::Result result = sel.select();
+
+        unsigned n = 0;
+        for (tntdb::Statement::const_iterator cur = sel.begin(); cur != sel.end(); ++cur, ++n)
+        {
+            CXXTOOLS_UNIT_ASSERT(n < result.size());
+            CXXTOOLS_UNIT_ASSERT_EQUALS(result[n][0].getString(), (*cur)[0].getString());
+            CXXTOOLS_UNIT_ASSERT_EQUALS(result[n][0].getDouble(), (*cur)[0].getDouble());
+        }
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(n, 3u);
+    }
+
+    void testStmtSelectTypedRows()
+    {
+        conn.execute("insert into tntdbtest(intcol, shortcol, longcol) values(4, 5, 6)");
+        conn.execute("insert into tntdbtest(intcol, shortcol, longcol) values(3, 4, 5)");
+
+        tntdb::Statement stmt = conn.prepare("select intcol, shortcol, longcol, unsignedshortcol from tntdbtest order by intcol");
+
+        unsigned rowcount = 0;
+        typedef tntdb::TypedRows<int, short, long, unsigned short> Rows;
+        Rows rows = stmt.rows<int, short, long, unsigned short>();
+        for (Rows::const_iterator it = rows.begin(); it != rows.end(); ++it, ++rowcount)
+        {
+            CXXTOOLS_UNIT_ASSERT_EQUALS(static_cast<unsigned>(std::get<0>(*it)), rowcount + 3);
+            CXXTOOLS_UNIT_ASSERT_EQUALS(static_cast<unsigned>(std::get<1>(*it)), rowcount + 4);
+            CXXTOOLS_UNIT_ASSERT_EQUALS(static_cast<unsigned>(std::get<2>(*it)), rowcount + 5);
+            CXXTOOLS_UNIT_ASSERT_EQUALS(std::get<3>(*it), 0);
+        }
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(rowcount, 2);
+    }
+
     void testExecPlaceholder()
     {
         tntdb::Statement ins = conn.prepare("insert into tntdbtest(intcol) values(:intcol)");
@@ -299,6 +406,44 @@ public:
         CXXTOOLS_UNIT_ASSERT_EQUALS(maxVal, 5);
     }
 
+    void testMixedTypes()
+    {
+        // the placeholders are bound with values of different types
+        tntdb::Statement ins = conn.prepare("insert into tntdbtest(intcol, stringcol) values(:i, :s)");
+        ins.set("i", true).set("s", 42).execute();
+        ins.set("i", 5).set("s", "text").execute();
+        ins.set("i", false).set("s", 43).execute();
+        ins.set("i", 6).set("s", "more").execute();
+
+        tntdb::Statement sel = conn.prepare("select count(*) from tntdbtest where intcol = :i");
+        CXXTOOLS_UNIT_ASSERT_EQUALS(sel.set("i", true).selectValue().getInt(), 1);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(sel.set("i", 5).selectValue().getInt(), 1);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(sel.set("i", false).selectValue().getInt(), 1);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(sel.set("i", 6).selectValue().getInt(), 1);
+
+        tntdb::Statement selStr = conn.prepare("select count(*) from tntdbtest where stringcol = :s");
+        CXXTOOLS_UNIT_ASSERT_EQUALS(selStr.set("s", 42).selectValue().getInt(), 1);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(selStr.set("s", "text").selectValue().getInt(), 1);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(selStr.set("s", 43).selectValue().getInt(), 1);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(selStr.set("s", "more").selectValue().getInt(), 1);
+    }
+
+    void testBinaryParams()
+    {
+        conn.execute("insert into tntdbtest(intcol) values(5)");
+
+        tntdb::Statement sel = conn.prepare("select count(*) from tntdbtest where intcol = :i");
+        sel.binaryParams(true);
+
+        // the statement is prepared again, when the types change
+        for (unsigned n = 0; n < 2; ++n)
+        {
+            CXXTOOLS_UNIT_ASSERT_EQUALS(sel.set("i", 5).selectValue().getInt(), 1);
+            CXXTOOLS_UNIT_ASSERT_EQUALS(sel.set("i", 5.0).selectValue().getInt(), 1);
+            CXXTOOLS_UNIT_ASSERT_EQUALS(sel.set("i", std::numeric_limits<unsigned long>::max()).selectValue().getInt(), 0);
+        }
+    }
+
     void testSelectPlaceholder()
     {
         conn.execute("insert into tntdbtest(intcol, shortcol, longcol) values(4, 5, 6)");
@@ -321,6 +466,69 @@ public:
         CXXTOOLS_UNIT_ASSERT_EQUALS(count, 2);
     }
 
+    void testPreparedStatement()
+    {
+        tntdb::PreparedStatement<int, short, long> ins(conn,
+            "insert into tntdbtest(intcol, shortcol, longcol) values(:intcol, :shortcol, :longcol)");
+        ins.execute(4, 5, 6);
+        ins.execute(3, 4, 5);
+
+        tntdb::PreparedStatement<int> sel(conn,
+            "select count(*) from tntdbtest where intcol = :value or shortcol = :value");
+        CXXTOOLS_UNIT_ASSERT_EQUALS(sel.size(), 1);
+
+        unsigned count = 0;
+        sel.selectValue(4).get(count);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(count, 2);
+
+        typedef tntdb::PreparedStatement<int, int> Sel2;
+        CXXTOOLS_UNIT_ASSERT_THROW(Sel2(conn, "select count(*) from tntdbtest where intcol = :value"), tntdb::SqlError);
+    }
+
+    void testBinding()
+    {
+        BoundRecord rec;
+        rec.intval = 4;
+        rec.longval = 6;
+        rec.str = "hello";
+
+        tntdb::Statement ins = conn.prepare(
+            "insert into tntdbtest(intcol, longcol, stringcol) values(:intcol, :longcol, :stringcol)");
+        ins.execute(rec);
+
+        BoundRecord rec2;
+        conn.selectRow("select intcol, stringcol, longcol from tntdbtest") >>= rec2;
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(rec2.intval, 4);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(rec2.longval, 6);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(rec2.str, "hello");
+    }
+
+    void testBindingRepeated()
+    {
+        // longcol has no host variable and is skipped on every execution
+        tntdb::Statement ins = conn.prepare(
+            "insert into tntdbtest(intcol, stringcol) values(:intcol, :stringcol)");
+
+        BoundRecord rec;
+        rec.longval = 6;
+        for (int n = 1; n <= 3; ++n)
+        {
+            rec.intval = n;
+            rec.str = "rec" + cxxtools::convert<std::string>(n);
+            ins.execute(rec);
+        }
+
+        tntdb::Result r = conn.select("select intcol, stringcol from tntdbtest order by intcol");
+        CXXTOOLS_UNIT_ASSERT_EQUALS(r.size(), 3);
+        for (unsigned n = 0; n < r.size(); ++n)
+        {
+            CXXTOOLS_UNIT_ASSERT_EQUALS(r.getRow(n).getInt(0), static_cast<int>(n + 1));
+            CXXTOOLS_UNIT_ASSERT_EQUALS(r.getRow(n).getString(1),
+                "rec" + cxxtools::convert<std::string>(n + 1));
+        }
+    }
+
     void testSelectCursorPlaceholder()
     {
         conn.execute("insert into tntdbtest(intcol, shortcol, longcol) values(5, 6, 7)");
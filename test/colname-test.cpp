@@ -33,6 +33,8 @@
 #include <stdlib.h>
 #include <tntdb/statement.h>
 #include <tntdb/row.h>
+#include <tntdb/result.h>
+#include <tntdb/error.h>
 #include <limits>
 
 log_define("tntdb.unit.colname")
@@ -44,6 +46,8 @@ public:
       : TntdbTestBase("colname")
     {
         registerMethod("testColname", *this, &TntdbColnameTest::testColname);
+        registerMethod("testColumnIndex", *this, &TntdbColnameTest::testColumnIndex);
+        registerMethod("testColumnIndexCase", *this, &TntdbColnameTest::testColumnIndexCase);
     }
 
     void testColname()
@@ -56,6 +60,52 @@ public:
         CXXTOOLS_UNIT_ASSERT_EQUALS(row.getName(1), "foo");
     }
 
+    void testColumnIndex()
+    {
+        conn.execute("insert into tntdbtest(intcol) values(4718)");
+        conn.execute("insert into tntdbtest(intcol) values(4719)");
+
+        tntdb::Statement stmt = conn.prepare("select intcol, intcol + 1 as foo from tntdbtest order by intcol");
+
+        unsigned count = 0;
+        for (tntdb::Statement::const_iterator it = stmt.begin(); it != stmt.end(); ++it, ++count)
+        {
+            tntdb::Row row = *it;
+            CXXTOOLS_UNIT_ASSERT_EQUALS(row.getColumnIndex("intcol"), 0);
+            CXXTOOLS_UNIT_ASSERT_EQUALS(row.getColumnIndex("foo"), 1);
+            CXXTOOLS_UNIT_ASSERT_EQUALS(row.getInt("foo"), row.getInt("intcol") + 1);
+            CXXTOOLS_UNIT_ASSERT_THROW(row.getColumnIndex("bar"), tntdb::FieldNotFound);
+        }
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(count, 2);
+
+        tntdb::Result result = stmt.select();
+        CXXTOOLS_UNIT_ASSERT_EQUALS(result.getRow(1).getColumnIndex("foo"), 1);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(result.getRow(1).getInt("foo"), 4720);
+    }
+
+    void testColumnIndexCase()
+    {
+        // oracle reports unquoted names in upper case but finds them in any case
+        if (dburl.compare(0, 7, "oracle:") != 0)
+            return;
+
+        conn.execute("insert into tntdbtest(intcol) values(4718)");
+
+        tntdb::Row row = conn.selectRow("select intcol from tntdbtest");
+        CXXTOOLS_UNIT_ASSERT_EQUALS(row.getName(0), "INTCOL");
+        CXXTOOLS_UNIT_ASSERT_EQUALS(row.getColumnIndex("intcol"), 0);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(row.getInt("intcol"), 4718);
+
+        tntdb::Statement stmt = conn.prepare("select intcol from tntdbtest");
+        for (tntdb::Statement::const_iterator it = stmt.begin(); it != stmt.end(); ++it)
+        {
+            CXXTOOLS_UNIT_ASSERT_EQUALS(it->getColumnIndex("intcol"), 0);
+            CXXTOOLS_UNIT_ASSERT_EQUALS(it->getColumnIndex("IntCol"), 0);
+            CXXTOOLS_UNIT_ASSERT_THROW(it->getColumnIndex("bar"), tntdb::FieldNotFound);
+        }
+    }
+
 };
 
 cxxtools::unit::RegisterTest<TntdbColnameTest> register_TntdbColnameTest;
@@ -72,6 +72,8 @@ public:
         registerMethod("testInt", *this, &TntdbDecimalTest::testInt);
         registerMethod("testIntExp", *this, &TntdbDecimalTest::testIntExp);
         registerMethod("testCompare", *this, &TntdbDecimalTest::testCompare);
+        registerMethod("testArithmetic", *this, &TntdbDecimalTest::testArithmetic);
+        registerMethod("testLarge", *this, &TntdbDecimalTest::testLarge);
     }
 
     void testDouble()
@@ -296,6 +298,43 @@ public:
         CXXTOOLS_UNIT_ASSERT(d1 >= d2);
     }
 
+
+    void testArithmetic()
+    {
+        CXXTOOLS_UNIT_ASSERT(tntdb::Decimal("0.1") + tntdb::Decimal("0.2") == tntdb::Decimal("0.3"));
+        CXXTOOLS_UNIT_ASSERT_EQUALS((tntdb::Decimal("1.5") - tntdb::Decimal("2.75")).toString(), "-1.25");
+        CXXTOOLS_UNIT_ASSERT_EQUALS((tntdb::Decimal("-1.5") * tntdb::Decimal("2.4")).toString(), "-3.6");
+        CXXTOOLS_UNIT_ASSERT((tntdb::Decimal(7) - tntdb::Decimal(7)).isZero());
+        CXXTOOLS_UNIT_ASSERT((tntdb::Decimal::infinity() + -tntdb::Decimal::infinity()).isNaN());
+        CXXTOOLS_UNIT_ASSERT((tntdb::Decimal::infinity() * tntdb::Decimal(-2)).isNegativeInfinity());
+
+        tntdb::Decimal sum;
+        for (unsigned n = 0; n < 1000; ++n)
+            sum += tntdb::Decimal("0.01");
+        CXXTOOLS_UNIT_ASSERT(sum == tntdb::Decimal(10));
+    }
+
+    void testLarge()
+    {
+        // values, which do not fit into the fixed size coefficient
+        tntdb::Decimal d("123456789012345678901234567890123456789012345");
+        CXXTOOLS_UNIT_ASSERT_EQUALS(d.toStringFix(), "123456789012345678901234567890123456789012345");
+        CXXTOOLS_UNIT_ASSERT_EQUALS(d.exponent(), 45);
+
+        d += tntdb::Decimal(1);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(d.toStringFix(), "123456789012345678901234567890123456789012346");
+        CXXTOOLS_UNIT_ASSERT(d > tntdb::Decimal("123456789012345678901234567890123456789012345"));
+
+        d = tntdb::Decimal("12345678901234567890") * tntdb::Decimal("98765432109876543210");
+        CXXTOOLS_UNIT_ASSERT_EQUALS(d.toStringFix(), "1219326311370217952237463801111263526900");
+
+        d = tntdb::Decimal("1e30") + tntdb::Decimal("1e-30");
+        CXXTOOLS_UNIT_ASSERT_EQUALS(d.toStringFix(), "1000000000000000000000000000000.000000000000000000000000000001");
+
+        d -= tntdb::Decimal("1e-30");
+        CXXTOOLS_UNIT_ASSERT(d == tntdb::Decimal("1e30"));
+    }
+
 };
 
 cxxtools::unit::RegisterTest<TntdbDecimalTest> register_TntdbDecimalTest;
@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2005 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#include "testbase.h"
+#include <cxxtools/unit/registertest.h>
+#include <tntdb/transaction.h>
+#include <tntdb/statement.h>
+#include <tntdb/value.h>
+#include <tntdb/error.h>
+
+class TntdbDelayTest : public TntdbTestBase
+{
+    int count()
+    {
+        return conn.selectValue("select count(*) from tntdbtest").getInt();
+    }
+
+public:
+    TntdbDelayTest()
+      : TntdbTestBase("delay")
+    {
+        registerMethod("testDelayedInsert", *this, &TntdbDelayTest::testDelayedInsert);
+        registerMethod("testFlushCountsStatement", *this, &TntdbDelayTest::testFlushCountsStatement);
+        registerMethod("testTrailingComment", *this, &TntdbDelayTest::testTrailingComment);
+        registerMethod("testDelayedError", *this, &TntdbDelayTest::testDelayedError);
+        registerMethod("testManyDelayed", *this, &TntdbDelayTest::testManyDelayed);
+    }
+
+    void testDelayedInsert()
+    {
+        tntdb::Transaction trans(conn);
+        tntdb::Statement ins = conn.prepare("insert into tntdbtest(intcol) values(:v)");
+        ins.maxNumDelay(100);
+
+        for (int n = 0; n < 3; ++n)
+            ins.set("v", n).execute();
+
+        // drivers without delayed execution execute immediately
+        if (ins.numDelayed() == 0)
+            return;
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(ins.numDelayed(), 3u);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(ins.flush(), 3u);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(ins.numDelayed(), 0u);
+        trans.commit();
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(count(), 3);
+    }
+
+    void testFlushCountsStatement()
+    {
+        tntdb::Transaction trans(conn);
+        tntdb::Statement ins = conn.prepare("insert into tntdbtest(intcol) values(:v)");
+        tntdb::Statement upd = conn.prepare("update tntdbtest set longcol = :l where intcol = :v");
+        ins.maxNumDelay(100);
+        upd.maxNumDelay(100);
+
+        ins.set("v", 1).execute();
+        ins.set("v", 2).execute();
+        upd.set("l", 7).set("v", 1).execute();
+
+        if (ins.numDelayed() == 0)
+            return;
+
+        // each statement returns the rows affected by its own executes
+        CXXTOOLS_UNIT_ASSERT_EQUALS(ins.flush(), 2u);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(upd.flush(), 1u);
+        trans.commit();
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(count(), 2);
+    }
+
+    void testTrailingComment()
+    {
+        tntdb::Transaction trans(conn);
+        tntdb::Statement ins = conn.prepare(
+            "insert into tntdbtest(intcol) /* column */ values(:v); -- trailing comment");
+        ins.maxNumDelay(100);
+
+        for (int n = 0; n < 3; ++n)
+            ins.set("v", n).execute();
+
+        unsigned delayed = ins.numDelayed();
+        CXXTOOLS_UNIT_ASSERT_EQUALS(ins.flush(), delayed);
+        trans.commit();
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(count(), 3);
+    }
+
+    void testDelayedError()
+    {
+        tntdb::Transaction trans(conn);
+        tntdb::Statement ins = conn.prepare("insert into tntdbtest(id, intcol) values(:id, :v)");
+        ins.maxNumDelay(100);
+
+        ins.set("id", 1).set("v", 1).execute();
+        if (ins.numDelayed() == 0)
+            return;
+
+        // duplicate primary key
+        ins.set("id", 1).set("v", 2).execute();
+        CXXTOOLS_UNIT_ASSERT_THROW(ins.flush(), tntdb::Error);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(ins.numDelayed(), 0u);
+        trans.rollback();
+
+        // the connection is usable after the error
+        CXXTOOLS_UNIT_ASSERT_EQUALS(count(), 0);
+        ins.set("id", 1).set("v", 1).execute();
+        CXXTOOLS_UNIT_ASSERT_EQUALS(count(), 1);
+    }
+
+    void testManyDelayed()
+    {
+        // more executes than the drivers queue before reading results
+        tntdb::Transaction trans(conn);
+        tntdb::Statement ins = conn.prepare("insert into tntdbtest(intcol) values(:v)");
+        ins.maxNumDelay(10000);
+
+        for (int n = 0; n < 2500; ++n)
+            ins.set("v", n).execute();
+
+        unsigned delayed = ins.numDelayed();
+        unsigned count = ins.flush();
+        trans.commit();
+
+        if (delayed > 0)
+            CXXTOOLS_UNIT_ASSERT_EQUALS(count, 2500u);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(this->count(), 2500);
+    }
+};
+
+cxxtools::unit::RegisterTest<TntdbDelayTest> register_TntdbDelayTest;
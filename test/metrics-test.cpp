@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2005 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <cxxtools/unit/testsuite.h>
+#include <cxxtools/unit/registertest.h>
+#include <tntdb/metrics.h>
+
+class MetricsTest : public cxxtools::unit::TestSuite
+{
+public:
+    MetricsTest()
+        : cxxtools::unit::TestSuite("metrics")
+    {
+        registerMethod("testBuckets", *this, &MetricsTest::testBuckets);
+        registerMethod("testQuantile", *this, &MetricsTest::testQuantile);
+    }
+
+    void testBuckets()
+    {
+        tntdb::LatencyHistogram h;
+        h.add(std::chrono::microseconds(0));
+        h.add(std::chrono::microseconds(1));
+        h.add(std::chrono::microseconds(3));
+        h.add(std::chrono::milliseconds(1));
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(h.count(0), 1u);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(h.count(1), 1u);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(h.count(2), 1u);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(h.count(10), 1u);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(h.count(), 4u);
+        CXXTOOLS_UNIT_ASSERT(h.sum() == std::chrono::microseconds(1004));
+        CXXTOOLS_UNIT_ASSERT(h.average() == std::chrono::microseconds(251));
+    }
+
+    void testQuantile()
+    {
+        tntdb::LatencyHistogram h;
+        CXXTOOLS_UNIT_ASSERT(h.quantile(0.5) == std::chrono::microseconds(0));
+
+        // one duration in each of the buckets 1 to 4
+        h.add(std::chrono::microseconds(1));
+        h.add(std::chrono::microseconds(2));
+        h.add(std::chrono::microseconds(4));
+        h.add(std::chrono::microseconds(8));
+
+        CXXTOOLS_UNIT_ASSERT(h.quantile(0) == std::chrono::microseconds(2));
+        CXXTOOLS_UNIT_ASSERT(h.quantile(0.25) == std::chrono::microseconds(2));
+        CXXTOOLS_UNIT_ASSERT(h.quantile(0.5) == std::chrono::microseconds(4));
+        CXXTOOLS_UNIT_ASSERT(h.quantile(0.51) == std::chrono::microseconds(8));
+        CXXTOOLS_UNIT_ASSERT(h.quantile(0.75) == std::chrono::microseconds(8));
+        CXXTOOLS_UNIT_ASSERT(h.quantile(1) == std::chrono::microseconds(16));
+
+        // a single duration is every quantile
+        tntdb::LatencyHistogram one;
+        one.add(std::chrono::microseconds(5));
+        CXXTOOLS_UNIT_ASSERT(one.quantile(0) == std::chrono::microseconds(8));
+        CXXTOOLS_UNIT_ASSERT(one.quantile(0.99) == std::chrono::microseconds(8));
+        CXXTOOLS_UNIT_ASSERT(one.quantile(1) == std::chrono::microseconds(8));
+    }
+};
+
+cxxtools::unit::RegisterTest<MetricsTest> register_MetricsTest;
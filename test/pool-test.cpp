@@ -0,0 +1,271 @@
+/*
+ * Copyright (C) 2005 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "testbase.h"
+#include <cxxtools/unit/registertest.h>
+#include <cxxtools/log.h>
+#include <tntdb/connectionpool.h>
+#include <tntdb/connection.h>
+#include <tntdb/error.h>
+#include <thread>
+#include <chrono>
+#include <future>
+#include <memory>
+
+log_define("tntdb.unit.pool")
+
+class TntdbPoolTest : public TntdbTestBase
+{
+public:
+    TntdbPoolTest()
+      : TntdbTestBase("pool")
+    {
+        registerMethod("testReuse", *this, &TntdbPoolTest::testReuse);
+        registerMethod("testMaxSize", *this, &TntdbPoolTest::testMaxSize);
+        registerMethod("testWaitOrder", *this, &TntdbPoolTest::testWaitOrder);
+        registerMethod("testWarmup", *this, &TntdbPoolTest::testWarmup);
+        registerMethod("testThreadCache", *this, &TntdbPoolTest::testThreadCache);
+        registerMethod("testThreadCacheLifetime", *this, &TntdbPoolTest::testThreadCacheLifetime);
+        registerMethod("testThreadCacheOwner", *this, &TntdbPoolTest::testThreadCacheOwner);
+        registerMethod("testThreadCacheExit", *this, &TntdbPoolTest::testThreadCacheExit);
+        registerMethod("testMetrics", *this, &TntdbPoolTest::testMetrics);
+    }
+
+    void testReuse()
+    {
+        tntdb::ConnectionPool pool(dburl, dbuser, dbpassword);
+
+        {
+            tntdb::Connection c = pool.connect();
+            CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getSize(), 1);
+            CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getCurrentSize(), 0);
+        }
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getCurrentSize(), 1);
+
+        pool.setValidation(tntdb::ConnectionPool::validateAlive);
+        {
+            tntdb::Connection c = pool.connect();
+            CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getSize(), 1);
+        }
+
+        pool.drop();
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getSize(), 0);
+    }
+
+    void testMaxSize()
+    {
+        tntdb::ConnectionPool pool(dburl, dbuser, dbpassword);
+        pool.setMaxSize(1, std::chrono::milliseconds(10));
+
+        tntdb::Connection c = pool.connect();
+        CXXTOOLS_UNIT_ASSERT_THROW(pool.connect(), tntdb::PoolTimeout);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getTimeoutCount(), 1);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getWaiting(), 0);
+
+        c = tntdb::Connection();
+        c = pool.connect();
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getSize(), 1);
+    }
+
+    void waitFor(const tntdb::ConnectionPool& pool, unsigned waiting)
+    {
+        while (pool.getWaiting() < waiting)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    void testWaitOrder()
+    {
+        tntdb::ConnectionPool pool(dburl, dbuser, dbpassword);
+        pool.setMaxSize(1, std::chrono::seconds(10));
+
+        tntdb::Connection c = pool.connect();
+
+        // The first waiting thread gets the released connection and keeps
+        // it, so the second one times out.
+        tntdb::Connection c1;
+        std::thread t1([&pool, &c1] { c1 = pool.connect(); });
+        waitFor(pool, 1);
+
+        bool timedOut = false;
+        std::thread t2([&pool, &timedOut] {
+            try
+            {
+                pool.connect(std::chrono::milliseconds(200));
+            }
+            catch (const tntdb::PoolTimeout&)
+            {
+                timedOut = true;
+            }
+        });
+        waitFor(pool, 2);
+
+        c = tntdb::Connection();
+        t1.join();
+        t2.join();
+
+        CXXTOOLS_UNIT_ASSERT(!!c1);
+        CXXTOOLS_UNIT_ASSERT(timedOut);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getWaitCount(), 2);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getTimeoutCount(), 1);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getWaiting(), 0);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getSize(), 1);
+    }
+
+    void testWarmup()
+    {
+        tntdb::ConnectionPool pool(dburl, dbuser, dbpassword);
+        pool.setMaxSize(3);
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.warmup(2), 2);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getCurrentSize(), 2);
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.warmup(5), 1);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getCurrentSize(), 3);
+    }
+
+    void testThreadCache()
+    {
+        tntdb::ConnectionPool pool(dburl, dbuser, dbpassword);
+        pool.setThreadCache(true);
+
+        {
+            tntdb::Connection c1 = pool.connect();
+            tntdb::Connection c2 = pool.connect();
+        }
+
+        // one connection is kept by the thread, the other one is idle
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getSize(), 2);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getCurrentSize(), 1);
+
+        {
+            tntdb::Connection c = pool.connect();
+            CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getCurrentSize(), 1);
+        }
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getSize(), 2);
+    }
+
+    void testThreadCacheLifetime()
+    {
+        std::unique_ptr<tntdb::ConnectionPool> pool(new tntdb::ConnectionPool(dburl, dbuser, dbpassword));
+        pool->setThreadCache(true);
+
+        std::promise<void> cached;
+        std::promise<void> destroyed;
+        std::future<void> destroyedFuture = destroyed.get_future();
+
+        // the thread keeps its connection, until it exits after the pool
+        // was destroyed
+        std::thread t([&pool, &cached, &destroyedFuture] {
+            {
+                tntdb::Connection c = pool->connect();
+            }
+            cached.set_value();
+            destroyedFuture.wait();
+        });
+
+        cached.get_future().wait();
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool->getSize(), 1);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool->getCurrentSize(), 0);
+
+        pool.reset();
+        destroyed.set_value();
+        t.join();
+    }
+
+    void testThreadCacheOwner()
+    {
+        tntdb::ConnectionPool pool(dburl, dbuser, dbpassword);
+        pool.setThreadCache(true);
+
+        {
+            tntdb::Connection c = pool.connect();
+        }
+
+        // the connection kept for pool is not used by other pools with
+        // the same parameters
+        tntdb::ConnectionPools pools;
+        pools.setThreadCache(true);
+
+        {
+            tntdb::Connection c = pools.connect(dburl, dbuser, dbpassword);
+            CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getMetrics().inUse, 0);
+        }
+
+        tntdb::Connection c = pool.connect();
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getMetrics().creations, 1);
+    }
+
+    void testThreadCacheExit()
+    {
+        // Like a static pool at program exit, the thread local pool is
+        // destroyed after the thread cache, which kept its connection.
+        std::thread t([this] {
+            static thread_local std::unique_ptr<tntdb::ConnectionPool> pool;
+            pool.reset(new tntdb::ConnectionPool(dburl, dbuser, dbpassword));
+            pool->setThreadCache(true);
+
+            {
+                tntdb::Connection c = pool->connect();
+            }
+        });
+
+        t.join();
+    }
+
+    void testMetrics()
+    {
+        tntdb::ConnectionPool pool(dburl, dbuser, dbpassword);
+
+        {
+            tntdb::Connection c = pool.connect();
+            tntdb::PoolMetrics metrics = pool.getMetrics();
+            CXXTOOLS_UNIT_ASSERT_EQUALS(metrics.inUse, 1);
+            CXXTOOLS_UNIT_ASSERT_EQUALS(metrics.idle, 0);
+        }
+
+        {
+            tntdb::Connection c = pool.connect();
+            c.beginTransaction();
+        }
+
+        tntdb::PoolMetrics metrics = pool.getMetrics();
+        CXXTOOLS_UNIT_ASSERT_EQUALS(metrics.checkouts, 2);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(metrics.creations, 1);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(metrics.pings, 1);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(metrics.drops, 1);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(metrics.inUse, 0);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(metrics.open, 0);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(metrics.waitTime.count(), 2);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(metrics.holdTime.count(), 2);
+    }
+
+};
+
+cxxtools::unit::RegisterTest<TntdbPoolTest> register_TntdbPoolTest;
@@ -90,6 +90,7 @@ public:
         registerMethod("testSetValue", *this, &StatementTest::testSetValue);
         registerMethod("testClear", *this, &StatementTest::testClear);
         registerMethod("testSetTimespan", *this, &StatementTest::testSetTimespan);
+        registerMethod("testSetByHandle", *this, &StatementTest::testSetByHandle);
     }
 
     void testSetValue()
@@ -173,6 +174,32 @@ public:
         CXXTOOLS_UNIT_ASSERT_EQUALS(testStmt->value("d"), "22");
     }
 
+    void testSetByHandle()
+    {
+        std::shared_ptr<TestStmt> testStmt = std::make_shared<TestStmt>();
+        tntdb::Statement stmt(testStmt);
+
+        tntdb::HostvarHandle i = stmt.hostvar("int");
+        tntdb::HostvarHandle s = stmt.hostvar("string");
+        tntdb::HostvarHandle d = stmt.hostvar("date");
+        CXXTOOLS_UNIT_ASSERT(!!i);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(i.getName(), "int");
+
+        stmt.set(i, 42)
+            .set(s, "Hi there")
+            .set(d, tntdb::Date(2018, 5, 3));
+        CXXTOOLS_UNIT_ASSERT_EQUALS(testStmt->value("int"), "42");
+        CXXTOOLS_UNIT_ASSERT_EQUALS(testStmt->value("string"), "Hi there");
+        CXXTOOLS_UNIT_ASSERT_EQUALS(testStmt->value("date"), "2018-05-03");
+
+        stmt.setInt(i, 43)
+            .setNull(s)
+            .setIf(d, false, tntdb::Date(2018, 5, 4));
+        CXXTOOLS_UNIT_ASSERT_EQUALS(testStmt->value("int"), "43");
+        CXXTOOLS_UNIT_ASSERT(testStmt->isNull("string"));
+        CXXTOOLS_UNIT_ASSERT(testStmt->isNull("date"));
+    }
+
 };
 
 cxxtools::unit::RegisterTest<StatementTest> register_StatementTest;
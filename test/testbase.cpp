@@ -8,9 +8,9 @@ void TntdbTestBase::setUp()
 {
     if (!conn)
     {
-        const char* dburl = getenv("TNTDBURL");
-        if (!dburl)
-          dburl = "sqlite:test.db";
+        const char* url = getenv("TNTDBURL");
+        if (!url)
+          url = "sqlite:test.db";
 
         const char* user = getenv("TNTDBUSER");
         const char* password = getenv("TNTDBPASSWORD");
@@ -19,9 +19,12 @@ void TntdbTestBase::setUp()
         if (!password)
             password = "";
 
-        log_info("testing with dburl=" << dburl);
+        log_info("testing with dburl=" << url);
 
-        conn = tntdb::connect(dburl, user, password);
+        dburl = url;
+        dbuser = user;
+        dbpassword = password;
+        conn = tntdb::connect(dburl, dbuser, dbpassword);
 
         del = conn.prepare("delete from tntdbtest");
         del.execute();
@@ -11,6 +11,9 @@ class TntdbTestBase : public cxxtools::unit::TestSuite
 protected:
     tntdb::Connection conn;
     tntdb::Statement del;
+    std::string dburl;
+    std::string dbuser;
+    std::string dbpassword;
 
 public:
     explicit TntdbTestBase(const std::string& name)
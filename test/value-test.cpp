@@ -31,7 +31,15 @@
 #include <cxxtools/unit/registertest.h>
 #include <tntdb/value.h>
 #include <tntdb/impl/value.h>
+#include <tntdb/impl/result.h>
+#include <tntdb/impl/resultvalue.h>
+#include <tntdb/error.h>
+#include <tntdb/date.h>
+#include <tntdb/time.h>
+#include <tntdb/datetime.h>
 #include <tntdb/cxxtools/timespan.h>
+#include <clocale>
+#include <string>
 
 class ValueTest : public cxxtools::unit::TestSuite
 {
@@ -41,6 +49,11 @@ public:
     {
         registerMethod("testReadValue", *this, &ValueTest::testReadValue);
         registerMethod("testTimespan", *this, &ValueTest::testTimespan);
+        registerMethod("testConversionErrors", *this, &ValueTest::testConversionErrors);
+        registerMethod("testIsoValues", *this, &ValueTest::testIsoValues);
+        registerMethod("testResultDouble", *this, &ValueTest::testResultDouble);
+        registerMethod("testDecimalComma", *this, &ValueTest::testDecimalComma);
+        registerMethod("testResultReal", *this, &ValueTest::testResultReal);
     }
 
     void testReadValue()
@@ -63,6 +76,116 @@ public:
         }
     }
 
+    void testConversionErrors()
+    {
+        tntdb::Value v;
+
+        {
+            v = tntdb::Value(std::make_shared<tntdb::ValueImpl>(" -17 "));
+            CXXTOOLS_UNIT_ASSERT_EQUALS(v.getInt(), -17);
+        }
+        {
+            v = tntdb::Value(std::make_shared<tntdb::ValueImpl>("40000"));
+            CXXTOOLS_UNIT_ASSERT_THROW(v.getShort(), tntdb::TypeError);
+            CXXTOOLS_UNIT_ASSERT_EQUALS(v.getInt(), 40000);
+        }
+        {
+            v = tntdb::Value(std::make_shared<tntdb::ValueImpl>("-1"));
+            CXXTOOLS_UNIT_ASSERT_THROW(v.getUnsigned(), tntdb::TypeError);
+        }
+        {
+            v = tntdb::Value(std::make_shared<tntdb::ValueImpl>("12abc"));
+            CXXTOOLS_UNIT_ASSERT_THROW(v.getInt(), tntdb::TypeError);
+            CXXTOOLS_UNIT_ASSERT_THROW(v.getDouble(), tntdb::TypeError);
+        }
+        {
+            v = tntdb::Value(std::make_shared<tntdb::ValueImpl>("1.5e3"));
+            CXXTOOLS_UNIT_ASSERT_EQUALS(v.getDouble(), 1500.0);
+        }
+    }
+
+    void testIsoValues()
+    {
+        CXXTOOLS_UNIT_ASSERT_EQUALS(tntdb::Date::fromIso("2024-02-29").getIso(), "2024-02-29");
+        CXXTOOLS_UNIT_ASSERT_EQUALS(tntdb::Time::fromIso("13:14:15").getIso(), "13:14:15.000");
+        CXXTOOLS_UNIT_ASSERT_EQUALS(tntdb::Time::fromIso("13:14:15.5").getIso(), "13:14:15.500");
+        CXXTOOLS_UNIT_ASSERT_EQUALS(tntdb::Time::fromIso("13:14:15.123456").getIso(), "13:14:15.123");
+        CXXTOOLS_UNIT_ASSERT_EQUALS(tntdb::Datetime::fromIso("2024-02-29 13:14:15.123").getIso(), "2024-02-29 13:14:15.123");
+        CXXTOOLS_UNIT_ASSERT_EQUALS(tntdb::Datetime::fromIso("2024-02-29T13:14:15").getIso(), "2024-02-29 13:14:15.000");
+        CXXTOOLS_UNIT_ASSERT_THROW(tntdb::Time::fromIso("13:14"), tntdb::TypeError);
+        CXXTOOLS_UNIT_ASSERT_THROW(tntdb::Datetime::fromIso("2024-02-29 13:14:15x"), tntdb::TypeError);
+    }
+
+    void testResultDouble()
+    {
+        std::shared_ptr<tntdb::ResultImpl> result = std::make_shared<tntdb::ResultImpl>();
+        result->addColumn("v");
+        result->addDouble(0.1);
+        result->addDouble(0.1 + 0.2);
+
+        tntdb::Value v(std::make_shared<tntdb::ResultValueImpl>(result, 0));
+        CXXTOOLS_UNIT_ASSERT_EQUALS(v.getString(), "0.1");
+        CXXTOOLS_UNIT_ASSERT_EQUALS(v.getDouble(), 0.1);
+
+        v = tntdb::Value(std::make_shared<tntdb::ResultValueImpl>(result, 1));
+        CXXTOOLS_UNIT_ASSERT_EQUALS(v.getDouble(), 0.1 + 0.2);
+    }
+
+    void testResultReal()
+    {
+        // values with the text of the database keep it
+        std::shared_ptr<tntdb::ResultImpl> result = std::make_shared<tntdb::ResultImpl>();
+        result->addColumn("v");
+        result->addReal(1.0, "1.0", 3);
+        result->addReal(0.1, "0.1", 3);
+
+        tntdb::Value v(std::make_shared<tntdb::ResultValueImpl>(result, 0));
+        CXXTOOLS_UNIT_ASSERT_EQUALS(v.getString(), "1.0");
+        CXXTOOLS_UNIT_ASSERT_EQUALS(v.getDouble(), 1.0);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(v.getInt(), 1);
+
+        v = tntdb::Value(std::make_shared<tntdb::ResultValueImpl>(result, 1));
+        CXXTOOLS_UNIT_ASSERT_EQUALS(v.getString(), "0.1");
+        CXXTOOLS_UNIT_ASSERT_EQUALS(v.getDouble(), 0.1);
+        CXXTOOLS_UNIT_ASSERT_THROW(v.getInt(), tntdb::TypeError);
+    }
+
+    void testDecimalComma()
+    {
+        // numbers are converted independent of the global locale
+        static const char* locales[] = { "de_DE.UTF-8", "de_DE.utf8", "de_DE", "fr_FR.UTF-8", "fr_FR.utf8", "fr_FR" };
+
+        std::string saved = std::setlocale(LC_ALL, 0);
+        bool found = false;
+        for (unsigned n = 0; !found && n < sizeof(locales) / sizeof(locales[0]); ++n)
+            found = std::setlocale(LC_ALL, locales[n]) != 0;
+
+        // no locale with a decimal comma installed
+        if (!found)
+            return;
+
+        try
+        {
+            tntdb::Value v(std::make_shared<tntdb::ValueImpl>("1.5"));
+            CXXTOOLS_UNIT_ASSERT_EQUALS(v.getDouble(), 1.5);
+            CXXTOOLS_UNIT_ASSERT_EQUALS(v.getFloat(), 1.5f);
+
+            std::shared_ptr<tntdb::ResultImpl> result = std::make_shared<tntdb::ResultImpl>();
+            result->addColumn("v");
+            result->addDouble(1.5);
+
+            v = tntdb::Value(std::make_shared<tntdb::ResultValueImpl>(result, 0));
+            CXXTOOLS_UNIT_ASSERT_EQUALS(v.getString(), "1.5");
+        }
+        catch (...)
+        {
+            std::setlocale(LC_ALL, saved.c_str());
+            throw;
+        }
+
+        std::setlocale(LC_ALL, saved.c_str());
+    }
+
     void testTimespan()
     {
         tntdb::Value v;